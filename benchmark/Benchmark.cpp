@@ -0,0 +1,225 @@
+/// Implements a minimal harness for the quantum-mlir benchmarks.
+///
+/// @file
+
+#include "Benchmark.h"
+
+#include <chrono>
+#include <cstdio>
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <sys/resource.h>
+#include <utility>
+#include <vector>
+
+using namespace quantum::bench;
+
+namespace {
+
+/// Minimum wall time of a measured run.
+constexpr std::chrono::duration<double> kMinTime{0.5};
+
+struct Entry {
+    std::string name;
+    Function function;
+    std::uint64_t argument = 0;
+    bool reference = false;
+};
+
+/// The outcome of a benchmark.
+struct Result {
+    std::uint64_t iterations;
+    double nanosecondsPerIteration;
+    double itemsPerSecond;
+    double bytesPerSecond;
+    std::uint64_t peakMemory;
+    std::string skipped;
+};
+
+std::vector<Entry> &getRegistry()
+{
+    static std::vector<Entry> registry;
+    return registry;
+}
+
+/// Restarts the tracking of the peak resident set size, where supported.
+void resetPeakMemory()
+{
+    // Writing 5 resets VmHWM since Linux 4.0.
+    if (std::FILE* file = std::fopen("/proc/self/clear_refs", "w")) {
+        std::fputs("5", file);
+        std::fclose(file);
+    }
+}
+
+/// Returns the peak resident set size in bytes.
+std::uint64_t getPeakMemory()
+{
+    if (std::FILE* file = std::fopen("/proc/self/status", "r")) {
+        char line[256];
+        unsigned long long kilobytes = 0;
+        bool found = false;
+        while (!found && std::fgets(line, sizeof(line), file))
+            found = std::sscanf(line, "VmHWM: %llu kB", &kilobytes) == 1;
+        std::fclose(file);
+        if (found) return kilobytes * 1024;
+    }
+
+    // Falls back to the peak of the whole process lifetime.
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return static_cast<std::uint64_t>(usage.ru_maxrss);
+#else
+    return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+}
+
+Result run(const Entry &entry)
+{
+    resetPeakMemory();
+
+    // Grow the iteration count until a run takes long enough to be measured
+    // reliably.
+    State state;
+    state.argument = entry.argument;
+    std::chrono::duration<double> elapsed{};
+    while (true) {
+        state.items = 0;
+        state.bytes = 0;
+        state.paused = {};
+        const auto start = std::chrono::steady_clock::now();
+        entry.function(state);
+        elapsed = std::chrono::steady_clock::now() - start - state.paused;
+        if (!state.skipped.empty())
+            return Result{0, 0.0, 0.0, 0.0, 0, std::move(state.skipped)};
+        if (elapsed >= kMinTime) break;
+        state.iterations *= 2;
+    }
+
+    const double seconds = elapsed.count();
+    return Result{
+        state.iterations,
+        seconds * 1e9 / static_cast<double>(state.iterations),
+        static_cast<double>(state.items) / seconds,
+        static_cast<double>(state.bytes) / seconds,
+        getPeakMemory(),
+        {}};
+}
+
+} // namespace
+
+bool quantum::bench::registerBenchmark(std::string name, Function function)
+{
+    getRegistry().push_back(Entry{std::move(name), std::move(function)});
+    return true;
+}
+
+bool quantum::bench::registerBenchmark(
+    std::string name,
+    const Function &function,
+    std::initializer_list<std::uint64_t> arguments)
+{
+    for (std::uint64_t argument : arguments)
+        getRegistry().push_back(
+            Entry{name + "/" + std::to_string(argument), function, argument});
+    return true;
+}
+
+bool quantum::bench::registerReference(std::string name, Function function)
+{
+    getRegistry().push_back(
+        Entry{std::move(name), std::move(function), 0, true});
+    return true;
+}
+
+int quantum::bench::runBenchmarks(int argc, char** argv)
+{
+    std::string_view filter;
+    bool json = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0)
+            json = true;
+        else
+            filter = argv[i];
+    }
+
+    // References run first so that all bandwidths can relate to them.
+    std::vector<Entry> &registry = getRegistry();
+    std::stable_partition(registry.begin(), registry.end(), [](const Entry &e) {
+        return e.reference;
+    });
+
+    if (json)
+        std::printf("{\n  \"benchmarks\": [");
+    else
+        std::printf(
+            "%-32s %10s %14s %12s %9s %7s %10s\n",
+            "benchmark",
+            "iterations",
+            "ns/iter",
+            "items/s",
+            "GB/s",
+            "%peak",
+            "peak RSS");
+
+    double peakBandwidth = 0.0;
+    bool first = true;
+    for (const Entry &entry : registry) {
+        if (!entry.reference && entry.name.find(filter) == std::string::npos)
+            continue;
+
+        const Result result = run(entry);
+        const double gigabytes = result.bytesPerSecond * 1e-9;
+        if (entry.reference)
+            peakBandwidth = std::max(peakBandwidth, result.bytesPerSecond);
+        const double fraction =
+            peakBandwidth > 0.0 ? result.bytesPerSecond / peakBandwidth : 0.0;
+
+        if (json) {
+            std::printf(
+                "%s\n    {\"name\": \"%s\"",
+                first ? "" : ",",
+                entry.name.c_str());
+            if (!result.skipped.empty()) {
+                std::printf(", \"skipped\": \"%s\"}", result.skipped.c_str());
+            } else {
+                std::printf(
+                    ", \"iterations\": %llu, \"ns_per_iteration\": %.2f, "
+                    "\"items_per_second\": %.6g",
+                    static_cast<unsigned long long>(result.iterations),
+                    result.nanosecondsPerIteration,
+                    result.itemsPerSecond);
+                if (result.bytesPerSecond > 0.0)
+                    std::printf(
+                        ", \"bytes_per_second\": %.6g, "
+                        "\"fraction_of_peak\": %.4f",
+                        result.bytesPerSecond,
+                        fraction);
+                std::printf(
+                    ", \"peak_rss_bytes\": %llu}",
+                    static_cast<unsigned long long>(result.peakMemory));
+            }
+        } else if (!result.skipped.empty()) {
+            std::printf(
+                "%-32s skipped: %s\n",
+                entry.name.c_str(),
+                result.skipped.c_str());
+        } else {
+            std::printf(
+                "%-32s %10llu %14.2f %12.4g %9.2f %6.1f%% %8.1fMB\n",
+                entry.name.c_str(),
+                static_cast<unsigned long long>(result.iterations),
+                result.nanosecondsPerIteration,
+                result.itemsPerSecond,
+                gigabytes,
+                fraction * 100.0,
+                static_cast<double>(result.peakMemory) / (1 << 20));
+        }
+        std::fflush(stdout);
+        first = false;
+    }
+    if (json) std::printf("\n  ]\n}\n");
+    return 0;
+}
@@ -0,0 +1,87 @@
+/// Declares a minimal harness for the quantum-mlir benchmarks.
+///
+/// @file
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <string>
+
+namespace quantum::bench {
+
+/// Passed to a benchmark function, which must execute its body
+/// @c iterations times and may report the number of processed @c items and
+/// the number of @c bytes moved from and to memory.
+struct State {
+    using Clock = std::chrono::steady_clock;
+
+    std::uint64_t iterations = 1;
+    std::uint64_t items = 0;
+    std::uint64_t bytes = 0;
+    /// The argument the benchmark was registered with, e.g. a problem size.
+    std::uint64_t argument = 0;
+
+    /// Excludes the time until resumeTiming() from the measurement, e.g. to
+    /// prepare the input of the next iteration.
+    void pauseTiming() { pausedAt = Clock::now(); }
+    void resumeTiming() { paused += Clock::now() - pausedAt; }
+
+    /// Reports that the benchmark cannot run on this machine for @p reason ,
+    /// e.g. because the problem does not fit into memory.
+    void skip(std::string reason) { skipped = std::move(reason); }
+
+    /// The total time spent paused.
+    Clock::duration paused{};
+    /// The reason for skipping the benchmark, if non-empty.
+    std::string skipped;
+
+private:
+    Clock::time_point pausedAt{};
+};
+
+using Function = std::function<void(State &state)>;
+
+/// Adds @p function to the registry under @p name .
+bool registerBenchmark(std::string name, Function function);
+/// Adds @p function to the registry once per value of @p arguments , under
+/// the name `<name>/<argument>`.
+bool registerBenchmark(
+    std::string name,
+    const Function &function,
+    std::initializer_list<std::uint64_t> arguments);
+/// Adds @p function to the registry as a bandwidth reference. References run
+/// first, and the bandwidth of every other benchmark is also reported as a
+/// fraction of the highest reference bandwidth.
+bool registerReference(std::string name, Function function);
+
+/// Runs all registered benchmarks whose name contains the first positional
+/// command line argument, if any, and all references. Prints one line per
+/// benchmark, or a JSON document if `--json` is given.
+int runBenchmarks(int argc, char** argv);
+
+/// Prevents the compiler from discarding the computation of @p value .
+template<typename T>
+inline void doNotOptimize(const T &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+} // namespace quantum::bench
+
+/// Registers the benchmark function @p function .
+#define QUANTUM_BENCHMARK(function)                                            \
+    static const bool function##Registered =                                   \
+        ::quantum::bench::registerBenchmark(#function, function)
+
+/// Registers the benchmark function @p function once per argument.
+#define QUANTUM_BENCHMARK_ARGS(function, ...)                                  \
+    static const bool function##Registered =                                   \
+        ::quantum::bench::registerBenchmark(#function, function, {__VA_ARGS__})
+
+/// Registers the bandwidth reference @p function .
+#define QUANTUM_BENCHMARK_REFERENCE(function)                                  \
+    static const bool function##Registered =                                   \
+        ::quantum::bench::registerReference(#function, function)
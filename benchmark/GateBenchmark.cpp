@@ -0,0 +1,228 @@
+/// Benchmarks the QIR gate entry points of the runtime per gate kind, qubit
+/// count and target position.
+///
+/// Every benchmark reports its effective memory bandwidth, i.e. the bytes of
+/// amplitudes the kernel must at least read and write per application, as a
+/// fraction of the STREAM bandwidth of the machine. The simulator is
+/// configured through QUANTUM_RUNTIME_CONFIG as usual.
+///
+/// @file
+
+#include "Benchmark.h"
+#include "quantum-mlir/Runtime/QIR.h"
+#include "quantum-mlir/Runtime/Runtime.h"
+#include "quantum-mlir/Runtime/Trajectories.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace quantum::runtime;
+using namespace quantum::bench;
+
+namespace {
+
+//===----------------------------------------------------------------------===//
+// STREAM references
+//===----------------------------------------------------------------------===//
+
+/// Number of elements per STREAM array, which must exceed the caches.
+constexpr std::size_t kStreamSize = std::size_t(1) << 24;
+
+/// The arrays are freed after every run so that they do not count towards
+/// the peak memory of later benchmarks.
+struct StreamArrays {
+    std::vector<double> a = std::vector<double>(kStreamSize, 1.0);
+    std::vector<double> b = std::vector<double>(kStreamSize, 2.0);
+    std::vector<double> c = std::vector<double>(kStreamSize, 0.0);
+};
+
+/// Computes the STREAM triad a = b + s * c over [begin, end).
+void triad(StreamArrays &arrays, std::size_t begin, std::size_t end)
+{
+    double* a = arrays.a.data();
+    const double* b = arrays.b.data();
+    const double* c = arrays.c.data();
+    for (std::size_t i = begin; i < end; ++i) a[i] = b[i] + 3.0 * c[i];
+}
+
+void streamCopy(State &state)
+{
+    state.pauseTiming();
+    auto arrays = std::make_unique<StreamArrays>();
+    state.resumeTiming();
+    for (std::uint64_t i = 0; i < state.iterations; ++i) {
+        std::copy(arrays->a.begin(), arrays->a.end(), arrays->c.begin());
+        doNotOptimize(arrays->c.data());
+    }
+    state.items = state.iterations * kStreamSize;
+    state.bytes = state.items * 2 * sizeof(double);
+    state.pauseTiming();
+    arrays.reset();
+    state.resumeTiming();
+}
+QUANTUM_BENCHMARK_REFERENCE(streamCopy);
+
+void streamTriad(State &state)
+{
+    state.pauseTiming();
+    auto arrays = std::make_unique<StreamArrays>();
+    state.resumeTiming();
+    for (std::uint64_t i = 0; i < state.iterations; ++i) {
+        triad(*arrays, 0, kStreamSize);
+        doNotOptimize(arrays->a.data());
+    }
+    state.items = state.iterations * kStreamSize;
+    state.bytes = state.items * 3 * sizeof(double);
+    state.pauseTiming();
+    arrays.reset();
+    state.resumeTiming();
+}
+QUANTUM_BENCHMARK_REFERENCE(streamTriad);
+
+/// The triad on all hardware threads, which is the STREAM peak.
+void streamTriadParallel(State &state)
+{
+    state.pauseTiming();
+    auto arrays = std::make_unique<StreamArrays>();
+    ThreadPool pool;
+    state.resumeTiming();
+    const std::size_t blocks = pool.getNumThreads() * 4;
+    const std::size_t blockSize = (kStreamSize + blocks - 1) / blocks;
+    for (std::uint64_t i = 0; i < state.iterations; ++i) {
+        pool.parallelFor(blocks, [&](std::size_t block, unsigned) {
+            const std::size_t begin = block * blockSize;
+            triad(*arrays, begin, std::min(begin + blockSize, kStreamSize));
+        });
+        doNotOptimize(arrays->a.data());
+    }
+    state.items = state.iterations * kStreamSize;
+    state.bytes = state.items * 3 * sizeof(double);
+    state.pauseTiming();
+    arrays.reset();
+    state.resumeTiming();
+}
+QUANTUM_BENCHMARK_REFERENCE(streamTriadParallel);
+
+//===----------------------------------------------------------------------===//
+// Gates
+//===----------------------------------------------------------------------===//
+
+QirQubit* qubitAt(std::uintptr_t id)
+{
+    return reinterpret_cast<QirQubit*>(id);
+}
+
+/// An entry point under test.
+struct Gate {
+    const char* name;
+    /// The kernel reads and writes at least 2^(n - shift) amplitudes.
+    unsigned shift;
+    /// Applies the gate to the target @p q[0] and the controls or partner
+    /// qubits @p q[1] and @p q[2] .
+    void (*apply)(QirQubit* const* q);
+};
+
+constexpr Gate kGates[] = {
+    {"h", 0, [](QirQubit* const* q) { __quantum__qis__h__body(q[0]); }},
+    {"rx", 0, [](QirQubit* const* q) { __quantum__qis__rx__body(0.3, q[0]); }},
+    {"rz", 0, [](QirQubit* const* q) { __quantum__qis__rz__body(0.3, q[0]); }},
+    {"t", 0, [](QirQubit* const* q) { __quantum__qis__t__body(q[0]); }},
+    {"cnot",
+     1,
+     [](QirQubit* const* q) { __quantum__qis__cnot__body(q[1], q[0]); }},
+    {"cz", 1, [](QirQubit* const* q) { __quantum__qis__cz__body(q[1], q[0]); }},
+    {"cry",
+     1,
+     [](QirQubit* const* q) { __quantum__qis__cry__body(0.3, q[1], q[0]); }},
+    {"swap",
+     1,
+     [](QirQubit* const* q) { __quantum__qis__swap__body(q[0], q[1]); }},
+    {"ccx",
+     2,
+     [](QirQubit* const* q) { __quantum__qis__ccx__body(q[1], q[2], q[0]); }},
+    {"mz",
+     0,
+     [](QirQubit* const* q) {
+         __quantum__qis__mz__body(q[0], reinterpret_cast<QirResult*>(0));
+     }},
+    {"reset", 0, [](QirQubit* const* q) { __quantum__qis__reset__body(q[0]); }},
+};
+
+/// The target position, from stride 1 to the largest stride.
+enum class Position { Low, Mid, High };
+
+/// Initializes the runtime with a uniform superposition of @p numQubits
+/// qubits, unless it already holds one. Skips the benchmark if the state
+/// does not fit into three quarters of the physical memory.
+bool prepare(State &state, std::size_t numQubits)
+{
+    static std::size_t prepared = 0;
+    if (prepared == numQubits) return true;
+
+    const std::uint64_t bytes = std::uint64_t(sizeof(Amplitude)) << numQubits;
+    const long pages = sysconf(_SC_PHYS_PAGES);
+    const long pageSize = sysconf(_SC_PAGE_SIZE);
+    const std::uint64_t physical = static_cast<std::uint64_t>(pages)
+                                   * static_cast<std::uint64_t>(pageSize);
+    if (pages > 0 && pageSize > 0 && bytes > physical / 4 * 3) {
+        state.skip(
+            "the state needs " + std::to_string(bytes >> 20)
+            + " MiB of memory");
+        return false;
+    }
+
+    __quantum__rt__initialize(nullptr);
+    getRuntimeState().getQubit(numQubits - 1);
+    // Measurements then have both outcomes.
+    for (std::uintptr_t q = 0; q < numQubits; ++q)
+        __quantum__qis__h__body(qubitAt(q));
+    prepared = numQubits;
+    return true;
+}
+
+void runGate(State &state, const Gate &gate, Position position)
+{
+    const std::size_t numQubits = state.argument;
+    state.pauseTiming();
+    const bool ready = prepare(state, numQubits);
+    state.resumeTiming();
+    if (!ready) return;
+
+    std::uintptr_t target = 0;
+    if (position == Position::Mid) target = numQubits / 2;
+    if (position == Position::High) target = numQubits - 1;
+    QirQubit* const qubits[] = {
+        qubitAt(target),
+        qubitAt((target + 1) % numQubits),
+        qubitAt((target + 2) % numQubits)};
+
+    for (std::uint64_t i = 0; i < state.iterations; ++i) gate.apply(qubits);
+    state.items = state.iterations;
+    state.bytes = state.iterations
+                  * (std::uint64_t(2 * sizeof(Amplitude))
+                     << (numQubits - gate.shift));
+}
+
+const bool gatesRegistered = [] {
+    constexpr std::pair<Position, const char*> positions[] = {
+        {Position::Low,  "low" },
+        {Position::Mid,  "mid" },
+        {Position::High, "high"}
+    };
+    for (const Gate &gate : kGates) {
+        for (const auto &[position, suffix] : positions) {
+            registerBenchmark(
+                std::string(gate.name) + "/" + suffix,
+                [&gate, position](State &state) {
+                    runGate(state, gate, position);
+                },
+                {10, 14, 18, 22, 26, 30});
+        }
+    }
+    return true;
+}();
+
+} // namespace
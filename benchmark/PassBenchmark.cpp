@@ -0,0 +1,347 @@
+/// Benchmarks the compile time of the quantum-mlir passes on large circuits.
+///
+/// Every benchmark times a single pass or translation on a generated circuit
+/// with the given number of gates. The input is prepared by the preceding
+/// stages of the pipeline outside of the measurement. The conversions are
+/// also timed on a module of many kernels with the given number of threads.
+///
+/// @file
+
+#include "Benchmark.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/MLIRContext.h"
+#include "mlir/InitAllDialects.h"
+#include "mlir/Parser/Parser.h"
+#include "mlir/Pass/PassManager.h"
+#include "quantum-mlir/Conversion/QIRToLLVM/QIRToLLVM.h"
+#include "quantum-mlir/Conversion/QIRToQuantum/QIRToQuantum.h"
+#include "quantum-mlir/Conversion/QuantumToQIR/QuantumToQIR.h"
+#include "quantum-mlir/Dialect/QIR/IR/QIR.h"
+#include "quantum-mlir/Dialect/Quantum/IR/Quantum.h"
+#include "quantum-mlir/Dialect/Quantum/Transforms/Passes.h"
+#include "quantum-mlir/Target/qasm/TargetQASM.h"
+
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+
+using namespace mlir;
+using namespace ::quantum::bench;
+
+namespace {
+
+/// Number of qubits of the generated circuits.
+constexpr unsigned kNumQubits = 64;
+/// Number of kernels and their total gates in the thread scaling benchmarks.
+constexpr unsigned kNumKernels = 1000;
+constexpr std::uint64_t kKernelGates = 100000;
+
+/// A stage of the compilation pipeline, in pipeline order.
+enum class Stage {
+    LiftQIRToQuantum,
+    MultiQubitLegalize,
+    Peephole,
+    HermitianCancel,
+    ConvertQuantumToQIR,
+    ConvertQIRToLLVM,
+    ExportQASM
+};
+
+/// Returns whether @p stage operates on the `quantum` dialect.
+bool consumesQuantum(Stage stage)
+{
+    return stage == Stage::MultiQubitLegalize
+           || stage == Stage::Peephole || stage == Stage::HermitianCancel
+           || stage == Stage::ConvertQuantumToQIR;
+}
+
+/// Adds the pass of @p stage to @p pm .
+void addStage(PassManager &pm, Stage stage)
+{
+    switch (stage) {
+    case Stage::LiftQIRToQuantum:
+        pm.addPass(createConvertQIRToQuantumPass());
+        break;
+    case Stage::MultiQubitLegalize:
+        pm.addPass(mlir::quantum::createMultiQubitLegalizationPass());
+        break;
+    case Stage::Peephole:
+        pm.addPass(mlir::quantum::createQuantumPeepholePass());
+        break;
+    case Stage::HermitianCancel:
+        pm.addPass(mlir::quantum::createHermitianCancelPass());
+        break;
+    case Stage::ConvertQuantumToQIR:
+        pm.addPass(createConvertQuantumToQIRPass());
+        break;
+    case Stage::ConvertQIRToLLVM:
+        pm.addPass(createConvertQIRToLLVMPass());
+        break;
+    case Stage::ExportQASM: break;
+    }
+}
+
+/// Generates a random circuit of @p numGates gates in the `qir` dialect as
+/// input of @p stage , split evenly into @p numKernels functions.
+///
+/// About one in eight gates is immediately repeated, which gives the
+/// hermitian cancellation work to do. convert-quantum-to-qir only receives
+/// the gates it can lower, and the OpenQASM export expects the circuit at
+/// the top level of the module rather than in a function.
+std::string generateCircuit(
+    std::uint64_t numGates,
+    Stage stage,
+    unsigned numKernels)
+{
+    const bool lowerable = stage == Stage::ConvertQuantumToQIR;
+    const bool inFunction = stage != Stage::ExportQASM;
+
+    std::string text;
+    llvm::raw_string_ostream os(text);
+    std::mt19937_64 random(numGates);
+    const auto qubit = [&] { return random() % kNumQubits; };
+
+    static constexpr const char* kUnary[] = {"H", "X", "Y", "Z", "S", "T"};
+    static constexpr const char* kRotation[] = {"Rx", "Ry", "Rz"};
+    static constexpr const char* kBinary[] = {"CNOT", "Cz", "swap"};
+    std::string gate;
+    for (unsigned kernel = 0; kernel < numKernels; ++kernel) {
+        if (inFunction) os << "func.func @circuit" << kernel << "() {\n";
+        os << "  %theta = arith.constant 0.5 : f64\n";
+        for (unsigned q = 0; q < kNumQubits; ++q)
+            os << "  %q" << q << " = \"qir.alloc\"() : () -> (!qir.qubit)\n";
+        for (unsigned q = 0; q < kNumQubits; ++q)
+            os << "  %r" << q
+               << " = \"qir.ralloc\"() : () -> (!qir.result)\n";
+
+        const std::uint64_t kernelGates = numGates / numKernels;
+        for (std::uint64_t emitted = 0; emitted < kernelGates;) {
+            const unsigned q0 = qubit();
+            unsigned q1 = qubit();
+            while (q1 == q0) q1 = qubit();
+            unsigned q2 = qubit();
+            while (q2 == q0 || q2 == q1) q2 = qubit();
+
+            gate.clear();
+            llvm::raw_string_ostream gateOs(gate);
+            const unsigned kind = random() % (lowerable ? 4 : 13);
+            if (lowerable) {
+                if (kind == 0)
+                    gateOs << "\"qir.H\"(%q" << q0 << ") : (!qir.qubit) -> ()";
+                else if (kind == 1)
+                    gateOs << "\"qir.X\"(%q" << q0 << ") : (!qir.qubit) -> ()";
+                else if (kind == 2)
+                    gateOs << "\"qir.Rz\"(%q" << q0
+                           << ", %theta) : (!qir.qubit, f64) -> ()";
+                else
+                    gateOs << "\"qir.swap\"(%q" << q0 << ", %q" << q1
+                           << ") : (!qir.qubit, !qir.qubit) -> ()";
+            } else if (kind < 6) {
+                gateOs << "\"qir." << kUnary[kind] << "\"(%q" << q0
+                       << ") : (!qir.qubit) -> ()";
+            } else if (kind < 9) {
+                gateOs << "\"qir." << kRotation[kind - 6] << "\"(%q" << q0
+                       << ", %theta) : (!qir.qubit, f64) -> ()";
+            } else if (kind < 12) {
+                gateOs << "\"qir." << kBinary[kind - 9] << "\"(%q" << q0
+                       << ", %q" << q1
+                       << ") : (!qir.qubit, !qir.qubit) -> ()";
+            } else {
+                gateOs << "\"qir.CCX\"(%q" << q0 << ", %q" << q1 << ", %q"
+                       << q2
+                       << ") : (!qir.qubit, !qir.qubit, !qir.qubit) -> ()";
+            }
+
+            const unsigned repeat = random() % 8 == 0 ? 2 : 1;
+            for (unsigned i = 0; i < repeat && emitted < kernelGates;
+                 ++i, ++emitted)
+                os << "  " << gate << "\n";
+        }
+
+        for (unsigned q = 0; q < kNumQubits; ++q)
+            os << "  \"qir.measure\"(%q" << q << ", %r" << q
+               << ") : (!qir.qubit, !qir.result) -> ()\n";
+        if (inFunction) os << "  return\n}\n";
+    }
+    return text;
+}
+
+MLIRContext &getContext()
+{
+    static MLIRContext context = [] {
+        DialectRegistry registry;
+        registerAllDialects(registry);
+        registry.insert<mlir::quantum::QuantumDialect, qir::QIRDialect>();
+        return MLIRContext(registry, MLIRContext::Threading::DISABLED);
+    }();
+    return context;
+}
+
+[[noreturn]] void fail(const char* message)
+{
+    std::fprintf(stderr, "quantum-mlir-benchmarks: %s\n", message);
+    std::abort();
+}
+
+/// The input of a stage, which is kept across the calls of the harness.
+struct Input {
+    Stage stage;
+    std::uint64_t numGates = 0;
+    unsigned numKernels = 0;
+    OwningOpRef<ModuleOp> module;
+    std::uint64_t numOps = 0;
+};
+
+/// Returns the input of @p stage for a circuit of @p numGates gates in
+/// @p numKernels functions.
+const Input &
+getInput(Stage stage, std::uint64_t numGates, unsigned numKernels)
+{
+    // Only the most recent input is cached, since the large circuits take
+    // hundreds of megabytes.
+    static Input input;
+    if (input.module && input.stage == stage && input.numGates == numGates
+        && input.numKernels == numKernels)
+        return input;
+
+    input.module = {};
+    MLIRContext &context = getContext();
+    const std::string text = generateCircuit(numGates, stage, numKernels);
+    input.module = parseSourceString<ModuleOp>(text, &context);
+    if (!input.module) fail("cannot parse the generated circuit");
+
+    if (consumesQuantum(stage)) {
+        PassManager pm(&context);
+        for (Stage prefix = Stage::LiftQIRToQuantum; prefix != stage;
+             prefix = static_cast<Stage>(static_cast<int>(prefix) + 1))
+            // quantum-peephole is an alternative to hermitian-cancel, which
+            // the later stages receive the output of.
+            if (prefix != Stage::Peephole) addStage(pm, prefix);
+        if (failed(pm.run(*input.module))) fail("cannot prepare the input");
+    }
+
+    input.stage = stage;
+    input.numGates = numGates;
+    input.numKernels = numKernels;
+    input.numOps = 0;
+    input.module->walk([&](Operation*) { ++input.numOps; });
+    return input;
+}
+
+/// Times @p stage on a circuit of @p numGates gates in @p numKernels
+/// functions, reporting the processed ops as items.
+void runStage(
+    State &state,
+    Stage stage,
+    std::uint64_t numGates,
+    unsigned numKernels = 1)
+{
+    state.pauseTiming();
+    const Input &input = getInput(stage, numGates, numKernels);
+    state.resumeTiming();
+
+    std::string qasm;
+    for (std::uint64_t i = 0; i < state.iterations; ++i) {
+        state.pauseTiming();
+        OwningOpRef<ModuleOp> module = input.module.get().clone();
+        qasm.clear();
+        state.resumeTiming();
+
+        if (stage == Stage::ExportQASM) {
+            llvm::raw_string_ostream os(qasm);
+            if (failed(qir::QIRTranslateToQASM(*module, os)))
+                fail("cannot export OpenQASM");
+        } else {
+            PassManager pm(&getContext());
+            addStage(pm, stage);
+            if (failed(pm.run(*module))) fail("pass failed");
+        }
+
+        state.pauseTiming();
+        module = {};
+        state.resumeTiming();
+    }
+    doNotOptimize(qasm);
+    state.items = state.iterations * input.numOps;
+}
+
+/// Times @p stage on kernels with as many threads as the benchmark argument.
+void runStageThreaded(State &state, Stage stage)
+{
+    state.pauseTiming();
+    // The context must not use a pool while it is replaced.
+    static std::unique_ptr<llvm::DefaultThreadPool> pool;
+    MLIRContext &context = getContext();
+    if (state.argument > 1) {
+        pool = std::make_unique<llvm::DefaultThreadPool>(
+            llvm::hardware_concurrency(state.argument));
+        context.setThreadPool(*pool);
+    }
+    state.resumeTiming();
+
+    runStage(state, stage, kKernelGates, kNumKernels);
+
+    state.pauseTiming();
+    if (context.isMultithreadingEnabled()) context.disableMultithreading();
+    state.resumeTiming();
+}
+
+void liftQIRToQuantum(State &state)
+{
+    runStage(state, Stage::LiftQIRToQuantum, state.argument);
+}
+QUANTUM_BENCHMARK_ARGS(liftQIRToQuantum, 1000, 10000, 100000, 1000000);
+
+void multiQubitLegalize(State &state)
+{
+    runStage(state, Stage::MultiQubitLegalize, state.argument);
+}
+QUANTUM_BENCHMARK_ARGS(multiQubitLegalize, 1000, 10000, 100000, 1000000);
+
+void peephole(State &state)
+{
+    runStage(state, Stage::Peephole, state.argument);
+}
+QUANTUM_BENCHMARK_ARGS(peephole, 1000, 10000, 100000, 1000000);
+
+void hermitianCancel(State &state)
+{
+    runStage(state, Stage::HermitianCancel, state.argument);
+}
+QUANTUM_BENCHMARK_ARGS(hermitianCancel, 1000, 10000, 100000, 1000000);
+
+void convertQuantumToQIR(State &state)
+{
+    runStage(state, Stage::ConvertQuantumToQIR, state.argument);
+}
+QUANTUM_BENCHMARK_ARGS(convertQuantumToQIR, 1000, 10000, 100000, 1000000);
+
+void convertQIRToLLVM(State &state)
+{
+    runStage(state, Stage::ConvertQIRToLLVM, state.argument);
+}
+QUANTUM_BENCHMARK_ARGS(convertQIRToLLVM, 1000, 10000, 100000, 1000000);
+
+void exportQASM(State &state)
+{
+    runStage(state, Stage::ExportQASM, state.argument);
+}
+QUANTUM_BENCHMARK_ARGS(exportQASM, 1000, 10000, 100000, 1000000);
+
+void convertQuantumToQIRThreads(State &state)
+{
+    runStageThreaded(state, Stage::ConvertQuantumToQIR);
+}
+QUANTUM_BENCHMARK_ARGS(convertQuantumToQIRThreads, 1, 2, 4, 8, 16);
+
+void convertQIRToLLVMThreads(State &state)
+{
+    runStageThreaded(state, Stage::ConvertQIRToLLVM);
+}
+QUANTUM_BENCHMARK_ARGS(convertQIRToLLVMThreads, 1, 2, 4, 8, 16);
+
+} // namespace
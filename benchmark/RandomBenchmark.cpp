@@ -0,0 +1,95 @@
+/// Benchmarks the sampling throughput of the runtime random number streams.
+///
+/// @file
+
+#include "Benchmark.h"
+#include "quantum-mlir/Runtime/Random.h"
+#include "quantum-mlir/Runtime/Runtime.h"
+#include "quantum-mlir/Runtime/Trajectories.h"
+
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace quantum::runtime;
+using namespace quantum::bench;
+
+namespace {
+
+/// Number of samples drawn per iteration.
+constexpr std::uint64_t kBatch = 1 << 16;
+
+/// Baseline: the sequential generator used before counter-based streams.
+void mersenneTwister(State &state)
+{
+    std::mt19937_64 generator(23);
+    for (std::uint64_t i = 0; i < state.iterations; ++i) {
+        double sum = 0.0;
+        for (std::uint64_t j = 0; j < kBatch; ++j)
+            sum += static_cast<double>(generator() >> 11) * 0x1.0p-53;
+        doNotOptimize(sum);
+    }
+    state.items = state.iterations * kBatch;
+}
+QUANTUM_BENCHMARK(mersenneTwister);
+
+void philoxStream(State &state)
+{
+    RandomStream stream(23, 0);
+    for (std::uint64_t i = 0; i < state.iterations; ++i) {
+        double sum = 0.0;
+        for (std::uint64_t j = 0; j < kBatch; ++j) sum += stream.sample();
+        doNotOptimize(sum);
+    }
+    state.items = state.iterations * kBatch;
+}
+QUANTUM_BENCHMARK(philoxStream);
+
+/// Models one stream per shot: every batch restarts a fresh stream.
+void philoxStreamPerShot(State &state)
+{
+    RandomStream stream;
+    for (std::uint64_t i = 0; i < state.iterations; ++i) {
+        double sum = 0.0;
+        for (std::uint64_t shot = 0; shot < kBatch / 16; ++shot) {
+            stream.reset(23, shot);
+            for (int j = 0; j < 16; ++j) sum += stream.sample();
+        }
+        doNotOptimize(sum);
+    }
+    state.items = state.iterations * kBatch;
+}
+QUANTUM_BENCHMARK(philoxStreamPerShot);
+
+/// Samples through the runtime state, as the QIR entry points do.
+void runtimeState(State &state)
+{
+    RuntimeState &runtime = getRuntimeState();
+    runtime.seed(23);
+    for (std::uint64_t i = 0; i < state.iterations; ++i) {
+        double sum = 0.0;
+        for (std::uint64_t j = 0; j < kBatch; ++j) sum += runtime.sample();
+        doNotOptimize(sum);
+    }
+    state.items = state.iterations * kBatch;
+}
+QUANTUM_BENCHMARK(runtimeState);
+
+/// Aggregate throughput of one stream per task on all hardware threads.
+void philoxParallel(State &state)
+{
+    ThreadPool pool;
+    const std::uint64_t tasks = state.iterations * pool.getNumThreads();
+    std::vector<double> sums(pool.getNumThreads());
+    pool.parallelFor(tasks, [&](std::size_t task, unsigned rank) {
+        RandomStream stream(23, task);
+        double sum = 0.0;
+        for (std::uint64_t j = 0; j < kBatch; ++j) sum += stream.sample();
+        sums[rank] += sum;
+    });
+    doNotOptimize(sums);
+    state.items = tasks * kBatch;
+}
+QUANTUM_BENCHMARK(philoxParallel);
+
+} // namespace
@@ -0,0 +1,10 @@
+/// Benchmark driver main entry point.
+///
+/// @file
+
+#include "Benchmark.h"
+
+int main(int argc, char** argv)
+{
+    return quantum::bench::runBenchmarks(argc, argv);
+}
@@ -119,13 +119,25 @@ class Scope:
 
 
 class QASMToMLIRVisitor:
-    def __init__(self, compat: QASMVersion, context: Context, module: Module, loc: Location, block: Block, scope: Scope) -> None:
+    def __init__(
+        self,
+        compat: QASMVersion,
+        context: Context,
+        module: Module,
+        loc: Location,
+        block: Block,
+        scope: Scope,
+        angles: dict[str, Value] | None = None,
+    ) -> None:
         self.compat: QASMVersion = compat
         self.context: Context = context
         self.module: Module = module
         self.loc: Location = loc
         self.block: Block = block
         self.scope = scope
+        # Pooled angle constants of the block, keyed by their exact value, or
+        # None to emit a constant per use.
+        self.angles: dict[str, Value] | None = angles
 
     @classmethod
     def fromParent(cls, parent: QASMToMLIRVisitor, *, block: Block | None = None, scope: Scope | None = None):
@@ -136,6 +148,8 @@ class QASMToMLIRVisitor:
             parent.loc,
             parent.block if block is None else block,
             parent.scope if scope is None else scope,
+            # Every gate body gets a pool of its own.
+            None if parent.angles is None else parent.angles if block is None else {},
         )
 
     def visitCircuit(self, circuit: QuantumCircuit) -> None:
@@ -169,7 +183,16 @@ class QASMToMLIRVisitor:
         if isinstance(expr, ParameterExpression):
             raise NotImplementedError("Parameter Expression")
         elif isinstance(expr, float):
-            return arith.ConstantOp(F64Type.get(self.context), expr, ip=InsertionPoint(self.block)).result
+            if self.angles is None:
+                return arith.ConstantOp(F64Type.get(self.context), expr, ip=InsertionPoint(self.block)).result
+            # Pooled constants go to the start of the block, so they dominate
+            # every later use. The hex form keeps 0.0 and -0.0 apart.
+            key: str = expr.hex()
+            if key not in self.angles:
+                self.angles[key] = arith.ConstantOp(
+                    F64Type.get(self.context), expr, ip=InsertionPoint.at_block_begin(self.block)
+                ).result
+            return self.angles[key]
         else:
             raise NotImplementedError(f"Classic expressions are not supported for {expr}")
 
@@ -341,7 +364,7 @@ def qasm_version(code: str) -> QASMVersion:
     return QASMVersion.Unspecified
 
 
-def QASMToMLIR(code: str) -> Module:
+def QASMToMLIR(code: str, pool_angles: bool = False) -> Module:
     compat: QASMVersion = qasm_version(code)
     circuit: QuantumCircuit
 
@@ -370,7 +393,9 @@ def QASMToMLIR(code: str) -> Module:
         module.body.append(qasm_main)
 
         scope: Scope = Scope.fromList(circuit.qregs, circuit.cregs)
-        visitor: QASMToMLIRVisitor = QASMToMLIRVisitor(compat, context, module, location, qasm_main.entry_block, scope)
+        visitor: QASMToMLIRVisitor = QASMToMLIRVisitor(
+            compat, context, module, location, qasm_main.entry_block, scope, {} if pool_angles else None
+        )
         visitor.visitCircuit(circuit)
 
         func.ReturnOp([], loc=location, ip=InsertionPoint(qasm_main.entry_block))
@@ -382,11 +407,16 @@ def main():
     parser = argparse.ArgumentParser()
     parser.add_argument("-i", "--input", help="Input QASM file")
     parser.add_argument("-o", "--output", help="Output MLIR file")
+    parser.add_argument(
+        "--pool-angles",
+        action="store_true",
+        help="Emit every distinct angle once per function, at its start",
+    )
     args = parser.parse_args()
 
     code: str = open(args.input).read() if args.input else sys.stdin.read()
 
-    module: Module = QASMToMLIR(code)
+    module: Module = QASMToMLIR(code, pool_angles=args.pool_angles)
     mlir: str = str(module)
 
     if args.output:
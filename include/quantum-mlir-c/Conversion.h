@@ -0,0 +1,11 @@
+//===-- quantum-mlir-c/Conversion.h - C API for the conversions -----------===//
+//
+// @file
+//===----------------------------------------------------------------------===//
+
+#ifndef QUANTUM_MLIR_C_CONVERSION_H
+#define QUANTUM_MLIR_C_CONVERSION_H
+
+#include "quantum-mlir/Conversion/Passes.capi.h.inc"
+
+#endif // QUANTUM_MLIR_C_CONVERSION_H
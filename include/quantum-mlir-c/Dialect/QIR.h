@@ -40,4 +40,6 @@ MLIR_CAPI_EXPORTED MlirType mlirResultTypeGet(MlirContext ctx);
 }
 #endif
 
+#include "quantum-mlir/Dialect/QIR/Transforms/Passes.capi.h.inc"
+
 #endif // QUANTUM_MLIR_C_DIALECT_QIR_H
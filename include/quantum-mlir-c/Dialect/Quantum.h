@@ -0,0 +1,41 @@
+//===-- quantum-mlir-c/Dialect/Quantum.h - C API for Quantum dialect ------===//
+//
+// @file
+//===----------------------------------------------------------------------===//
+
+#ifndef QUANTUM_MLIR_C_DIALECT_QUANTUM_H
+#define QUANTUM_MLIR_C_DIALECT_QUANTUM_H
+
+#include "mlir-c/IR.h"
+#include "mlir-c/Support.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+MLIR_DECLARE_CAPI_DIALECT_REGISTRATION(Quantum, quantum);
+
+//===---------------------------------------------------------------------===//
+// QubitType
+//===---------------------------------------------------------------------===//
+
+/// Returns `true` if the given type is a quantum::QubitType dialect type.
+MLIR_CAPI_EXPORTED bool mlirTypeIsAQuantumQubitType(MlirType type);
+
+/// Creates a quantum.qubit type of `size` qubits, or a null type if `size`
+/// is invalid.
+MLIR_CAPI_EXPORTED MlirType
+mlirQuantumQubitTypeGet(MlirContext ctx, int64_t size);
+
+/// Returns the number of qubits of the given quantum.qubit type.
+MLIR_CAPI_EXPORTED int64_t mlirQuantumQubitTypeGetSize(MlirType type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#include "quantum-mlir/Dialect/Quantum/Transforms/Passes.capi.h.inc"
+
+#endif // QUANTUM_MLIR_C_DIALECT_QUANTUM_H
@@ -0,0 +1,46 @@
+//===-- quantum-mlir-c/Pipeline.h - C API for the lowering pipeline -------===//
+//
+// @file
+//===----------------------------------------------------------------------===//
+
+#ifndef QUANTUM_MLIR_C_PIPELINE_H
+#define QUANTUM_MLIR_C_PIPELINE_H
+
+#include "mlir-c/IR.h"
+#include "mlir-c/Support.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The kind of artifact produced by the lowering pipeline.
+typedef enum MlirQuantumArtifactKind {
+    MlirQuantumArtifactLLVMDialect,
+    MlirQuantumArtifactObject,
+} MlirQuantumArtifactKind;
+
+/// Returns the pipeline that lowers the quantum and qir dialects to the LLVM
+/// dialect.
+MLIR_CAPI_EXPORTED MlirStringRef mlirQuantumGetDefaultLoweringPipeline(void);
+
+/// Lowers `module` by `pipeline` and passes the artifact of `kind` to
+/// `callback`. If `cacheDir` is not empty, artifacts are looked up in and
+/// stored to the cache in that directory, which holds at most `cacheBytes`
+/// bytes, and `cached` is set to whether the artifact was a hit.
+MLIR_CAPI_EXPORTED MlirLogicalResult mlirQuantumCompileModule(
+    MlirModule module,
+    MlirStringRef pipeline,
+    MlirQuantumArtifactKind kind,
+    MlirStringRef cacheDir,
+    uint64_t cacheBytes,
+    MlirStringCallback callback,
+    void* userData,
+    bool* cached);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // QUANTUM_MLIR_C_PIPELINE_H
@@ -23,10 +23,13 @@ namespace qir {
 
 struct AllocationAnalysis;
 
+/// Adds the QIR to LLVM lowering patterns to @p patterns . A non-empty
+/// @p runtimeConfig is passed to the runtime on `qir.init`.
 void populateConvertQIRToLLVMPatterns(
     LLVMTypeConverter &typeConverter,
     RewritePatternSet &patterns,
-    AllocationAnalysis &analysis);
+    AllocationAnalysis &analysis,
+    StringRef runtimeConfig = {});
 
 } // namespace qir
 
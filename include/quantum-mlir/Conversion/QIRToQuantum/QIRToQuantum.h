@@ -3,7 +3,9 @@
 #include "mlir/Pass/Pass.h"
 #include "mlir/Transforms/DialectConversion.h"
 
-#include <mlir/IR/IRMapping.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/SmallVector.h>
+#include <mlir/IR/Value.h>
 
 namespace mlir {
 
@@ -16,10 +18,46 @@ namespace mlir {
 
 namespace qir {
 
+/// Rebuilds the value-semantic qubit chains of the quantum dialect from the
+/// reference semantics of qir while one function is lifted.
+///
+/// Qubits are numbered densely when the table is created: the entry block
+/// arguments first, by position, then the qir.alloc results in program
+/// order. Lifting an op then reads and advances the latest version of each
+/// of its qubits in place. Every function gets its own table, so functions
+/// can be lifted concurrently.
+class QubitChains {
+public:
+    /// Numbers the qubits defined in @p root .
+    explicit QubitChains(Operation* root);
+
+    /// Returns the ID of the qir qubit @p qubit .
+    unsigned getId(Value qubit) const { return ids.at(qubit); }
+
+    /// Returns the latest version of the qubit @p id , which is its lifted
+    /// definition @p converted as long as no op has used it.
+    Value &getVersion(unsigned id, Value converted)
+    {
+        Value &version = versions[id];
+        if (!version) version = converted;
+        return version;
+    }
+    /// Returns the latest version of the qir qubit @p qubit , see above.
+    Value &getVersion(Value qubit, Value converted)
+    {
+        return getVersion(getId(qubit), converted);
+    }
+
+private:
+    /// Only holds the definitions, so its size is the number of qubits.
+    DenseMap<Value, unsigned> ids;
+    SmallVector<Value> versions;
+};
+
 void populateConvertQIRToQuantumPatterns(
     TypeConverter &typeConverter,
     RewritePatternSet &patterns,
-    IRMapping &mapping);
+    QubitChains &chains);
 
 } // namespace qir
 
@@ -26,6 +26,18 @@ void populateUGatesDecompositionPatterns(RewritePatternSet &patterns);
 /// Constructs the lower-funnel-shift pass.
 std::unique_ptr<Pass> createDecomposeUGatesPass();
 
+/// Constructs the inject-noise pass.
+std::unique_ptr<Pass> createInjectNoisePass();
+
+/// Constructs the trajectory-driver pass.
+std::unique_ptr<Pass> createTrajectoryDriverPass();
+
+/// Constructs the localize-qubits pass.
+std::unique_ptr<Pass> createLocalizeQubitsPass();
+
+/// Constructs the merge-parametric-functions pass.
+std::unique_ptr<Pass> createMergeParametricFunctionsPass();
+
 //===----------------------------------------------------------------------===//
 // Registration
 //===----------------------------------------------------------------------===//
@@ -0,0 +1,115 @@
+/// Declaration of the circuit builder for the Quantum dialect.
+///
+/// @file
+
+#pragma once
+
+#include "mlir/IR/Builders.h"
+#include "quantum-mlir/Dialect/Quantum/IR/QuantumOps.h"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mlir::quantum {
+
+/// Builds quantum circuits gate by gate on logical qubits.
+///
+/// Gates are applied to the indices of logical qubits, while the builder keeps
+/// the current SSA value of every qubit. The single-qubit type is created once
+/// and every angle is materialized as a single f64 constant ahead of the
+/// circuit, so that the cost of a gate is the creation of its op alone. This
+/// makes circuits with millions of gates cheap to build.
+///
+/// Example:
+///
+/// @code
+/// CircuitBuilder circuit(builder, loc);
+/// circuit.allocQubits(2);
+/// circuit.h(0).cnot(0, 1).rz(1, 0.25);
+/// Value bit = circuit.measure(1);
+/// @endcode
+class CircuitBuilder {
+public:
+    /// Builds the circuit at the insertion point of @p builder , which is
+    /// advanced past every op of the circuit.
+    explicit CircuitBuilder(OpBuilder &builder, Location loc);
+
+    /// Reserves space for @p numQubits logical qubits and @p numAngles
+    /// distinct angles.
+    void reserve(std::size_t numQubits, std::size_t numAngles = 0);
+
+    /// Sets the location of the ops built from now on.
+    void setLoc(Location newLoc) { loc = newLoc; }
+
+    /// Allocates @p count single qubits and returns the index of the first.
+    unsigned allocQubits(unsigned count = 1);
+    /// Adds @p qubit as a logical qubit and returns its index.
+    unsigned addQubit(Value qubit);
+    /// Returns the number of logical qubits.
+    unsigned getNumQubits() const { return qubits.size(); }
+    /// Returns the current value of the logical qubit @p index .
+    Value getQubit(unsigned index) const { return qubits[index]; }
+    /// Returns the current values of all logical qubits.
+    ArrayRef<Value> getQubits() const { return qubits; }
+
+    /// Returns the f64 constant @p value , which is built once per circuit.
+    Value getAngle(double value);
+
+    CircuitBuilder &h(unsigned qubit);
+    CircuitBuilder &x(unsigned qubit);
+    CircuitBuilder &y(unsigned qubit);
+    CircuitBuilder &z(unsigned qubit);
+    CircuitBuilder &s(unsigned qubit);
+    CircuitBuilder &sdg(unsigned qubit);
+    CircuitBuilder &t(unsigned qubit);
+    CircuitBuilder &tdg(unsigned qubit);
+
+    CircuitBuilder &rx(unsigned qubit, double theta);
+    CircuitBuilder &rx(unsigned qubit, Value theta);
+    CircuitBuilder &ry(unsigned qubit, double theta);
+    CircuitBuilder &ry(unsigned qubit, Value theta);
+    CircuitBuilder &rz(unsigned qubit, double theta);
+    CircuitBuilder &rz(unsigned qubit, Value theta);
+    CircuitBuilder &u1(unsigned qubit, double lambda);
+    CircuitBuilder &u2(unsigned qubit, double phi, double lambda);
+    CircuitBuilder &u3(unsigned qubit, double theta, double phi, double lambda);
+
+    CircuitBuilder &cnot(unsigned control, unsigned target);
+    CircuitBuilder &cz(unsigned control, unsigned target);
+    CircuitBuilder &swap(unsigned lhs, unsigned rhs);
+    CircuitBuilder &crz(unsigned control, unsigned target, double angle);
+    CircuitBuilder &cry(unsigned control, unsigned target, double angle);
+    CircuitBuilder &ccx(unsigned control1, unsigned control2, unsigned target);
+
+    /// Adds a barrier on @p indices , or on all qubits if it is empty.
+    CircuitBuilder &barrier(ArrayRef<unsigned> indices = {});
+
+    /// Measures the logical qubit @p index and returns the i1 outcome.
+    Value measure(unsigned index);
+    /// Deallocates the logical qubit @p index , which must not be used after.
+    void deallocate(unsigned index);
+
+private:
+    /// Builds @p Op on the logical qubits @p indices with the trailing
+    /// @p params , and makes its results the new values of the qubits.
+    template<typename Op>
+    CircuitBuilder &apply(ArrayRef<unsigned> indices, ValueRange params = {});
+
+    /// Returns @p op after making it the anchor of the angle constants.
+    Operation* track(Operation* op);
+
+    OpBuilder &builder;
+    Location loc;
+    Type qubitType;
+    Type f64Type;
+    SmallVector<Value> qubits;
+    llvm::DenseMap<std::uint64_t, Value> angles;
+    /// The first op of the circuit, before which the constants are built.
+    Operation* front = nullptr;
+};
+
+} // namespace mlir::quantum
@@ -0,0 +1,60 @@
+/// Declares the commutation rules of the Quantum gates and the helpers of the
+/// passes that rewrite them.
+///
+/// @file
+
+#pragma once
+
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/Operation.h"
+
+namespace mlir::quantum {
+
+/// The axis of the single-qubit gates that commute with a gate on a qubit.
+enum class PauliAxis { None, X, Y, Z };
+
+/// Returns whether @p op is a primitive gate other than a barrier, i.e. one
+/// whose leading operands are the qubits it produces, followed by its params.
+bool isPrimitiveGate(Operation* op);
+
+/// Returns whether @p op is a rotation whose angle is its second operand.
+bool isRotation(Operation* op);
+
+/// Returns the axis of the single-qubit gate @p op , e.g. Z for `T` and `Rz`,
+/// or None if it is not a Pauli gate or a rotation about one.
+PauliAxis getAxis(Operation* op);
+
+/// Returns the axis of the single-qubit gates that commute with @p op on its
+/// qubit operand @p index , e.g. Z on the control of a `CNOT` and X on its
+/// target.
+PauliAxis getAxis(Operation* op, unsigned index);
+
+/// Returns whether @p lhs followed by @p rhs is the identity.
+bool isInversePair(Operation* lhs, Operation* rhs);
+
+/// Returns the float value of @p value if it is a constant, e.g. the angle
+/// of a rotation.
+FloatAttr getConstantFloat(Value value);
+
+/// Returns the sum of the constant angles @p lhs and @p rhs , or null if one
+/// of them is null or their types differ.
+FloatAttr addConstantAngles(FloatAttr lhs, FloatAttr rhs);
+
+/// Returns whether the angles @p lhs and @p rhs are constants that cancel.
+bool anglesCancel(Value lhs, Value rhs);
+
+/// Maps the params of @p gate in the body of an op that captures the values
+/// @p captured as its trailing block arguments to the values outside of it,
+/// cloning constants at the insertion point of @p builder .
+void mapParams(
+    OpBuilder &builder,
+    ValueRange captured,
+    Operation* gate,
+    IRMapping &map);
+
+/// Erases @p gate and the constants it leaves unused.
+void eraseGate(Operation* gate);
+
+} // namespace mlir::quantum
@@ -26,6 +26,26 @@ void populateQuantumOptimisePatterns(RewritePatternSet &patterns);
 
 void populateHermitianCancelPatterns(RewritePatternSet &patterns);
 
+/// The rewrites applied by applyPeephole.
+struct PeepholeOptions {
+    /// Number of commuting gates a single-qubit gate looks through.
+    unsigned window = 4;
+    /// Cancels adjacent self-inverse gates and inverse pairs.
+    bool cancelInverses = true;
+    /// Also cancels S/Sdg and T/Tdg, which are inverses but not Hermitian.
+    bool cancelPhasePairs = true;
+    /// Merges consecutive rotations about the same axis.
+    bool mergeRotations = true;
+    /// Drops diagonal gates before measurements.
+    bool dropPhases = true;
+    /// Drops every diagonal gate before a measurement, rather than only Z.
+    bool dropAllDiagonal = true;
+};
+
+/// Applies the peephole rewrites of @p options to the blocks nested in
+/// @p root in a single walk over every block.
+void applyPeephole(Operation* root, const PeepholeOptions &options = {});
+
 void populateMultiQubitLegalizationPatterns(
     TypeConverter converter,
     RewritePatternSet &patterns);
@@ -46,6 +66,27 @@ std::unique_ptr<Pass> createMultiQubitLegalizationPass();
 
 std::unique_ptr<Pass> createScfToRVSDGPass();
 
+/// Pass that inlines custom gates according to a gate-count cost model
+std::unique_ptr<Pass> createQuantumInlineGatesPass();
+
+/// Pass that outlines repeated subcircuits into custom gates
+std::unique_ptr<Pass> createQuantumOutlineGatesPass();
+
+/// Pass that deduplicates, hoists and folds angle constants
+std::unique_ptr<Pass> createQuantumPoolAnglesPass();
+
+/// Pass that cancels, merges and drops gates in a single walk
+std::unique_ptr<Pass> createQuantumPeepholePass();
+
+/// Pass that reorders gates to lower the depth or to group them by qubits
+std::unique_ptr<Pass> createQuantumSchedulePass();
+
+/// Pass that hoists common gates out of quantum.if and defers measurements
+std::unique_ptr<Pass> createQuantumDeferMeasurementPass();
+
+/// Pass that cancels gates across the iterations of quantum.for loops
+std::unique_ptr<Pass> createQuantumRotateLoopsPass();
+
 //===----------------------------------------------------------------------===//
 // Registration
 //===----------------------------------------------------------------------===//
@@ -0,0 +1,67 @@
+/// Declares the on-disk cache of compiled artifacts.
+///
+/// @file
+
+#pragma once
+
+#include "mlir/IR/Operation.h"
+#include "mlir/Support/LLVM.h"
+
+#include <cstdint>
+#include <llvm/Support/MemoryBuffer.h>
+#include <memory>
+#include <string>
+
+namespace mlir::quantum {
+
+/// The kind of artifact produced by the lowering pipeline.
+enum class ArtifactKind {
+    /// The lowered module in the LLVM dialect, as MLIR text.
+    LLVMDialect,
+    /// An object file for the host.
+    Object,
+};
+
+/// A directory of compiled artifacts keyed by the fingerprint of their input.
+///
+/// Every artifact is stored in its own file named after its key. Lookups
+/// update the modification time of the file, which orders the artifacts for
+/// the least-recently-used eviction that keeps the directory below its size
+/// cap. Stores are atomic, so several processes may share a directory.
+class ArtifactCache {
+public:
+    /// Creates a cache in @p directory that holds at most @p maxBytes bytes.
+    explicit ArtifactCache(StringRef directory, std::uint64_t maxBytes);
+
+    /// Returns the key of the artifact of @p kind that @p pipeline produces
+    /// from @p module .
+    ///
+    /// The key is the BLAKE3 hash of the compiler build, of the pipeline and
+    /// the contents of the files its options name, and of the module printed
+    /// in generic form with its locations, so that it covers everything the
+    /// lowering may depend on.
+    static std::string
+    getKey(Operation* module, StringRef pipeline, ArtifactKind kind);
+
+    /// Returns the artifact stored under @p key , or null if there is none.
+    std::unique_ptr<llvm::MemoryBuffer> lookup(StringRef key);
+
+    /// Stores @p data under @p key and evicts artifacts if the cache is full.
+    LogicalResult store(StringRef key, StringRef data);
+
+    /// Removes the least recently used artifacts until the cache holds at
+    /// most its maximum number of bytes.
+    void evict();
+
+    /// Returns the path of the file of the artifact stored under @p key .
+    std::string getPath(StringRef key) const;
+
+    StringRef getDirectory() const { return directory; }
+    std::uint64_t getMaxBytes() const { return maxBytes; }
+
+private:
+    std::string directory;
+    std::uint64_t maxBytes;
+};
+
+} // namespace mlir::quantum
@@ -0,0 +1,44 @@
+/// Declares the compilation of modules through the full lowering pipeline.
+///
+/// @file
+
+#pragma once
+
+#include "mlir/IR/BuiltinOps.h"
+#include "quantum-mlir/Pipeline/ArtifactCache.h"
+
+#include <string>
+
+namespace mlir::quantum {
+
+/// The pipeline that lowers the quantum and qir dialects to the LLVM dialect.
+inline constexpr const char* kDefaultLoweringPipeline =
+    "builtin.module(convert-quantum-to-qir,func.func(convert-scf-to-cf),"
+    "convert-qir-to-llvm,convert-func-to-llvm,convert-cf-to-llvm,"
+    "convert-vector-to-llvm,one-shot-bufferize{allow-unknown-ops},"
+    "finalize-memref-to-llvm,convert-index-to-llvm,convert-arith-to-llvm,"
+    "reconcile-unrealized-casts)";
+
+/// The result of compileModule.
+struct CompiledArtifact {
+    /// The LLVM dialect module as text, or the contents of the object file.
+    std::string data;
+    /// Whether the artifact was taken from the cache.
+    bool cached = false;
+};
+
+/// Registers the passes that may appear in a lowering pipeline.
+void registerPipelinePasses();
+
+/// Lowers @p module by @p pipeline and returns the artifact of @p kind .
+///
+/// If @p cache is not null, an artifact stored under the fingerprint of the
+/// module is returned without running any pass, and a new one is stored.
+/// @p module is only modified if the pipeline runs.
+FailureOr<CompiledArtifact> compileModule(
+    ModuleOp module,
+    StringRef pipeline,
+    ArtifactKind kind,
+    ArtifactCache* cache = nullptr);
+
+} // namespace mlir::quantum
@@ -0,0 +1,94 @@
+/// Declares the inter-process communication of the distributed runtime.
+///
+/// @file
+
+#pragma once
+
+#include "quantum-mlir/Runtime/Gates.h"
+
+#include <cstddef>
+#include <memory>
+
+namespace quantum::runtime {
+
+/// Names of the environment variables that describe the process group.
+inline constexpr const char* kRankEnvVar = "QUANTUM_RANK";
+inline constexpr const char* kRanksEnvVar = "QUANTUM_RANKS";
+inline constexpr const char* kSegmentEnvVar = "QUANTUM_SHM";
+
+/// Maximum number of ranks of a process group.
+inline constexpr unsigned kMaxRanks = 64;
+
+/// A group of processes that execute the same program, modelled after the
+/// MPI primitives that the distributed simulator needs.
+///
+/// All operations are collective: every rank must call them in the same
+/// order.
+class Communicator {
+public:
+    virtual ~Communicator() = default;
+
+    virtual unsigned getRank() const = 0;
+    virtual unsigned getSize() const = 0;
+
+    /// Blocks until all ranks have arrived.
+    virtual void barrier() = 0;
+    /// Sends @p count amplitudes from @p send to @p partner and receives
+    /// @p count amplitudes from it into @p recv . Ranks are paired, i.e. the
+    /// partner of @p partner is the calling rank.
+    virtual void exchange(
+        unsigned partner,
+        const Amplitude* send,
+        Amplitude* recv,
+        std::size_t count) = 0;
+    /// Returns the sum of @p value over all ranks, which is bitwise identical
+    /// on every rank.
+    virtual double allReduceSum(double value) = 0;
+};
+
+/// A communicator between processes on one machine that share a POSIX
+/// shared memory segment, which stands in for MPI.
+///
+/// Exchanges pass through a mailbox per rank, so the amplitudes themselves
+/// stay private to each process.
+class SharedMemoryCommunicator : public Communicator {
+public:
+    /// Returns the size of the segment for a group of @p size ranks.
+    static std::size_t getSegmentSize(unsigned size);
+
+    /// Joins the group via the segment named @p name , or returns nullptr
+    /// after reporting the failure on stderr.
+    static std::unique_ptr<SharedMemoryCommunicator>
+    connect(const char* name, unsigned rank, unsigned size);
+
+    ~SharedMemoryCommunicator() override;
+
+    unsigned getRank() const override { return rank; }
+    unsigned getSize() const override { return size; }
+
+    void barrier() override;
+    void exchange(
+        unsigned partner,
+        const Amplitude* send,
+        Amplitude* recv,
+        std::size_t count) override;
+    double allReduceSum(double value) override;
+
+private:
+    struct Header;
+
+    SharedMemoryCommunicator(void* segment, unsigned rank, unsigned size);
+
+    Amplitude* getMailbox(unsigned owner) const;
+
+    void* segment;
+    Header* header;
+    unsigned rank;
+    unsigned size;
+};
+
+/// Returns the communicator of the process group described by the
+/// environment, or nullptr if this process runs on its own.
+Communicator* getWorldCommunicator();
+
+} // namespace quantum::runtime
@@ -0,0 +1,107 @@
+/// Declares the distributed state-vector simulator of the runtime.
+///
+/// @file
+
+#pragma once
+
+#include "quantum-mlir/Runtime/Communicator.h"
+#include "quantum-mlir/Runtime/Simulator.h"
+
+#include <vector>
+
+namespace quantum::runtime {
+
+/// A state-vector simulator that shards the amplitudes across the 2^k ranks
+/// of a Communicator.
+///
+/// Each logical qubit occupies either one of the k global slots, which
+/// select the rank, or a local slot, which indexes the amplitudes of a rank.
+/// The global slots start out as |0> and are handed to the first k qubits,
+/// so rank 0 initially holds the whole state. Gates on local targets run
+/// without communication, diagonal gates and global controls only select or
+/// scale the local amplitudes, and other gates on global targets exchange
+/// the amplitudes with the partner rank that differs in that slot.
+///
+/// Every rank executes the same program and draws the same random samples,
+/// so measurement outcomes agree across ranks.
+class DistributedSimulator : public Simulator {
+public:
+    /// Creates an empty simulator on the ranks of @p comm , which place their
+    /// local amplitudes according to @p storage .
+    explicit DistributedSimulator(
+        Communicator &comm,
+        const StorageOptions &storage = {});
+
+    Backend getBackend() const override { return Backend::StateVector; }
+    std::size_t getNumQubits() const override { return layout.size(); }
+    std::size_t getStorageSize() const override { return local.size(); }
+
+    /// Returns whether logical qubit @p qubit occupies a global slot.
+    bool isGlobal(QubitIndex qubit) const { return layout[qubit].global; }
+    /// Returns the amplitudes owned by this rank.
+    const StateVector &getLocalState() const { return local; }
+    /// Returns the number of amplitude exchanges performed so far.
+    std::size_t getNumExchanges() const { return numExchanges; }
+
+    void addQubits(std::size_t count) override;
+
+    void applyMatrix(const Matrix2 &m, QubitIndex target) override;
+    void applyDiagonal(Amplitude d0, Amplitude d1, QubitIndex target) override;
+    void applyControlled(
+        const Matrix2 &m,
+        QubitIndex control,
+        QubitIndex target) override;
+    void applyDoublyControlled(
+        const Matrix2 &m,
+        QubitIndex control0,
+        QubitIndex control1,
+        QubitIndex target) override;
+    /// Relabels qubits of the same kind, and exchanges amplitudes between a
+    /// global and a local qubit so that the state of the global qubit
+    /// becomes local.
+    void swap(QubitIndex lhs, QubitIndex rhs) override;
+
+    double probabilityOfOne(QubitIndex target) override;
+    void collapse(QubitIndex target, bool outcome, double probability) override;
+
+    void applyChannel(
+        const KrausChannel &channel,
+        QubitIndex target,
+        double sample) override;
+
+private:
+    /// The position of a logical qubit.
+    struct Slot {
+        bool global;
+        QubitIndex index;
+    };
+
+    /// Returns the bit of this rank in global slot @p index .
+    bool getRankBit(QubitIndex index) const;
+    /// Applies @p m to @p target under the given controls.
+    void apply(
+        const Matrix2 &m,
+        const QubitIndex* controls,
+        unsigned numControls,
+        QubitIndex target);
+    /// Fetches the amplitudes of the partner rank in global slot @p index .
+    void fetchPartner(QubitIndex index);
+    /// Combines the local and partner amplitudes under @p m for the global
+    /// slot @p index , restricted to indices containing @p mask . Returns the
+    /// squared norm of the result and stores it if @p store is set.
+    double combine(
+        const Matrix2 &m,
+        QubitIndex index,
+        std::size_t mask,
+        bool store);
+
+    Communicator &comm;
+    std::size_t numGlobal;
+    std::size_t nextGlobal = 0;
+    std::vector<Slot> layout;
+    StateVector local;
+    std::vector<Amplitude> partner;
+    std::size_t numExchanges = 0;
+};
+
+} // namespace quantum::runtime
@@ -0,0 +1,92 @@
+/// Declares the gate matrices used by the simulator runtime.
+///
+/// @file
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <complex>
+
+namespace quantum::runtime {
+
+/// Amplitude of a computational basis state.
+using Amplitude = std::complex<double>;
+
+/// A row-major 2x2 complex matrix acting on a single qubit.
+using Matrix2 = std::array<Amplitude, 4>;
+
+namespace gates {
+
+inline constexpr double kInvSqrt2 = 0.70710678118654752440;
+
+inline Matrix2 identity() { return {1.0, 0.0, 0.0, 1.0}; }
+inline Matrix2 h() { return {kInvSqrt2, kInvSqrt2, kInvSqrt2, -kInvSqrt2}; }
+inline Matrix2 x() { return {0.0, 1.0, 1.0, 0.0}; }
+inline Matrix2 y() { return {0.0, Amplitude(0, -1), Amplitude(0, 1), 0.0}; }
+inline Matrix2 z() { return {1.0, 0.0, 0.0, -1.0}; }
+
+inline Matrix2 rx(double theta)
+{
+    const double c = std::cos(theta / 2), s = std::sin(theta / 2);
+    return {c, Amplitude(0, -s), Amplitude(0, -s), c};
+}
+
+inline Matrix2 ry(double theta)
+{
+    const double c = std::cos(theta / 2), s = std::sin(theta / 2);
+    return {c, -s, s, c};
+}
+
+inline Matrix2 u2(double phi, double lambda)
+{
+    return {
+        kInvSqrt2,
+        -kInvSqrt2 * std::polar(1.0, lambda),
+        kInvSqrt2 * std::polar(1.0, phi),
+        kInvSqrt2 * std::polar(1.0, phi + lambda)};
+}
+
+/// Returns the diagonal of Rz(@p theta) as the pair (d0, d1).
+inline std::array<Amplitude, 2> rzDiagonal(double theta)
+{
+    return {std::polar(1.0, -theta / 2), std::polar(1.0, theta / 2)};
+}
+
+/// Returns the diagonal of a phase gate diag(1, exp(i @p lambda)).
+inline std::array<Amplitude, 2> phaseDiagonal(double lambda)
+{
+    return {1.0, std::polar(1.0, lambda)};
+}
+
+/// Returns the element-wise complex conjugate of @p m .
+inline Matrix2 conjugate(const Matrix2 &m)
+{
+    return {std::conj(m[0]), std::conj(m[1]), std::conj(m[2]), std::conj(m[3])};
+}
+
+/// Returns whether @p m only has entries on its diagonal.
+inline bool isDiagonal(const Matrix2 &m)
+{
+    return m[1] == Amplitude(0.0) && m[2] == Amplitude(0.0);
+}
+
+/// Returns @p m multiplied by @p factor .
+inline Matrix2 scaled(const Matrix2 &m, double factor)
+{
+    return {m[0] * factor, m[1] * factor, m[2] * factor, m[3] * factor};
+}
+
+/// Returns the product @p a * @p b .
+inline Matrix2 multiply(const Matrix2 &a, const Matrix2 &b)
+{
+    return {
+        a[0] * b[0] + a[1] * b[2],
+        a[0] * b[1] + a[1] * b[3],
+        a[2] * b[0] + a[3] * b[2],
+        a[2] * b[1] + a[3] * b[3]};
+}
+
+} // namespace gates
+
+} // namespace quantum::runtime
@@ -0,0 +1,40 @@
+/// Declares the single-qubit noise channels of the simulator runtime.
+///
+/// @file
+
+#pragma once
+
+#include "quantum-mlir/Runtime/Gates.h"
+
+#include <vector>
+
+namespace quantum::runtime {
+
+/// A completely positive, trace preserving single-qubit map given by its Kraus
+/// operators.
+///
+/// When every operator is a scaled unitary, the channel is a mixture of
+/// unitaries and @c mixture holds the state-independent selection
+/// probabilities, which allows trajectory sampling without computing norms.
+struct KrausChannel {
+    std::vector<Matrix2> operators;
+    std::vector<double> mixture;
+
+    bool isUnitaryMixture() const { return !mixture.empty(); }
+};
+
+/// Returns the index of the first cumulative @p weights entry that exceeds
+/// @p sample , i.e. samples an index with probability proportional to its
+/// weight when @p sample is uniform in [0, sum of weights). Only indices of
+/// positive weight are returned, so larger samples select the last of them.
+std::size_t sampleIndex(const std::vector<double> &weights, double sample);
+
+/// Returns the depolarizing channel of error probability @p p , which applies
+/// each of X, Y and Z with probability p/3.
+KrausChannel depolarizing(double p);
+
+/// Returns the amplitude damping channel that decays |1> to |0> with
+/// probability @p gamma .
+KrausChannel amplitudeDamping(double gamma);
+
+} // namespace quantum::runtime
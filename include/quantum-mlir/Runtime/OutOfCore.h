@@ -0,0 +1,97 @@
+/// Declares the out-of-core state-vector simulator of the runtime.
+///
+/// @file
+
+#pragma once
+
+#include "quantum-mlir/Runtime/Profile.h"
+#include "quantum-mlir/Runtime/Simulator.h"
+
+#include <vector>
+
+namespace quantum::runtime {
+
+/// A state-vector simulator that minimises passes over large amplitude
+/// arrays, e.g. when they are backed by a memory-mapped file.
+///
+/// The state is split into chunks of 2^L amplitudes, where the L low-order
+/// physical qubits are local to a chunk. Gates are queued and applied in
+/// runs: every chunk is loaded once and receives all gates of the run before
+/// the next chunk is touched. Gates with a high-order target are made local
+/// by swapping their qubit with a local one that is not needed soon, and
+/// high-order controls merely select the affected chunks. Logical swaps only
+/// relabel qubits and never move amplitudes.
+class OutOfCoreSimulator : public StateVectorSimulator {
+public:
+    explicit OutOfCoreSimulator(const StorageOptions &options);
+
+    /// Returns the state in logical qubit order.
+    const StateVector &getState() override;
+
+    void addQubits(std::size_t count) override;
+
+    void applyMatrix(const Matrix2 &m, QubitIndex target) override;
+    void applyDiagonal(Amplitude d0, Amplitude d1, QubitIndex target) override;
+    void applyControlled(
+        const Matrix2 &m,
+        QubitIndex control,
+        QubitIndex target) override;
+    void applyDoublyControlled(
+        const Matrix2 &m,
+        QubitIndex control0,
+        QubitIndex control1,
+        QubitIndex target) override;
+    void swap(QubitIndex lhs, QubitIndex rhs) override;
+
+    double probabilityOfOne(QubitIndex target) override;
+    void collapse(QubitIndex target, bool outcome, double probability) override;
+
+    void applyChannel(
+        const KrausChannel &channel,
+        QubitIndex target,
+        double sample) override;
+
+    /// Applies all queued gates.
+    void flush();
+
+    /// Returns the number of full passes over the state performed so far,
+    /// counting both gate runs and qubit swaps.
+    std::size_t getNumPasses() const { return numPasses; }
+
+private:
+    /// A queued operation on logical qubits.
+    struct Gate {
+        enum class Kind { Matrix, Diagonal, Relabel };
+
+        Kind kind;
+        Matrix2 matrix;
+        unsigned numControls;
+        std::array<QubitIndex, 2> controls;
+        QubitIndex target;
+        /// The entry point that issued the gate, when profiling.
+        OpKind op = OpKind::Other;
+    };
+
+    /// Returns the kind of a gate that applies @p m .
+    static Gate::Kind kindOf(const Matrix2 &m);
+    void enqueue(const Gate &gate);
+    /// Returns the number of local qubits of a chunk.
+    std::size_t getLocalQubits() const;
+    /// Returns whether @p gate can be applied chunk by chunk.
+    bool isChunkLocal(const Gate &gate) const;
+    /// Swaps the target of queue[@p pos] into a local physical qubit.
+    void makeLocal(std::size_t pos);
+    /// Applies @p run , given on physical qubits, chunk by chunk.
+    void applyRun(const std::vector<Gate> &run);
+    /// Swaps physical qubits @p lhs and @p rhs and updates the layout.
+    void swapPhysical(QubitIndex lhs, QubitIndex rhs);
+
+    std::size_t chunkQubits;
+    std::vector<Gate> queue;
+    /// Maps logical to physical qubits and back.
+    std::vector<QubitIndex> physical;
+    std::vector<QubitIndex> logical;
+    std::size_t numPasses = 0;
+};
+
+} // namespace quantum::runtime
@@ -0,0 +1,202 @@
+/// Declares the optional profiling instrumentation of the simulator runtime.
+///
+/// @file
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace quantum::runtime {
+
+/// Whether the runtime records profiles, which is decided when it is built
+/// via the QUANTUM_RUNTIME_PROFILING CMake option.
+#ifdef QUANTUM_RUNTIME_PROFILING
+inline constexpr bool kProfilingEnabled = true;
+#else
+inline constexpr bool kProfilingEnabled = false;
+#endif
+
+/// The operations that are profiled separately.
+enum class OpKind : unsigned {
+    H,
+    X,
+    Y,
+    Z,
+    S,
+    Sdg,
+    T,
+    Tdg,
+    Rx,
+    Ry,
+    Rz,
+    U1,
+    U2,
+    CNOT,
+    CZ,
+    Swap,
+    CRz,
+    CRy,
+    CCX,
+    Measure,
+    Reset,
+    Depolarizing,
+    AmplitudeDamping,
+    ReadoutError,
+    /// Operations that are not issued through a QIR entry point.
+    Other
+};
+
+inline constexpr std::size_t kNumOpKinds =
+    static_cast<std::size_t>(OpKind::Other) + 1;
+
+/// Returns the name of @p kind , e.g. "cnot".
+const char* getName(OpKind kind);
+
+/// Selects the file format of a profile.
+enum class ProfileFormat {
+    /// A JSON object with the counters per operation kind.
+    Summary,
+    /// The Chrome trace event format, with one event per operation, which
+    /// can be loaded into chrome://tracing or Perfetto.
+    ChromeTrace
+};
+
+/// Parses @p name into @p format . Returns false if the name is unknown.
+bool parseProfileFormat(std::string_view name, ProfileFormat &format);
+
+/// The counters of one operation kind.
+struct OpCounters {
+    std::uint64_t calls = 0;
+    std::uint64_t nanoseconds = 0;
+    /// Estimated bytes of amplitudes read and written.
+    std::uint64_t bytes = 0;
+    /// Operations that shared a pass over the state with a preceding one.
+    std::uint64_t fusions = 0;
+};
+
+using ProfileCounters = std::array<OpCounters, kNumOpKinds>;
+
+/// Collects the profile of the process.
+///
+/// Every thread counts into a private block, so recording needs no
+/// synchronisation; the blocks are only merged when the profile is read.
+class Profiler {
+public:
+    /// Maximum number of trace events kept per thread. Counters continue
+    /// beyond this limit.
+    static constexpr std::size_t kMaxEvents = std::size_t(1) << 20;
+
+    /// Returns the profiler of the process.
+    static Profiler &get();
+
+    /// Returns the nanoseconds since the profiler was created.
+    std::uint64_t now() const;
+
+    /// Writes the profile to @p path in @p format when it is dumped.
+    void setOutput(std::string path, ProfileFormat format);
+
+    /// Records an operation of @p kind that ran from @p begin to @p end and
+    /// touched @p bytes bytes of amplitudes.
+    void record(
+        OpKind kind,
+        std::uint64_t begin,
+        std::uint64_t end,
+        std::uint64_t bytes);
+    /// Records that an operation of @p kind was fused into a shared pass.
+    void recordFusion(OpKind kind);
+
+    /// Returns the counters summed over all threads.
+    ProfileCounters getTotals() const;
+    /// Returns the counters of every source site summed over all threads and
+    /// kinds, from the most to the least time spent.
+    std::vector<std::pair<std::string, OpCounters>> getSiteTotals() const;
+    /// Discards everything recorded so far.
+    void reset();
+
+    /// Writes the profile to the output file, if one was set. Returns false
+    /// if it cannot be written.
+    bool dump();
+    /// Writes the profile to @p path in @p format .
+    bool write(const std::string &path, ProfileFormat format) const;
+
+private:
+    struct Event {
+        OpKind kind;
+        const char* site;
+        std::uint64_t begin;
+        std::uint64_t duration;
+    };
+    struct ThreadProfile {
+        ProfileCounters counters{};
+        /// Counters per site, keyed by the address of its name.
+        std::unordered_map<const char*, OpCounters> sites;
+        std::vector<Event> events;
+    };
+
+    Profiler();
+    ThreadProfile &getThreadProfile();
+
+    std::chrono::steady_clock::time_point epoch;
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadProfile>> threads;
+    std::string path;
+    ProfileFormat format = ProfileFormat::Summary;
+};
+
+/// Returns the estimated bytes of amplitudes that an operation of @p kind
+/// reads and writes on the current simulator.
+std::uint64_t estimateTraffic(OpKind kind);
+
+/// Marks @p kind as the operation being executed by the calling thread, so
+/// that simulators can attribute deferred work such as fusion to it.
+void setCurrentOp(OpKind kind);
+/// Returns the operation being executed by the calling thread.
+OpKind getCurrentOp();
+
+/// Attributes the following operations of the calling thread to the source
+/// location @p site , e.g. `kernel.mlir:12:5`, or to none if it is null. The
+/// string must outlive the profile.
+void setCurrentSite(const char* site);
+
+/// Records the operation of @p kind that runs during the lifetime of the
+/// scope. Without profiling support it is empty and compiles to nothing.
+template<bool Enabled = kProfilingEnabled>
+class ProfileScope {
+public:
+    explicit ProfileScope(OpKind) {}
+};
+
+template<>
+class ProfileScope<true> {
+public:
+    explicit ProfileScope(OpKind kind)
+            : kind(kind),
+              begin(Profiler::get().now())
+    {
+        setCurrentOp(kind);
+    }
+    ~ProfileScope()
+    {
+        Profiler &profiler = Profiler::get();
+        profiler.record(kind, begin, profiler.now(), estimateTraffic(kind));
+        setCurrentOp(OpKind::Other);
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    OpKind kind;
+    std::uint64_t begin;
+};
+
+} // namespace quantum::runtime
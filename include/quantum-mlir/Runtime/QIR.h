@@ -0,0 +1,93 @@
+/// Declares the QIR entry points exported by the simulator runtime.
+///
+/// These are the symbols emitted by the convert-qir-to-llvm pass. Qubits and
+/// results are addressed statically: the pointer value is the integer ID that
+/// the lowering assigned to the qir.alloc or qir.ralloc op.
+///
+/// @file
+
+#pragma once
+
+#include <cstdint>
+
+extern "C" {
+
+struct QirQubit;
+struct QirResult;
+
+//===----------------------------------------------------------------------===//
+// Runtime
+//===----------------------------------------------------------------------===//
+
+/// Starts a new simulation. @p config is an optional option string, see
+/// quantum::runtime::RuntimeConfig.
+void __quantum__rt__initialize(const char* config);
+/// Ends the program, writing the profile if one was requested. Profiles are
+/// also written at exit for programs that do not call it.
+void __quantum__rt__finalize();
+/// Attributes the following operations to the source location @p site in
+/// the profile. Emitted by convert-qir-to-llvm with `site-ids` enabled.
+void __quantum__rt__set_site(const char* site);
+void set_rng_seed(std::int64_t seed);
+/// Restarts the random number generator at the beginning of @p stream under
+/// @p seed . Streams are independent and reproducible, so e.g. selecting the
+/// shot index as stream makes every shot independent of execution order.
+void __quantum__rt__set_rng_stream(std::int64_t seed, std::int64_t stream);
+/// Executes @p kernel over the number of trajectories and threads of the
+/// configuration the calling thread was initialized with, or the default
+/// one, and prints the histogram of the result registers, one
+/// `<bitstring>: <count>` line per outcome.
+void __quantum__rt__run_trajectories(void (*kernel)());
+
+//===----------------------------------------------------------------------===//
+// Gates
+//===----------------------------------------------------------------------===//
+
+void __quantum__qis__h__body(QirQubit* qubit);
+void __quantum__qis__x__body(QirQubit* qubit);
+void __quantum__qis__y__body(QirQubit* qubit);
+void __quantum__qis__z__body(QirQubit* qubit);
+void __quantum__qis__s__body(QirQubit* qubit);
+void __quantum__qis__sdg__body(QirQubit* qubit);
+void __quantum__qis__t__body(QirQubit* qubit);
+void __quantum__qis__tdg__body(QirQubit* qubit);
+void __quantum__qis__rx__body(double theta, QirQubit* qubit);
+void __quantum__qis__ry__body(double theta, QirQubit* qubit);
+void __quantum__qis__rz__body(double theta, QirQubit* qubit);
+void __quantum__qis__u1__body(double lambda, QirQubit* qubit);
+void __quantum__qis__u2__body(double phi, double lambda, QirQubit* qubit);
+void __quantum__qis__cnot__body(QirQubit* control, QirQubit* target);
+void __quantum__qis__cz__body(QirQubit* control, QirQubit* target);
+void __quantum__qis__swap__body(QirQubit* lhs, QirQubit* rhs);
+void __quantum__qis__crz__body(
+    double theta,
+    QirQubit* control,
+    QirQubit* target);
+void __quantum__qis__cry__body(
+    double theta,
+    QirQubit* control,
+    QirQubit* target);
+void __quantum__qis__ccx__body(
+    QirQubit* control0,
+    QirQubit* control1,
+    QirQubit* target);
+
+//===----------------------------------------------------------------------===//
+// Measurement
+//===----------------------------------------------------------------------===//
+
+void __quantum__qis__mz__body(QirQubit* qubit, QirResult* result);
+bool __quantum__qis__read_result__body(QirResult* result);
+void __quantum__qis__reset__body(QirQubit* qubit);
+
+//===----------------------------------------------------------------------===//
+// Noise channels
+//===----------------------------------------------------------------------===//
+
+void __quantum__qis__depolarizing__body(double probability, QirQubit* qubit);
+void __quantum__qis__amplitude_damping__body(double gamma, QirQubit* qubit);
+void __quantum__qis__readout_error__body(
+    double probability,
+    QirResult* result);
+
+} // extern "C"
@@ -0,0 +1,104 @@
+/// Declares the counter-based random number generator of the runtime.
+///
+/// @file
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace quantum::runtime {
+
+/// The Philox4x32-10 counter-based generator of Salmon et al., "Parallel
+/// random numbers: as easy as 1, 2, 3" (SC'11).
+///
+/// Philox is a keyed bijection of a 128-bit counter. It has no state besides
+/// key and counter, so any block of any stream can be computed directly and
+/// independent streams need no coordination between threads.
+class Philox4x32 {
+public:
+    using Counter = std::array<std::uint32_t, 4>;
+    using Key = std::array<std::uint32_t, 2>;
+
+    /// Returns the 128 random bits at @p counter under @p key .
+    static Counter generate(Counter counter, Key key)
+    {
+        for (int round = 0; round < 10; ++round) {
+            if (round > 0) {
+                key[0] += kWeyl0;
+                key[1] += kWeyl1;
+            }
+            const std::uint64_t p0 = std::uint64_t{kMultiplier0} * counter[0];
+            const std::uint64_t p1 = std::uint64_t{kMultiplier1} * counter[2];
+            counter = {
+                static_cast<std::uint32_t>(p1 >> 32) ^ counter[1] ^ key[0],
+                static_cast<std::uint32_t>(p1),
+                static_cast<std::uint32_t>(p0 >> 32) ^ counter[3] ^ key[1],
+                static_cast<std::uint32_t>(p0)};
+        }
+        return counter;
+    }
+
+private:
+    static constexpr std::uint32_t kMultiplier0 = 0xD2511F53;
+    static constexpr std::uint32_t kMultiplier1 = 0xCD9E8D57;
+    static constexpr std::uint32_t kWeyl0 = 0x9E3779B9;
+    static constexpr std::uint32_t kWeyl1 = 0xBB67AE85;
+};
+
+/// A reproducible stream of uniform samples.
+///
+/// The seed is the Philox key, and the counter is formed by the 64-bit
+/// stream number and the 64-bit index of the block within the stream. Sample
+/// i of stream s therefore only depends on the seed, s and i, but not on the
+/// thread or the order in which streams are consumed.
+class RandomStream {
+public:
+    RandomStream() = default;
+    RandomStream(std::uint64_t seed, std::uint64_t stream)
+    {
+        reset(seed, stream);
+    }
+
+    /// Restarts at the first sample of @p stream under @p seed .
+    void reset(std::uint64_t seed, std::uint64_t stream)
+    {
+        key = {
+            static_cast<std::uint32_t>(seed),
+            static_cast<std::uint32_t>(seed >> 32)};
+        this->stream = stream;
+        block = 0;
+        available = 0;
+    }
+
+    /// Returns the next uniform sample in [0, 1) with 53 bits of precision.
+    double sample()
+    {
+        if (available == 0) refill();
+        return static_cast<double>(buffer[--available] >> 11) * 0x1.0p-53;
+    }
+
+private:
+    void refill()
+    {
+        const Philox4x32::Counter bits = Philox4x32::generate(
+            {static_cast<std::uint32_t>(block),
+             static_cast<std::uint32_t>(block >> 32),
+             static_cast<std::uint32_t>(stream),
+             static_cast<std::uint32_t>(stream >> 32)},
+            key);
+        ++block;
+        // Samples are consumed from the back.
+        buffer[1] = (std::uint64_t{bits[1]} << 32) | bits[0];
+        buffer[0] = (std::uint64_t{bits[3]} << 32) | bits[2];
+        available = 2;
+    }
+
+    Philox4x32::Key key = {0, 0};
+    std::uint64_t stream = 0;
+    std::uint64_t block = 0;
+    std::array<std::uint64_t, 2> buffer;
+    unsigned available = 0;
+};
+
+} // namespace quantum::runtime
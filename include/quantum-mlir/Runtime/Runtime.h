@@ -0,0 +1,100 @@
+/// Declares the execution state of the simulator runtime.
+///
+/// @file
+
+#pragma once
+
+#include "quantum-mlir/Runtime/Profile.h"
+#include "quantum-mlir/Runtime/Random.h"
+#include "quantum-mlir/Runtime/Simulator.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace quantum::runtime {
+
+/// Name of the environment variable that overrides the runtime configuration.
+inline constexpr const char* kConfigEnvVar = "QUANTUM_RUNTIME_CONFIG";
+
+/// Options of the runtime, given as `key=value` pairs separated by `;`, e.g.
+/// `backend=density-matrix;trajectories=1000;threads=8` or
+/// `storage=mmap;storage-dir=/scratch;chunk-qubits=24` or
+/// `profile=run.json;profile-format=chrome`.
+struct RuntimeConfig {
+    Backend backend = Backend::StateVector;
+    /// Number of trajectories executed by __quantum__rt__run_trajectories.
+    std::size_t trajectories = 1;
+    /// Number of worker threads; 0 selects the hardware concurrency.
+    unsigned threads = 0;
+    /// Placement of the state-vector amplitudes.
+    StorageOptions storage;
+    /// File that receives the profile when the runtime is finalized, if the
+    /// runtime was built with profiling support.
+    std::string profile;
+    ProfileFormat profileFormat = ProfileFormat::Summary;
+
+    /// Applies the options in @p text on top of the current values. Unknown
+    /// keys and malformed values are reported on stderr and ignored.
+    void parse(std::string_view text);
+};
+
+/// Returns the process-wide default configuration, which is read from the
+/// environment on first use.
+RuntimeConfig &getDefaultConfig();
+
+/// The state of one simulation: the quantum register, the classical result
+/// registers and the random number generator.
+///
+/// Every thread owns a separate state, so independent trajectories can run
+/// concurrently without synchronisation. Samples are drawn from a
+/// counter-based stream selected by the seed and a stream number, so a
+/// trajectory or shot that selects its own stream is reproducible regardless
+/// of the thread executing it.
+class RuntimeState {
+public:
+    /// Starts a new simulation with the options of @p config .
+    void initialize(const RuntimeConfig &config);
+
+    /// Returns the simulator, creating it with the default options if the
+    /// program did not initialize the runtime.
+    Simulator &getSimulator();
+
+    /// Returns the options the simulation was started with, which are the
+    /// default options if the program did not initialize the runtime.
+    const RuntimeConfig &getConfig();
+
+    /// Returns the register index of the qubit with the static @p id ,
+    /// growing the register as needed.
+    QubitIndex getQubit(std::uintptr_t id);
+
+    void setResult(std::uintptr_t id, bool value);
+    bool getResult(std::uintptr_t id) const;
+    /// Returns the result registers as a string of '0' and '1', ordered by ID.
+    std::string getBitstring() const;
+    /// Writes the result registers with IDs below @p count to @p out , one
+    /// byte per register.
+    void copyResults(std::uint8_t* out, std::size_t count) const;
+
+    /// Restarts the current random stream under @p seed .
+    void seed(std::uint64_t seed);
+    /// Restarts at the beginning of random stream @p stream .
+    void setStream(std::uint64_t stream);
+    /// Returns the next uniform sample in [0, 1) of the current stream.
+    double sample() { return random.sample(); }
+
+private:
+    RuntimeConfig config;
+    std::unique_ptr<Simulator> simulator;
+    std::vector<unsigned char> results;
+    std::uint64_t seedValue = 0;
+    std::uint64_t stream = 0;
+    RandomStream random;
+};
+
+/// Returns the state of the calling thread.
+RuntimeState &getRuntimeState();
+
+} // namespace quantum::runtime
@@ -0,0 +1,190 @@
+/// Declares the simulator backends of the runtime.
+///
+/// @file
+
+#pragma once
+
+#include "quantum-mlir/Runtime/Noise.h"
+#include "quantum-mlir/Runtime/StateVector.h"
+
+#include <memory>
+#include <string_view>
+
+namespace quantum::runtime {
+
+/// Selects the representation of the simulated quantum state.
+enum class Backend {
+    /// Pure state; noise channels are sampled as quantum trajectories.
+    StateVector,
+    /// Mixed state; noise channels are applied exactly via Kraus operators.
+    DensityMatrix
+};
+
+/// Parses @p name into @p backend . Returns false if the name is unknown.
+bool parseBackend(std::string_view name, Backend &backend);
+
+/// Common interface of the simulator backends.
+///
+/// All randomness is supplied by the caller as uniform samples in [0, 1), so
+/// the backends themselves are deterministic.
+class Simulator {
+public:
+    virtual ~Simulator() = default;
+
+    virtual Backend getBackend() const = 0;
+    virtual std::size_t getNumQubits() const = 0;
+    /// Returns the number of amplitudes held by this process.
+    virtual std::size_t getStorageSize() const
+    {
+        return std::size_t(1) << getNumQubits();
+    }
+
+    /// Tensors @p count fresh |0> qubits onto the register.
+    virtual void addQubits(std::size_t count) = 0;
+
+    virtual void applyMatrix(const Matrix2 &m, QubitIndex target) = 0;
+    virtual void
+    applyDiagonal(Amplitude d0, Amplitude d1, QubitIndex target) = 0;
+    virtual void applyControlled(
+        const Matrix2 &m,
+        QubitIndex control,
+        QubitIndex target) = 0;
+    virtual void applyDoublyControlled(
+        const Matrix2 &m,
+        QubitIndex control0,
+        QubitIndex control1,
+        QubitIndex target) = 0;
+    virtual void swap(QubitIndex lhs, QubitIndex rhs) = 0;
+
+    /// Returns the probability of measuring @p target in |1>.
+    virtual double probabilityOfOne(QubitIndex target) = 0;
+    /// Projects @p target onto @p outcome , which has @p probability .
+    virtual void
+    collapse(QubitIndex target, bool outcome, double probability) = 0;
+
+    /// Applies @p channel to @p target . Trajectory backends use @p sample to
+    /// select a single Kraus operator.
+    virtual void applyChannel(
+        const KrausChannel &channel,
+        QubitIndex target,
+        double sample) = 0;
+
+    /// Measures @p target in the computational basis.
+    bool measure(QubitIndex target, double sample);
+    /// Returns @p target to |0>.
+    virtual void reset(QubitIndex target, double sample);
+};
+
+/// Simulates a pure state and unravels noise channels into trajectories.
+class StateVectorSimulator : public Simulator {
+public:
+    explicit StateVectorSimulator(const StorageOptions &options = {})
+            : state(0, options)
+    {}
+
+    Backend getBackend() const override { return Backend::StateVector; }
+    std::size_t getNumQubits() const override { return state.getNumQubits(); }
+    virtual const StateVector &getState() { return state; }
+
+    void addQubits(std::size_t count) override { state.addQubits(count); }
+
+    void applyMatrix(const Matrix2 &m, QubitIndex target) override
+    {
+        state.applyMatrix(m, target);
+    }
+    void applyDiagonal(Amplitude d0, Amplitude d1, QubitIndex target) override
+    {
+        state.applyDiagonal(d0, d1, target);
+    }
+    void applyControlled(
+        const Matrix2 &m,
+        QubitIndex control,
+        QubitIndex target) override
+    {
+        state.applyControlled(m, control, target);
+    }
+    void applyDoublyControlled(
+        const Matrix2 &m,
+        QubitIndex control0,
+        QubitIndex control1,
+        QubitIndex target) override
+    {
+        state.applyDoublyControlled(m, control0, control1, target);
+    }
+    void swap(QubitIndex lhs, QubitIndex rhs) override { state.swap(lhs, rhs); }
+
+    double probabilityOfOne(QubitIndex target) override
+    {
+        return state.probabilityOfOne(target);
+    }
+    void collapse(QubitIndex target, bool outcome, double probability) override
+    {
+        state.collapse(target, outcome, probability);
+    }
+
+    void applyChannel(
+        const KrausChannel &channel,
+        QubitIndex target,
+        double sample) override;
+
+protected:
+    StateVector state;
+};
+
+/// Simulates a mixed state and applies noise channels exactly.
+///
+/// The n-qubit density matrix is stored as a 2n-qubit vector in which the
+/// low n bits of an index address the row and the high n bits the column.
+/// A unitary U on qubit q thus becomes U on bit q and conj(U) on bit q + n,
+/// so that all unitary gates reuse the state-vector kernels.
+class DensityMatrixSimulator : public Simulator {
+public:
+    DensityMatrixSimulator();
+
+    Backend getBackend() const override { return Backend::DensityMatrix; }
+    std::size_t getNumQubits() const override { return numQubits; }
+    std::size_t getStorageSize() const override { return rho.size(); }
+
+    /// Returns the element in row @p row and column @p column .
+    Amplitude getElement(std::size_t row, std::size_t column) const
+    {
+        return rho[row | (column << numQubits)];
+    }
+
+    void addQubits(std::size_t count) override;
+
+    void applyMatrix(const Matrix2 &m, QubitIndex target) override;
+    void applyDiagonal(Amplitude d0, Amplitude d1, QubitIndex target) override;
+    void applyControlled(
+        const Matrix2 &m,
+        QubitIndex control,
+        QubitIndex target) override;
+    void applyDoublyControlled(
+        const Matrix2 &m,
+        QubitIndex control0,
+        QubitIndex control1,
+        QubitIndex target) override;
+    void swap(QubitIndex lhs, QubitIndex rhs) override;
+
+    double probabilityOfOne(QubitIndex target) override;
+    void collapse(QubitIndex target, bool outcome, double probability) override;
+
+    void applyChannel(
+        const KrausChannel &channel,
+        QubitIndex target,
+        double sample) override;
+    void reset(QubitIndex target, double sample) override;
+
+private:
+    std::size_t numQubits;
+    std::vector<Amplitude> rho;
+};
+
+/// Creates an empty simulator of the given @p backend . State-vector
+/// simulators place their amplitudes according to @p storage , are
+/// distributed when the process belongs to a group of ranks, and otherwise
+/// use the out-of-core simulator for mapped or chunked storage.
+std::unique_ptr<Simulator>
+createSimulator(Backend backend, const StorageOptions &storage = {});
+
+} // namespace quantum::runtime
@@ -0,0 +1,162 @@
+/// Declares the state-vector kernels of the simulator runtime.
+///
+/// @file
+
+#pragma once
+
+#include "quantum-mlir/Runtime/Gates.h"
+#include "quantum-mlir/Runtime/Storage.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace quantum::runtime {
+
+/// Qubit index inside a register. Qubit 0 is the least significant bit of a
+/// basis state index.
+using QubitIndex = std::size_t;
+
+namespace kernels {
+
+/// Applies @p m to @p target of the @p numQubits qubit vector @p amps .
+void applyMatrix(
+    Amplitude* amps,
+    std::size_t numQubits,
+    const Matrix2 &m,
+    QubitIndex target);
+
+/// Applies diag(@p d0, @p d1) to @p target .
+void applyDiagonal(
+    Amplitude* amps,
+    std::size_t numQubits,
+    Amplitude d0,
+    Amplitude d1,
+    QubitIndex target);
+
+/// Applies @p m to @p target on the subspace where @p control is set.
+void applyControlled(
+    Amplitude* amps,
+    std::size_t numQubits,
+    const Matrix2 &m,
+    QubitIndex control,
+    QubitIndex target);
+
+/// Applies @p m to @p target on the subspace where both controls are set.
+void applyDoublyControlled(
+    Amplitude* amps,
+    std::size_t numQubits,
+    const Matrix2 &m,
+    QubitIndex control0,
+    QubitIndex control1,
+    QubitIndex target);
+
+/// Exchanges the states of @p lhs and @p rhs .
+void swap(
+    Amplitude* amps,
+    std::size_t numQubits,
+    QubitIndex lhs,
+    QubitIndex rhs);
+
+/// Returns the probability of measuring @p target in |1>.
+double probabilityOfOne(
+    const Amplitude* amps,
+    std::size_t numQubits,
+    QubitIndex target);
+
+/// Projects @p target onto @p outcome and rescales by 1/sqrt(@p probability).
+void collapse(
+    Amplitude* amps,
+    std::size_t numQubits,
+    QubitIndex target,
+    bool outcome,
+    double probability);
+
+/// Returns the squared norm of the vector obtained by applying @p m to
+/// @p target , without modifying @p amps .
+double normAfter(
+    const Amplitude* amps,
+    std::size_t numQubits,
+    const Matrix2 &m,
+    QubitIndex target);
+
+/// Multiplies every amplitude by @p factor .
+void scale(Amplitude* amps, std::size_t numQubits, double factor);
+
+/// Multiplies the amplitudes whose index contains all bits of @p mask by
+/// @p factor .
+void scaleWhere(
+    Amplitude* amps,
+    std::size_t numQubits,
+    std::size_t mask,
+    Amplitude factor);
+
+} // namespace kernels
+
+/// A pure quantum state of a growable qubit register.
+class StateVector {
+public:
+    /// Creates the state |0...0> on @p numQubits qubits, whose amplitudes
+    /// are placed according to @p options .
+    explicit StateVector(
+        std::size_t numQubits = 0,
+        const StorageOptions &options = {});
+
+    std::size_t getNumQubits() const { return numQubits; }
+    std::size_t size() const { return amplitudes.size(); }
+    Amplitude* data() { return amplitudes.data(); }
+    const Amplitude* data() const { return amplitudes.data(); }
+    Amplitude operator[](std::size_t index) const { return data()[index]; }
+
+    /// Resets the register to |0...0> on @p count qubits.
+    void reset(std::size_t count);
+    /// Tensors @p count fresh |0> qubits onto the most significant end.
+    void addQubits(std::size_t count);
+
+    void applyMatrix(const Matrix2 &m, QubitIndex target)
+    {
+        kernels::applyMatrix(data(), numQubits, m, target);
+    }
+    void applyDiagonal(Amplitude d0, Amplitude d1, QubitIndex target)
+    {
+        kernels::applyDiagonal(data(), numQubits, d0, d1, target);
+    }
+    void applyControlled(
+        const Matrix2 &m,
+        QubitIndex control,
+        QubitIndex target)
+    {
+        kernels::applyControlled(data(), numQubits, m, control, target);
+    }
+    void applyDoublyControlled(
+        const Matrix2 &m,
+        QubitIndex control0,
+        QubitIndex control1,
+        QubitIndex target)
+    {
+        kernels::applyDoublyControlled(
+            data(),
+            numQubits,
+            m,
+            control0,
+            control1,
+            target);
+    }
+    void swap(QubitIndex lhs, QubitIndex rhs)
+    {
+        kernels::swap(data(), numQubits, lhs, rhs);
+    }
+    double probabilityOfOne(QubitIndex target) const
+    {
+        return kernels::probabilityOfOne(data(), numQubits, target);
+    }
+    void collapse(QubitIndex target, bool outcome, double probability)
+    {
+        kernels::collapse(data(), numQubits, target, outcome, probability);
+    }
+
+private:
+    std::size_t numQubits;
+    AmplitudeStorage amplitudes;
+};
+
+} // namespace quantum::runtime
@@ -0,0 +1,74 @@
+/// Declares the amplitude storage of the simulator runtime.
+///
+/// @file
+
+#pragma once
+
+#include "quantum-mlir/Runtime/Gates.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace quantum::runtime {
+
+/// Selects where the amplitudes of a state vector live.
+enum class StorageKind {
+    /// Anonymous heap memory.
+    Memory,
+    /// A memory-mapped temporary file, which lets the kernel page amplitudes
+    /// out to disk once the state outgrows the physical memory.
+    MappedFile
+};
+
+/// Parses @p name into @p kind . Returns false if the name is unknown.
+bool parseStorageKind(std::string_view name, StorageKind &kind);
+
+/// Options for the storage of a state vector.
+struct StorageOptions {
+    StorageKind kind = StorageKind::Memory;
+    /// Directory of the backing file, defaults to $TMPDIR or /tmp.
+    std::string directory;
+    /// Number of low-order qubits that form one chunk of the out-of-core
+    /// simulator; 0 disables chunked execution for heap storage and selects
+    /// kDefaultChunkQubits for mapped storage.
+    unsigned chunkQubits = 0;
+};
+
+/// Default chunk size of mapped storage, i.e. 64 MiB of amplitudes.
+inline constexpr unsigned kDefaultChunkQubits = 22;
+
+/// A zero-initialised, resizable array of amplitudes.
+class AmplitudeStorage {
+public:
+    explicit AmplitudeStorage(const StorageOptions &options = {});
+    ~AmplitudeStorage();
+
+    AmplitudeStorage(const AmplitudeStorage &) = delete;
+    AmplitudeStorage &operator=(const AmplitudeStorage &) = delete;
+
+    StorageKind getKind() const { return kind; }
+    std::size_t size() const { return count; }
+    Amplitude* data() { return amplitudes; }
+    const Amplitude* data() const { return amplitudes; }
+
+    /// Replaces the contents by @p newCount zero amplitudes.
+    void assign(std::size_t newCount);
+    /// Grows or shrinks to @p newCount amplitudes, keeping the common prefix
+    /// and zero-initialising the remainder.
+    void resize(std::size_t newCount);
+
+private:
+    bool map(std::size_t newCount);
+    void unmap();
+
+    StorageKind kind;
+    std::string directory;
+    int fd = -1;
+    std::vector<Amplitude> heap;
+    Amplitude* amplitudes = nullptr;
+    std::size_t count = 0;
+};
+
+} // namespace quantum::runtime
@@ -0,0 +1,91 @@
+/// Declares the parallel trajectory engine of the simulator runtime.
+///
+/// @file
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace quantum::runtime {
+
+/// Maps measured bitstrings to the number of trajectories that produced them.
+///
+/// Character i of a key is the value of the result register with ID i.
+using Histogram = std::map<std::string, std::uint64_t>;
+
+/// A fixed set of worker threads that execute indexed tasks.
+///
+/// Tasks are claimed from a shared atomic counter, so workers that finish
+/// early pick up the remaining indices instead of idling.
+class ThreadPool {
+public:
+    /// Task callback invoked with the task index and the rank of the worker,
+    /// which is in [0, getNumThreads()).
+    using Task = std::function<void(std::size_t index, unsigned rank)>;
+
+    /// Starts @p threads workers, where 0 selects the hardware concurrency.
+    /// The calling thread participates as rank 0.
+    explicit ThreadPool(unsigned threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    unsigned getNumThreads() const { return workers.size() + 1; }
+
+    /// Runs @p task for every index in [0, count) and waits for completion.
+    void parallelFor(std::size_t count, const Task &task);
+
+private:
+    void work(unsigned rank);
+    void drain(unsigned rank);
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::condition_variable done;
+    /// Incremented for every parallelFor() call to release the workers.
+    std::uint64_t generation = 0;
+    unsigned busy = 0;
+    bool stopping = false;
+
+    const Task* task = nullptr;
+    std::size_t count = 0;
+    std::atomic<std::size_t> next = 0;
+};
+
+/// Executes @p kernel once per trajectory on @p threads worker threads, where
+/// 0 selects the hardware concurrency, and returns the histogram of the
+/// result registers.
+///
+/// Trajectory i runs on a fresh simulator with the options the calling
+/// thread was initialized with, and with random stream i, which is combined
+/// with the seed set by the kernel, so the histogram does not depend on the
+/// number of threads. Every worker counts into a private histogram;
+/// these are merged once all workers have finished.
+Histogram
+runTrajectories(void (*kernel)(), std::size_t count, unsigned threads = 0);
+
+/// Executes @p kernel once per shot like runTrajectories, and returns the
+/// first @p numResults result registers of every shot.
+///
+/// The buffer holds @p shots rows of @p numResults bytes, each 0 or 1. Every
+/// worker writes the row of its shot in place, so the results are neither
+/// formatted nor copied, and the buffer can be handed out as is, e.g. as a
+/// NumPy array.
+std::unique_ptr<std::uint8_t[]> runShots(
+    void (*kernel)(),
+    std::size_t shots,
+    std::size_t numResults,
+    unsigned threads = 0);
+
+} // namespace quantum::runtime
@@ -0,0 +1,24 @@
+/// Declares the conversion of structural forms to string map keys.
+///
+/// @file
+
+#pragma once
+
+#include "mlir/Support/LLVM.h"
+
+#include <cstdint>
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/StringRef.h>
+
+namespace mlir::quantum {
+
+/// Returns the words of @p form as a key of a string map, which compares
+/// and hashes them bytewise without a copy. The key refers to @p form .
+inline StringRef getStringKey(ArrayRef<std::uintptr_t> form)
+{
+    return StringRef(
+        reinterpret_cast<const char*>(form.data()),
+        form.size() * sizeof(std::uintptr_t));
+}
+
+} // namespace mlir::quantum
@@ -0,0 +1,45 @@
+//===- TargetQIR.h - QIR profile LLVM IR Translation ----------------------===//
+//
+// A translator that emits LLVM IR conforming to the QIR base and adaptive
+// profiles.
+///
+/// @file
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "mlir/IR/Operation.h"
+
+#include <string>
+
+namespace mlir {
+namespace qir {
+
+/// The QIR profiles that can be targeted.
+enum class QIRProfile {
+    /// Straight-line programs whose results are only recorded as output.
+    Base,
+    /// Additionally allows reading results and branching on them.
+    Adaptive,
+};
+
+/// Options of translateToQIRProfile.
+struct QIRProfileOptions {
+    QIRProfile profile = QIRProfile::Base;
+    /// The entry point, or empty to use the only public function.
+    std::string entryPoint;
+    /// Whether to emit bitcode instead of textual LLVM IR.
+    bool emitBitcode = false;
+};
+
+/// Lowers the quantum or qir dialect module @p op to LLVM IR with static
+/// qubit and result addressing, adds the entry-point attributes and module
+/// flags of the profile, and writes it to @p os .
+LogicalResult translateToQIRProfile(
+    Operation* op,
+    raw_ostream &os,
+    const QIRProfileOptions &options);
+
+void registerQIRProfileTranslations();
+} // namespace qir
+} // namespace mlir
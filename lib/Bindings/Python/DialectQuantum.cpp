@@ -0,0 +1,162 @@
+//===- DialectQuantum.cpp - Nanobind module for Quantum dialect API -------===//
+//
+// @file
+//===----------------------------------------------------------------------===//
+
+#include "mlir-c/IR.h"
+#include "mlir-c/Pass.h"
+#include "mlir-c/Support.h"
+#include "mlir/Bindings/Python/Diagnostics.h"
+#include "mlir/Bindings/Python/Nanobind.h"
+#include "mlir/Bindings/Python/NanobindAdaptors.h"
+#include "quantum-mlir-c/Conversion.h"
+#include "quantum-mlir-c/Dialect/Quantum.h"
+
+#include <cstdint>
+
+namespace nb = nanobind;
+
+using namespace nanobind::literals;
+
+using namespace llvm;
+using namespace mlir;
+using namespace mlir::python;
+using namespace mlir::python::nanobind_adaptors;
+
+/// Runs the pass made by @p create on @p module in place, without going
+/// through a textual pass pipeline.
+static void runPass(MlirModule module, MlirPass (*create)())
+{
+    MlirContext context = mlirModuleGetContext(module);
+    CollectDiagnosticsToStringScope scope(context);
+    MlirPassManager pm = mlirPassManagerCreate(context);
+    mlirPassManagerAddOwnedPass(pm, create());
+    const MlirLogicalResult result =
+        mlirPassManagerRunOnOp(pm, mlirModuleGetOperation(module));
+    mlirPassManagerDestroy(pm);
+    if (mlirLogicalResultIsFailure(result))
+        throw nb::value_error(scope.takeMessage().c_str());
+}
+
+/// Binds @p name in @p m to run the pass made by @p create on a module.
+static void definePass(
+    nb::module_ &m,
+    const char* name,
+    MlirPass (*create)(),
+    const char* doc)
+{
+    m.def(
+        name,
+        [create](MlirModule module) { runPass(module, create); },
+        nb::arg("module"),
+        doc);
+}
+
+static void populateDialectQuantumSubmodule(nb::module_ m)
+{
+    //===--------------------------------------------------------------------===//
+    // Quantum dialect registration
+    //===--------------------------------------------------------------------===//
+    auto quantum = m.def_submodule("quantum");
+
+    quantum.def(
+        "register_dialect",
+        [](MlirContext context, bool load) {
+            MlirDialectHandle handle = mlirGetDialectHandle__quantum__();
+            mlirDialectHandleRegisterDialect(handle, context);
+            if (load) mlirDialectHandleLoadDialect(handle, context);
+        },
+        nb::arg("context").none() = nb::none(),
+        nb::arg("load") = true);
+
+    //===--------------------------------------------------------------------===//
+    // Passes
+    //===--------------------------------------------------------------------===//
+    quantum.def(
+        "register_passes",
+        [] {
+            mlirRegisterQuantumPasses();
+            mlirRegisterConversionPasses();
+        },
+        "Registers the quantum passes and conversions for textual pipelines.");
+
+    definePass(
+        quantum,
+        "optimise",
+        mlirCreateQuantumQuantumOptimise,
+        "Runs quantum-optimise on `module`.");
+    definePass(
+        quantum,
+        "hermitian_cancel",
+        mlirCreateQuantumHermitianCancel,
+        "Runs hermitian-cancel on `module`.");
+    definePass(
+        quantum,
+        "peephole",
+        mlirCreateQuantumQuantumPeephole,
+        "Runs quantum-peephole on `module`.");
+    definePass(
+        quantum,
+        "schedule",
+        mlirCreateQuantumQuantumSchedule,
+        "Runs quantum-schedule on `module`.");
+    definePass(
+        quantum,
+        "defer_measurement",
+        mlirCreateQuantumQuantumDeferMeasurement,
+        "Runs quantum-defer-measurement on `module`.");
+    definePass(
+        quantum,
+        "rotate_loops",
+        mlirCreateQuantumQuantumRotateLoops,
+        "Runs quantum-rotate-loops on `module`.");
+    definePass(
+        quantum,
+        "multi_qubit_legalize",
+        mlirCreateQuantumMultiQubitLegalization,
+        "Runs quantum-multi-qubit-legalize on `module`.");
+    definePass(
+        quantum,
+        "convert_quantum_to_qir",
+        mlirCreateConversionConvertQuantumToQIR,
+        "Runs convert-quantum-to-qir on `module`.");
+    definePass(
+        quantum,
+        "convert_qir_to_llvm",
+        mlirCreateConversionConvertQIRToLLVM,
+        "Runs convert-qir-to-llvm on `module`.");
+    definePass(
+        quantum,
+        "lift_qir_to_quantum",
+        mlirCreateConversionConvertQIRToQuantum,
+        "Runs lift-qir-to-quantum on `module`.");
+
+    //===--------------------------------------------------------------------===//
+    // QubitType
+    //===--------------------------------------------------------------------===//
+    auto qubitType =
+        mlir_type_subclass(m, "QubitType", mlirTypeIsAQuantumQubitType);
+
+    qubitType.def_classmethod(
+        "get",
+        [](nb::object cls, std::int64_t size, MlirContext context) {
+            CollectDiagnosticsToStringScope scope(context);
+            MlirType type = mlirQuantumQubitTypeGet(context, size);
+            if (mlirTypeIsNull(type))
+                throw nb::value_error(scope.takeMessage().c_str());
+            return cls(type);
+        },
+        nb::arg("cls"),
+        nb::arg("size") = 1,
+        nb::arg("context").none() = nb::none());
+    qubitType.def_property_readonly("size", [](MlirType type) {
+        return mlirQuantumQubitTypeGetSize(type);
+    });
+}
+
+NB_MODULE(_mlirDialectsQuantum, m)
+{
+    m.doc() = "Quantum dialect.";
+
+    populateDialectQuantumSubmodule(m);
+}
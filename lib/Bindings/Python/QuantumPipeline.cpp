@@ -0,0 +1,144 @@
+//===- QuantumPipeline.cpp - Nanobind module for the lowering pipeline ----===//
+//
+// @file
+//===----------------------------------------------------------------------===//
+
+#include "mlir-c/IR.h"
+#include "mlir-c/Support.h"
+#include "mlir/Bindings/Python/Diagnostics.h"
+#include "mlir/Bindings/Python/Nanobind.h"
+#include "mlir/Bindings/Python/NanobindAdaptors.h"
+#include "quantum-mlir-c/Pipeline.h"
+#include "quantum-mlir/Runtime/QIR.h"
+#include "quantum-mlir/Runtime/Trajectories.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <dlfcn.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/optional.h>
+#include <nanobind/stl/string.h>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace nb = nanobind;
+
+using namespace nanobind::literals;
+
+using namespace mlir;
+using namespace mlir::python;
+
+namespace {
+
+/// The shot results, one row of result registers per shot.
+using ShotArray = nb::ndarray<nb::numpy, std::uint8_t, nb::ndim<2>>;
+
+} // namespace
+
+NB_MODULE(_mlirQuantumPipeline, m)
+{
+    m.doc() = "Lowering pipeline with an on-disk artifact cache.";
+
+    const MlirStringRef defaultPipeline =
+        mlirQuantumGetDefaultLoweringPipeline();
+    m.attr("DEFAULT_LOWERING_PIPELINE") =
+        std::string(defaultPipeline.data, defaultPipeline.length);
+
+    m.def(
+        "compile_module",
+        [](MlirModule module,
+           const std::string &pipeline,
+           const std::string &emit,
+           const std::optional<std::string> &cacheDir,
+           std::uint64_t cacheSize) {
+            MlirQuantumArtifactKind kind;
+            if (emit == "llvm")
+                kind = MlirQuantumArtifactLLVMDialect;
+            else if (emit == "obj")
+                kind = MlirQuantumArtifactObject;
+            else
+                throw nb::value_error("emit must be 'llvm' or 'obj'");
+
+            CollectDiagnosticsToStringScope scope(
+                mlirModuleGetContext(module));
+            std::string data;
+            bool cached = false;
+            const MlirLogicalResult result = mlirQuantumCompileModule(
+                module,
+                mlirStringRefCreate(pipeline.data(), pipeline.size()),
+                kind,
+                cacheDir
+                    ? mlirStringRefCreate(cacheDir->data(), cacheDir->size())
+                    : mlirStringRefCreate(nullptr, 0),
+                cacheSize,
+                [](MlirStringRef str, void* userData) {
+                    static_cast<std::string*>(userData)->append(
+                        str.data,
+                        str.length);
+                },
+                &data,
+                &cached);
+            if (mlirLogicalResultIsFailure(result))
+                throw nb::value_error(scope.takeMessage().c_str());
+            return nb::make_tuple(nb::bytes(data.data(), data.size()), cached);
+        },
+        nb::arg("module"),
+        nb::arg("pipeline") =
+            std::string(defaultPipeline.data, defaultPipeline.length),
+        nb::arg("emit") = "llvm",
+        nb::arg("cache_dir").none() = nb::none(),
+        nb::arg("cache_size") = std::uint64_t(1) << 30,
+        "Lowers `module` in place by `pipeline` and returns the artifact as "
+        "bytes together with whether it was taken from the cache in "
+        "`cache_dir`. On a hit, `module` is left untouched.");
+
+    m.def(
+        "runtime_library",
+        [] {
+            // The runtime is loaded as a dependency of this extension, so the
+            // kernels must resolve their calls against this very file to
+            // share the state of the shots.
+            Dl_info info;
+            if (!dladdr(
+                    reinterpret_cast<void*>(&__quantum__rt__initialize),
+                    &info)
+                || !info.dli_fname)
+                throw std::runtime_error("cannot locate the quantum runtime");
+            return std::string(info.dli_fname);
+        },
+        "Returns the path of the simulator runtime used by `run_shots`, to be "
+        "passed to the execution engine of the kernel.");
+
+    m.def(
+        "run_shots",
+        [](std::uintptr_t kernel,
+           std::size_t shots,
+           std::size_t numResults,
+           unsigned threads) {
+            if (!kernel) throw nb::value_error("kernel must not be null");
+            std::uint8_t* data;
+            {
+                nb::gil_scoped_release release;
+                data = quantum::runtime::runShots(
+                           reinterpret_cast<void (*)()>(kernel),
+                           shots,
+                           numResults,
+                           threads)
+                           .release();
+            }
+            // The array takes over the buffer the workers wrote to.
+            nb::capsule owner(data, [](void* ptr) noexcept {
+                delete[] static_cast<std::uint8_t*>(ptr);
+            });
+            return ShotArray(data, {shots, numResults}, owner);
+        },
+        nb::arg("kernel"),
+        nb::arg("shots"),
+        nb::arg("num_results"),
+        nb::arg("threads") = 0,
+        "Runs the kernel without arguments at the address `kernel` once per "
+        "shot on `threads` threads, and returns a uint8 array of shape "
+        "(shots, num_results) with the result registers of every shot. The "
+        "array owns the buffer of the runtime, so no results are copied.");
+}
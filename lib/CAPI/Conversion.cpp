@@ -0,0 +1,14 @@
+//===- Conversion.cpp - C Interface for the conversions -------------------===//
+//
+// @file
+//===----------------------------------------------------------------------===//
+
+#include "quantum-mlir-c/Conversion.h"
+
+#include "mlir/CAPI/Pass.h"
+#include "quantum-mlir/Conversion/Passes.h"
+
+using namespace mlir;
+using namespace mlir::quantum;
+
+#include "quantum-mlir/Conversion/Passes.capi.cpp.inc"
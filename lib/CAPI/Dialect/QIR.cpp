@@ -6,8 +6,10 @@
 #include "quantum-mlir-c/Dialect/QIR.h"
 
 #include "mlir-c/IR.h"
+#include "mlir/CAPI/Pass.h"
 #include "mlir/CAPI/Registration.h"
 #include "quantum-mlir/Dialect/QIR/IR/QIRTypes.h"
+#include "quantum-mlir/Dialect/QIR/Transforms/Passes.h"
 
 using namespace mlir;
 using namespace mlir::qir;
@@ -41,3 +43,9 @@ MlirType mlirResultTypeGet(MlirContext ctx)
 {
     return wrap(ResultType::get(unwrap(ctx)));
 }
+
+//===---------------------------------------------------------------------===//
+// Passes
+//===---------------------------------------------------------------------===//
+
+#include "quantum-mlir/Dialect/QIR/Transforms/Passes.capi.cpp.inc"
@@ -0,0 +1,45 @@
+//===- Quantum.cpp - C Interface for Quantum dialect ----------------------===//
+//
+// @file
+//===----------------------------------------------------------------------===//
+
+#include "quantum-mlir-c/Dialect/Quantum.h"
+
+#include "mlir-c/IR.h"
+#include "mlir/CAPI/Pass.h"
+#include "mlir/CAPI/Registration.h"
+#include "quantum-mlir/Dialect/Quantum/IR/Quantum.h"
+#include "quantum-mlir/Dialect/Quantum/Transforms/Passes.h"
+
+using namespace mlir;
+using namespace mlir::quantum;
+
+MLIR_DEFINE_CAPI_DIALECT_REGISTRATION(Quantum, quantum, QuantumDialect)
+
+//===---------------------------------------------------------------------===//
+// QubitType
+//===---------------------------------------------------------------------===//
+
+bool mlirTypeIsAQuantumQubitType(MlirType type)
+{
+    return isa<QubitType>(unwrap(type));
+}
+
+MlirType mlirQuantumQubitTypeGet(MlirContext ctx, int64_t size)
+{
+    return wrap(QubitType::getChecked(
+        [&] { return emitError(UnknownLoc::get(unwrap(ctx))); },
+        unwrap(ctx),
+        size));
+}
+
+int64_t mlirQuantumQubitTypeGetSize(MlirType type)
+{
+    return cast<QubitType>(unwrap(type)).getSize();
+}
+
+//===---------------------------------------------------------------------===//
+// Passes
+//===---------------------------------------------------------------------===//
+
+#include "quantum-mlir/Dialect/Quantum/Transforms/Passes.capi.cpp.inc"
@@ -0,0 +1,44 @@
+//===- Pipeline.cpp - C Interface for the lowering pipeline ---------------===//
+//
+// @file
+//===----------------------------------------------------------------------===//
+
+#include "quantum-mlir-c/Pipeline.h"
+
+#include "mlir/CAPI/IR.h"
+#include "mlir/CAPI/Support.h"
+#include "quantum-mlir/Pipeline/Compile.h"
+
+#include <optional>
+
+using namespace mlir;
+using namespace mlir::quantum;
+
+MlirStringRef mlirQuantumGetDefaultLoweringPipeline()
+{
+    return wrap(StringRef(kDefaultLoweringPipeline));
+}
+
+MlirLogicalResult mlirQuantumCompileModule(
+    MlirModule module,
+    MlirStringRef pipeline,
+    MlirQuantumArtifactKind kind,
+    MlirStringRef cacheDir,
+    uint64_t cacheBytes,
+    MlirStringCallback callback,
+    void* userData,
+    bool* cached)
+{
+    std::optional<ArtifactCache> cache;
+    if (cacheDir.length != 0) cache.emplace(unwrap(cacheDir), cacheBytes);
+    auto artifact = compileModule(
+        unwrap(module),
+        unwrap(pipeline),
+        kind == MlirQuantumArtifactObject ? ArtifactKind::Object
+                                          : ArtifactKind::LLVMDialect,
+        cache ? &*cache : nullptr);
+    if (failed(artifact)) return mlirLogicalResultFailure();
+    if (cached) *cached = artifact->cached;
+    callback(wrap(StringRef(artifact->data)), userData);
+    return mlirLogicalResultSuccess();
+}
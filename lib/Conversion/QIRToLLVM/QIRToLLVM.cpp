@@ -13,12 +13,17 @@
 #include "mlir/Dialect/LLVMIR/LLVMDialect.h"
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/PatternMatch.h"
+#include "mlir/IR/Threading.h"
+#include "mlir/Interfaces/FunctionInterfaces.h"
 #include "mlir/Pass/AnalysisManager.h"
 #include "mlir/Pass/Pass.h"
 #include "mlir/Transforms/DialectConversion.h"
 #include "quantum-mlir/Dialect/QIR/IR/QIR.h"
 #include "quantum-mlir/Dialect/QIR/IR/QIROps.h"
 
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
+
 #include <cstdint>
 #include <mlir/Dialect/Tensor/IR/Tensor.h>
 #include <mlir/IR/BuiltinTypes.h>
@@ -37,49 +42,94 @@ namespace mlir {
 } // namespace mlir
 //===----------------------------------------------------------------------===//
 
+/// Assigns module-wide IDs to the qubit and result allocations in walk order.
+///
+/// Every top-level op is numbered concurrently, and its IDs are offset by the
+/// allocations of the preceding ops, which yields the same numbering as a
+/// sequential walk. The lookups are read-only and may run concurrently.
 struct mlir::qir::AllocationAnalysis {
 
     AllocationAnalysis(Operation* op)
     {
-        int64_t allocOpId = 0;
-        int64_t allocResultOpId = 0;
-
-        // Walk through all operations in the module and find AllocOp
-        op->walk([&](AllocOp allocOp) { allocMapping[allocOp] = allocOpId++; });
-
-        // Walk through all operations in the module and find AllocResultOp
-        op->walk([&](AllocResultOp allocResultOp) {
-            resultMapping[allocResultOp] = allocResultOpId++;
+        // The ops of a single block are numbered separately, everything else
+        // as a whole.
+        SmallVector<Operation*> roots;
+        if (op->getNumRegions() == 1 && op->getRegion(0).hasOneBlock()) {
+            for (Operation &child : op->getRegion(0).front())
+                roots.push_back(&child);
+        } else {
+            roots.push_back(op);
+        }
+
+        units.resize(roots.size());
+        parallelFor(op->getContext(), 0, roots.size(), [&](std::size_t i) {
+            Unit &unit = units[i];
+            roots[i]->walk([&](Operation* nested) {
+                if (auto allocOp = dyn_cast<AllocOp>(nested)) {
+                    const int64_t id = unit.qubits.size();
+                    unit.qubits[allocOp] = id;
+                } else if (auto resultOp = dyn_cast<AllocResultOp>(nested)) {
+                    const int64_t id = unit.results.size();
+                    unit.results[resultOp] = id;
+                }
+            });
         });
+
+        for (auto [index, root] : llvm::enumerate(roots)) {
+            Unit &unit = units[index];
+            unit.qubitOffset = qubitCount;
+            unit.resultOffset = resultCount;
+            qubitCount += unit.qubits.size();
+            resultCount += unit.results.size();
+            unitIndex[root] = index;
+        }
     }
 
     // ensure that the counts are non-zero if there are any allocations
-    bool verify() const
-    {
-        return (getQubitCount() >= 0) && (getResultCount() >= 0);
-    }
+    bool verify() const { return (qubitCount >= 0) && (resultCount >= 0); }
 
-    int64_t getQubitCount() const { return allocMapping.size(); }
-    int64_t getResultCount() const { return resultMapping.size(); }
+    int64_t getQubitCount() const { return qubitCount; }
+    int64_t getResultCount() const { return resultCount; }
 
     int64_t getQubitId(AllocOp allocOp) const
     {
-        auto it = allocMapping.find(allocOp);
-        assert(it != allocMapping.end() && "AllocOp not found in mapping!");
-        return it->second;
+        const Unit &unit = getUnit(allocOp);
+        auto it = unit.qubits.find(allocOp);
+        assert(it != unit.qubits.end() && "AllocOp not found in mapping!");
+        return unit.qubitOffset + it->second;
     }
 
     int64_t getResultId(AllocResultOp allocResultOp) const
     {
-        auto it = resultMapping.find(allocResultOp);
+        const Unit &unit = getUnit(allocResultOp);
+        auto it = unit.results.find(allocResultOp);
         assert(
-            it != resultMapping.end() && "AllocResultOp not found in mapping!");
-        return it->second;
+            it != unit.results.end() && "AllocResultOp not found in mapping!");
+        return unit.resultOffset + it->second;
     }
 
 private:
-    llvm::DenseMap<AllocOp, int64_t> allocMapping;
-    llvm::DenseMap<AllocResultOp, int64_t> resultMapping;
+    /// The allocations of one top-level op, numbered from zero.
+    struct Unit {
+        llvm::DenseMap<AllocOp, int64_t> qubits;
+        llvm::DenseMap<AllocResultOp, int64_t> results;
+        int64_t qubitOffset = 0;
+        int64_t resultOffset = 0;
+    };
+
+    const Unit &getUnit(Operation* op) const
+    {
+        while (!unitIndex.contains(op)) {
+            op = op->getParentOp();
+            assert(op && "allocation outside of the analyzed op");
+        }
+        return units[unitIndex.lookup(op)];
+    }
+
+    SmallVector<Unit> units;
+    llvm::DenseMap<Operation*, std::size_t> unitIndex;
+    int64_t qubitCount = 0;
+    int64_t resultCount = 0;
 };
 
 namespace {
@@ -117,9 +167,45 @@ LLVM::LLVMFuncOp ensureFunctionDeclaration(
     return cast<LLVM::LLVMFuncOp>(fnDecl);
 };
 
+/// Returns the address of the null-terminated string constant @p value ,
+/// which is stored in the module global @p symbol .
+Value ensureGlobalString(
+    PatternRewriter &rewriter,
+    Operation* op,
+    StringRef symbol,
+    StringRef value)
+{
+    ModuleOp mod = op->getParentOfType<ModuleOp>();
+    auto global = mod.lookupSymbol<LLVM::GlobalOp>(symbol);
+
+    if (!global) {
+        PatternRewriter::InsertionGuard insertGuard(rewriter);
+        rewriter.setInsertionPointToStart(mod.getBody());
+
+        std::string data = value.str();
+        data.push_back('\0');
+        auto type =
+            LLVM::LLVMArrayType::get(rewriter.getI8Type(), data.size());
+        global = rewriter.create<LLVM::GlobalOp>(
+            op->getLoc(),
+            type,
+            /*isConstant=*/true,
+            LLVM::Linkage::Internal,
+            symbol,
+            rewriter.getStringAttr(data));
+    }
+
+    return rewriter.create<LLVM::AddressOfOp>(op->getLoc(), global);
+}
+
 struct InitOpPattern : public ConvertOpToLLVMPattern<InitOp> {
     using ConvertOpToLLVMPattern<InitOp>::ConvertOpToLLVMPattern;
 
+    InitOpPattern(LLVMTypeConverter &typeConverter, StringRef runtimeConfig)
+            : ConvertOpToLLVMPattern(typeConverter),
+              runtimeConfig(runtimeConfig)
+    {}
+
     LogicalResult matchAndRewrite(
         InitOp op,
         InitOpAdaptor adaptor,
@@ -128,9 +214,17 @@ struct InitOpPattern : public ConvertOpToLLVMPattern<InitOp> {
         Location loc = op.getLoc();
         MLIRContext* ctx = op.getContext();
 
-        // Create null pointer for initialize call
+        // Pass the runtime options, or a null pointer if there are none
         Type ptrType = LLVM::LLVMPointerType::get(ctx);
-        Value nullPtr = rewriter.create<LLVM::ZeroOp>(loc, ptrType);
+        Value configPtr;
+        if (runtimeConfig.empty())
+            configPtr = rewriter.create<LLVM::ZeroOp>(loc, ptrType);
+        else
+            configPtr = ensureGlobalString(
+                rewriter,
+                op,
+                "__quantum__rt__config",
+                runtimeConfig);
 
         // Define QIR initialization function
         StringRef fnName = "__quantum__rt__initialize";
@@ -147,11 +241,14 @@ struct InitOpPattern : public ConvertOpToLLVMPattern<InitOp> {
             loc,
             TypeRange{},
             fnDecl.getSymName(),
-            ValueRange{nullPtr});
+            ValueRange{configPtr});
 
         rewriter.eraseOp(op);
         return success();
     }
+
+private:
+    std::string runtimeConfig;
 };
 
 struct SeedOpPattern : public ConvertOpToLLVMPattern<SeedOp> {
@@ -164,13 +261,20 @@ struct SeedOpPattern : public ConvertOpToLLVMPattern<SeedOp> {
     {
         Location loc = op.getLoc();
         Value seedArg = adaptor.getSeed();
+        Value streamArg = adaptor.getStream();
+        Type voidType = LLVM::LLVMVoidType::get(op.getContext());
 
-        // Define RNG seed function
+        // Seeding a stream restarts the counter-based generator of the
+        // runtime at the beginning of that stream.
+        SmallVector<Value> args{seedArg};
         StringRef fnName = "set_rng_seed";
-        Type voidType = LLVM::LLVMVoidType::get(op.getContext());
+        if (streamArg) {
+            fnName = "__quantum__rt__set_rng_stream";
+            args.push_back(streamArg);
+        }
         auto fnType = LLVM::LLVMFunctionType::get(
             voidType,
-            {rewriter.getI64Type()},
+            SmallVector<Type>(args.size(), rewriter.getI64Type()),
             /*isVarArg=*/false);
 
         LLVM::LLVMFuncOp fnDecl =
@@ -180,7 +284,7 @@ struct SeedOpPattern : public ConvertOpToLLVMPattern<SeedOp> {
             loc,
             TypeRange{},
             fnDecl.getSymName(),
-            ValueRange{seedArg});
+            args);
 
         rewriter.eraseOp(op);
         return success();
@@ -985,6 +1089,213 @@ struct ResetOpPattern : public ConvertOpToLLVMPattern<ResetOp> {
     }
 };
 
+FloatAttr getNoiseParameter(DepolarizingOp op)
+{
+    return op.getProbabilityAttr();
+}
+FloatAttr getNoiseParameter(AmplitudeDampingOp op) { return op.getGammaAttr(); }
+FloatAttr getNoiseParameter(ReadoutErrorOp op)
+{
+    return op.getProbabilityAttr();
+}
+
+/// Lowers a noise channel to a runtime call that takes the channel parameter
+/// followed by the qubit or result it acts on.
+template<typename OpTy>
+struct NoiseOpLowering : public ConvertOpToLLVMPattern<OpTy> {
+    /// qirName must be exactly the __quantum__qis__XXX__body symbol for OpTy.
+    NoiseOpLowering(LLVMTypeConverter &tc, StringRef qirName)
+            : ConvertOpToLLVMPattern<OpTy>(tc),
+              qirName(qirName)
+    {}
+
+    LogicalResult matchAndRewrite(
+        OpTy op,
+        typename OpTy::Adaptor adaptor,
+        ConversionPatternRewriter &rewriter) const override
+    {
+        Location loc = op.getLoc();
+        MLIRContext* ctx = op.getContext();
+
+        // build the (f64, ptr) -> void function type
+        Type f64Type = rewriter.getF64Type();
+        Type ptrType = LLVM::LLVMPointerType::get(ctx);
+        auto fnType = LLVM::LLVMFunctionType::get(
+            LLVM::LLVMVoidType::get(ctx),
+            {f64Type, ptrType},
+            /*isVarArg=*/false);
+        auto fnDecl = ensureFunctionDeclaration(rewriter, op, qirName, fnType);
+
+        Value parameter = rewriter.create<LLVM::ConstantOp>(
+            loc,
+            f64Type,
+            getNoiseParameter(op));
+
+        rewriter.replaceOpWithNewOp<LLVM::CallOp>(
+            op,
+            TypeRange{},
+            fnDecl.getSymName(),
+            ValueRange{parameter, adaptor.getOperands()[0]});
+        return success();
+    }
+
+private:
+    StringRef qirName;
+};
+
+/// Returns the source position of @p loc as `file:line:col`, or an empty
+/// string if it has none.
+std::string getSiteName(Location loc)
+{
+    if (auto fileLoc = dyn_cast<FileLineColLoc>(loc))
+        return (fileLoc.getFilename().getValue() + ":"
+                + Twine(fileLoc.getLine()) + ":" + Twine(fileLoc.getColumn()))
+            .str();
+    if (auto nameLoc = dyn_cast<NameLoc>(loc))
+        return getSiteName(nameLoc.getChildLoc());
+    if (auto callLoc = dyn_cast<CallSiteLoc>(loc))
+        return getSiteName(callLoc.getCallee());
+    if (auto fusedLoc = dyn_cast<FusedLoc>(loc)) {
+        for (Location inner : fusedLoc.getLocations()) {
+            std::string name = getSiteName(inner);
+            if (!name.empty()) return name;
+        }
+    }
+    return {};
+}
+
+/// Precedes every gate, measurement and channel call in @p root with a call
+/// to `__quantum__rt__set_site`, so that the runtime attributes it to the
+/// source location of the op it was lowered from.
+///
+/// Every distinct location is stored once as the string constant
+/// `__quantum__site_<id>`, whose address identifies the site at runtime.
+/// Calls without a location clear the site.
+void attachSiteIds(Operation* root)
+{
+    SmallVector<LLVM::CallOp> calls;
+    root->walk([&](LLVM::CallOp call) {
+        const std::optional<StringRef> callee = call.getCallee();
+        if (callee && callee->starts_with("__quantum__qis__")
+            && *callee != "__quantum__qis__read_result__body")
+            calls.push_back(call);
+    });
+    if (calls.empty()) return;
+
+    // Declarations and constants live in the module, as for the patterns.
+    auto module = dyn_cast<ModuleOp>(root);
+    if (!module) module = root->getParentOfType<ModuleOp>();
+    if (!module) return;
+    MLIRContext* ctx = root->getContext();
+    Type ptrType = LLVM::LLVMPointerType::get(ctx);
+    OpBuilder globals = OpBuilder::atBlockBegin(module.getBody());
+    StringRef fnName = "__quantum__rt__set_site";
+    if (!module.lookupSymbol(fnName)) {
+        globals.create<LLVM::LLVMFuncOp>(
+            module.getLoc(),
+            fnName,
+            LLVM::LLVMFunctionType::get(
+                LLVM::LLVMVoidType::get(ctx),
+                {ptrType},
+                /*isVarArg=*/false));
+    }
+
+    llvm::StringMap<LLVM::GlobalOp> sites;
+    OpBuilder builder(ctx);
+    for (LLVM::CallOp call : calls) {
+        const Location loc = call.getLoc();
+        builder.setInsertionPoint(call);
+
+        Value site;
+        const std::string name = getSiteName(loc);
+        if (name.empty()) {
+            site = builder.create<LLVM::ZeroOp>(loc, ptrType);
+        } else {
+            LLVM::GlobalOp &global = sites[name];
+            if (!global) {
+                std::string data = name;
+                data.push_back('\0');
+                global = globals.create<LLVM::GlobalOp>(
+                    loc,
+                    LLVM::LLVMArrayType::get(globals.getI8Type(), data.size()),
+                    /*isConstant=*/true,
+                    LLVM::Linkage::Internal,
+                    "__quantum__site_" + std::to_string(sites.size() - 1),
+                    globals.getStringAttr(data));
+            }
+            site = builder.create<LLVM::AddressOfOp>(loc, global);
+        }
+        builder.create<LLVM::CallOp>(
+            loc,
+            TypeRange{},
+            fnName,
+            ValueRange{site});
+    }
+}
+
+/// Applies @p patterns to the functions of @p root concurrently, and then to
+/// the remaining ops.
+///
+/// The patterns declare runtime functions and constants in the nearest
+/// module, so every function is converted inside a private module. The
+/// symbols declared there are merged into @p root in function order
+/// afterwards, which keeps the result independent of the thread count.
+LogicalResult convertConcurrently(
+    Operation* root,
+    const ConversionTarget &target,
+    const FrozenRewritePatternSet &patterns)
+{
+    auto module = dyn_cast<ModuleOp>(root);
+    if (!module) return applyPartialConversion(root, target, patterns);
+
+    Block* body = module.getBody();
+    SmallVector<Operation*> order, functions, others;
+    for (Operation &op : *body) {
+        order.push_back(&op);
+        auto fn = dyn_cast<FunctionOpInterface>(op);
+        if (fn && !fn.isExternal())
+            functions.push_back(&op);
+        else
+            others.push_back(&op);
+    }
+    if (functions.empty())
+        return applyPartialConversion(root, target, patterns);
+
+    SmallVector<OwningOpRef<ModuleOp>> scopes;
+    for (Operation* fn : functions) {
+        scopes.push_back(ModuleOp::create(fn->getLoc()));
+        Block* scope = scopes.back()->getBody();
+        fn->moveBefore(scope, scope->end());
+    }
+
+    const LogicalResult converted = failableParallelForEach(
+        root->getContext(),
+        functions,
+        [&](Operation* fn) {
+            return applyPartialConversion(fn, target, patterns);
+        });
+
+    // Restore the original order, and declare the symbols of the functions
+    // before it unless they exist already.
+    for (Operation* op : order) op->moveBefore(body, body->end());
+    llvm::StringSet<> names;
+    for (Operation &op : *body)
+        if (auto symbol = dyn_cast<SymbolOpInterface>(op))
+            names.insert(symbol.getName());
+    for (OwningOpRef<ModuleOp> &scope : scopes) {
+        for (Operation &op : llvm::make_early_inc_range(*scope->getBody())) {
+            auto symbol = dyn_cast<SymbolOpInterface>(op);
+            if (symbol && !names.insert(symbol.getName()).second)
+                op.erase();
+            else
+                op.moveBefore(order.front());
+        }
+    }
+
+    if (failed(converted)) return failure();
+    return applyPartialConversion(others, target, patterns);
+}
+
 } // namespace
 
 void ConvertQIRToLLVMPass::runOnOperation()
@@ -1008,17 +1319,35 @@ void ConvertQIRToLLVMPass::runOnOperation()
     ConversionTarget target(getContext());
     RewritePatternSet patterns(&getContext());
 
-    qir::populateConvertQIRToLLVMPatterns(typeConverter, patterns, analysis);
+    qir::populateConvertQIRToLLVMPatterns(
+        typeConverter,
+        patterns,
+        analysis,
+        runtimeConfig);
 
     target.addIllegalDialect<qir::QIRDialect>();
     target.addLegalDialect<LLVM::LLVMDialect>();
     target.addLegalDialect<tensor::TensorDialect>();
 
-    if (failed(applyPartialConversion(
-            getOperation(),
-            target,
-            std::move(patterns))))
-        signalPassFailure();
+    // Functions are independent, so they are converted concurrently.
+    const FrozenRewritePatternSet frozenPatterns(std::move(patterns));
+    if (failed(convertConcurrently(getOperation(), target, frozenPatterns)))
+        return signalPassFailure();
+
+    if (siteIds) attachSiteIds(getOperation());
+
+    // Qubits and results are addressed statically, so their counts are the
+    // sizes of the registers of the lowered program. Hosts that execute the
+    // module read them to size the buffers of the results.
+    if (auto module = dyn_cast<ModuleOp>(getOperation())) {
+        Builder builder(&getContext());
+        module->setAttr(
+            "qir.required_num_qubits",
+            builder.getI64IntegerAttr(analysis.getQubitCount()));
+        module->setAttr(
+            "qir.required_num_results",
+            builder.getI64IntegerAttr(analysis.getResultCount()));
+    }
 }
 
 //===----------------------------------------------------------------------===//
@@ -1028,12 +1357,13 @@ void ConvertQIRToLLVMPass::runOnOperation()
 void mlir::qir::populateConvertQIRToLLVMPatterns(
     LLVMTypeConverter &typeConverter,
     RewritePatternSet &patterns,
-    AllocationAnalysis &analysis)
+    AllocationAnalysis &analysis,
+    StringRef runtimeConfig)
 {
     patterns.add<AllocOpPattern, AllocResultOpPattern>(typeConverter, analysis);
+    patterns.add<InitOpPattern>(typeConverter, runtimeConfig);
 
     patterns.add<
-        InitOpPattern,
         SeedOpPattern,
         HOpPattern,
         XOpPattern,
@@ -1064,6 +1394,16 @@ void mlir::qir::populateConvertQIRToLLVMPatterns(
     patterns.add<COpPattern<SwapOp>>(
         typeConverter,
         "__quantum__qis__swap__body");
+
+    patterns.add<NoiseOpLowering<DepolarizingOp>>(
+        typeConverter,
+        "__quantum__qis__depolarizing__body");
+    patterns.add<NoiseOpLowering<AmplitudeDampingOp>>(
+        typeConverter,
+        "__quantum__qis__amplitude_damping__body");
+    patterns.add<NoiseOpLowering<ReadoutErrorOp>>(
+        typeConverter,
+        "__quantum__qis__readout_error__body");
 }
 
 std::unique_ptr<Pass> mlir::createConvertQIRToLLVMPass()
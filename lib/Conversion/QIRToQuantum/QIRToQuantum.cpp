@@ -21,14 +21,13 @@
 #include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/STLExtras.h>
 #include <llvm/ADT/SmallVector.h>
-#include <llvm/IR/ValueMap.h>
 #include <llvm/Support/Casting.h>
 #include <mlir/Dialect/Func/IR/FuncOps.h>
 #include <mlir/Dialect/Tensor/IR/Tensor.h>
+#include <mlir/IR/Threading.h>
 #include <mlir/IR/BuiltinAttributes.h>
 #include <mlir/IR/BuiltinTypes.h>
 #include <mlir/IR/Diagnostics.h>
-#include <mlir/IR/IRMapping.h>
 #include <mlir/IR/MLIRContext.h>
 #include <mlir/IR/TypeRange.h>
 #include <mlir/IR/Types.h>
@@ -53,22 +52,6 @@ namespace mlir {
 
 namespace {
 
-Value getLastUsage(Value value)
-{
-    mlir::Value current = value;
-
-    while (true) {
-        auto uses = current.getUses();
-        auto it = uses.begin();
-        if (it == uses.end()) return current;
-
-        auto &operand = *it;
-        auto user = operand.getOwner();
-        unsigned operandIndex = operand.getOperandNumber();
-        current = user->getResult(operandIndex);
-    }
-}
-
 struct ConvertQIRToQuantumPass
         : mlir::impl::ConvertQIRToQuantumBase<ConvertQIRToQuantumPass> {
     using ConvertQIRToQuantumBase::ConvertQIRToQuantumBase;
@@ -78,14 +61,14 @@ struct ConvertQIRToQuantumPass
 
 template<typename Op>
 struct QIRToQuantumOpConversionPattern : OpConversionPattern<Op> {
-    IRMapping* mapping;
+    QubitChains* chains;
 
     QIRToQuantumOpConversionPattern(
         TypeConverter &typeConverter,
         MLIRContext* ctx,
-        IRMapping* mapping)
+        QubitChains* chains)
             : OpConversionPattern<Op>(typeConverter, ctx, 1),
-              mapping(mapping)
+              chains(chains)
     {}
 };
 
@@ -99,19 +82,19 @@ struct ConvertFuncFunc : public QIRToQuantumOpConversionPattern<func::FuncOp> {
     {
         auto ftype = op.getFunctionType();
 
-        auto genFuncTy = typeConverter->convertType(ftype);
-        auto genFunc = rewriter.create<func::FuncOp>(
-            op->getLoc(),
-            op.getSymName(),
-            llvm::dyn_cast<FunctionType>(genFuncTy));
+        auto genFuncTy = llvm::dyn_cast_if_present<FunctionType>(
+            typeConverter->convertType(ftype));
+        if (!genFuncTy) return failure();
 
-        if (!op.isExternal()) {
-            rewriter.inlineRegionBefore(
-                adaptor.getBody(),
-                genFunc.getBody(),
-                genFunc.end());
-        }
-        rewriter.replaceOp(op, genFunc);
+        // The function is updated in place rather than replaced, so that
+        // the module is not modified while functions are lifted
+        // concurrently.
+        if (!op.isExternal()
+            && failed(rewriter.convertRegionTypes(
+                &op.getBody(),
+                *typeConverter)))
+            return failure();
+        rewriter.modifyOpInPlace(op, [&] { op.setFunctionType(genFuncTy); });
 
         return success();
     }
@@ -127,8 +110,13 @@ struct ConvertFuncReturn
         ConversionPatternRewriter &rewriter) const override
     {
         SmallVector<Value> inputs;
-        for (auto operand : adaptor.getOperands())
-            inputs.emplace_back(mapping->lookup(operand));
+        for (auto [operand, converted] :
+             llvm::zip_equal(op.getOperands(), adaptor.getOperands())) {
+            if (llvm::isa<qir::QubitType>(operand.getType()))
+                inputs.push_back(chains->getVersion(operand, converted));
+            else
+                inputs.push_back(converted);
+        }
 
         rewriter.create<func::ReturnOp>(op->getLoc(), inputs);
         rewriter.eraseOp(op);
@@ -144,10 +132,10 @@ struct ConvertAlloc : public QIRToQuantumOpConversionPattern<qir::AllocOp> {
         AllocOpAdaptor adaptor,
         ConversionPatternRewriter &rewriter) const override
     {
-        auto allocOp = rewriter.replaceOpWithNewOp<quantum::AllocOp>(
+        // The chain of the qubit starts at the new op when it is first used.
+        rewriter.replaceOpWithNewOp<quantum::AllocOp>(
             op,
             quantum::QubitType::get(getContext(), 1));
-        mapping->map(allocOp.getResult(), allocOp.getResult());
         return success();
     }
 }; // struct ConvertAllocOp
@@ -176,13 +164,11 @@ struct ConvertSwap : public QIRToQuantumOpConversionPattern<qir::SwapOp> {
         qir::SwapOpAdaptor adaptor,
         ConversionPatternRewriter &rewriter) const override
     {
-        // Retrieve the two input qubits from the adaptor.
-        Value newLhs = mapping->lookup(adaptor.getLhs());
-        Value newRhs = mapping->lookup(adaptor.getRhs());
-        auto swapOp =
-            rewriter.create<quantum::SWAPOp>(op.getLoc(), newLhs, newRhs);
-        mapping->map(adaptor.getLhs(), swapOp.getResult1());
-        mapping->map(adaptor.getRhs(), swapOp.getResult2());
+        Value &lhs = chains->getVersion(op.getLhs(), adaptor.getLhs());
+        Value &rhs = chains->getVersion(op.getRhs(), adaptor.getRhs());
+        auto swapOp = rewriter.create<quantum::SWAPOp>(op.getLoc(), lhs, rhs);
+        lhs = swapOp.getResult1();
+        rhs = swapOp.getResult2();
         rewriter.eraseOp(op);
         return success();
     }
@@ -198,10 +184,11 @@ struct ConvertRotation : public QIRToQuantumOpConversionPattern<SourceOp> {
         OpConversionPattern<SourceOp>::OpAdaptor adaptor,
         ConversionPatternRewriter &rewriter) const override
     {
-        auto input = this->mapping->lookup(adaptor.getInput());
+        Value &input =
+            this->chains->getVersion(op.getInput(), adaptor.getInput());
         auto genOp =
             rewriter.create<TargetOp>(op.getLoc(), input, adaptor.getAngle());
-        this->mapping->map(adaptor.getInput(), genOp.getResult());
+        input = genOp.getResult();
         rewriter.eraseOp(op);
         return success();
     }
@@ -217,9 +204,10 @@ struct ConvertUnaryOp : public QIRToQuantumOpConversionPattern<SourceOp> {
         OpConversionPattern<SourceOp>::OpAdaptor adaptor,
         ConversionPatternRewriter &rewriter) const override
     {
-        auto input = this->mapping->lookup(adaptor.getInput());
+        Value &input =
+            this->chains->getVersion(op.getInput(), adaptor.getInput());
         auto genOp = rewriter.create<TargetOp>(op.getLoc(), input);
-        this->mapping->map(adaptor.getInput(), genOp.getResult());
+        input = genOp.getResult();
         rewriter.eraseOp(op);
         return success();
     }
@@ -233,11 +221,12 @@ struct ConvertCNOT : public QIRToQuantumOpConversionPattern<qir::CNOTOp> {
         qir::CNOTOpAdaptor adaptor,
         ConversionPatternRewriter &rewriter) const override
     {
-        auto ctrl = mapping->lookup(adaptor.getControl());
-        auto tgt = mapping->lookup(adaptor.getTarget());
+        Value &ctrl =
+            chains->getVersion(op.getControl(), adaptor.getControl());
+        Value &tgt = chains->getVersion(op.getTarget(), adaptor.getTarget());
         auto cxOp = rewriter.create<quantum::CNOTOp>(op.getLoc(), ctrl, tgt);
-        mapping->map(adaptor.getControl(), cxOp.getControlOut());
-        mapping->map(adaptor.getTarget(), cxOp.getTargetOut());
+        ctrl = cxOp.getControlOut();
+        tgt = cxOp.getTargetOut();
 
         rewriter.eraseOp(op);
         return success();
@@ -251,11 +240,12 @@ struct ConvertCZ : public QIRToQuantumOpConversionPattern<qir::CZOp> {
         qir::CZOpAdaptor adaptor,
         ConversionPatternRewriter &rewriter) const override
     {
-        auto ctrl = mapping->lookup(adaptor.getControl());
-        auto tgt = mapping->lookup(adaptor.getTarget());
+        Value &ctrl =
+            chains->getVersion(op.getControl(), adaptor.getControl());
+        Value &tgt = chains->getVersion(op.getTarget(), adaptor.getTarget());
         auto czOp = rewriter.create<quantum::CZOp>(op.getLoc(), ctrl, tgt);
-        mapping->map(adaptor.getControl(), czOp.getControlOut());
-        mapping->map(adaptor.getTarget(), czOp.getTargetOut());
+        ctrl = czOp.getControlOut();
+        tgt = czOp.getTargetOut();
         rewriter.eraseOp(op);
         return success();
     }
@@ -268,14 +258,16 @@ struct ConvertCCX : public QIRToQuantumOpConversionPattern<qir::CCXOp> {
         qir::CCXOpAdaptor adaptor,
         ConversionPatternRewriter &rewriter) const override
     {
-        auto ctrl1 = mapping->lookup(adaptor.getControl1());
-        auto ctrl2 = mapping->lookup(adaptor.getControl2());
-        auto tgt = mapping->lookup(adaptor.getTarget());
+        Value &ctrl1 =
+            chains->getVersion(op.getControl1(), adaptor.getControl1());
+        Value &ctrl2 =
+            chains->getVersion(op.getControl2(), adaptor.getControl2());
+        Value &tgt = chains->getVersion(op.getTarget(), adaptor.getTarget());
         auto ccxOp =
             rewriter.create<quantum::CCXOp>(op.getLoc(), ctrl1, ctrl2, tgt);
-        mapping->map(adaptor.getControl1(), ccxOp.getControl1Out());
-        mapping->map(adaptor.getControl2(), ccxOp.getControl2Out());
-        mapping->map(adaptor.getTarget(), ccxOp.getTargetOut());
+        ctrl1 = ccxOp.getControl1Out();
+        ctrl2 = ccxOp.getControl2Out();
+        tgt = ccxOp.getTargetOut();
         rewriter.eraseOp(op);
         return success();
     }
@@ -290,9 +282,13 @@ struct ConvertBarrierOp
         qir::BarrierOpAdaptor adaptor,
         ConversionPatternRewriter &rewriter) const override
     {
+        SmallVector<Value*> versions;
         SmallVector<Value> inputs;
-        for (auto operand : adaptor.getInput())
-            inputs.emplace_back(mapping->lookup(operand));
+        for (auto [operand, converted] :
+             llvm::zip_equal(op.getInput(), adaptor.getInput())) {
+            versions.push_back(&chains->getVersion(operand, converted));
+            inputs.push_back(*versions.back());
+        }
 
         SmallVector<Type> resultTypes(
             inputs.size(),
@@ -303,9 +299,9 @@ struct ConvertBarrierOp
             resultTypes,
             inputs);
 
-        for (auto [input, result] :
-             llvm::zip_equal(adaptor.getInput(), barrierOp.getResult()))
-            mapping->map(input, result);
+        for (auto [version, result] :
+             llvm::zip_equal(versions, barrierOp.getResult()))
+            *version = result;
 
         rewriter.eraseOp(op);
         return success();
@@ -320,14 +316,14 @@ struct ConvertU3 : public QIRToQuantumOpConversionPattern<qir::U3Op> {
         qir::U3OpAdaptor adaptor,
         ConversionPatternRewriter &rewriter) const override
     {
-        auto input = mapping->lookup(adaptor.getInput());
+        Value &input = chains->getVersion(op.getInput(), adaptor.getInput());
         auto newOp = rewriter.create<quantum::U3Op>(
             op.getLoc(),
             input,
             adaptor.getTheta(),
             adaptor.getPhi(),
             adaptor.getLambda());
-        mapping->map(adaptor.getInput(), newOp.getResult());
+        input = newOp.getResult();
         rewriter.eraseOp(op);
         return success();
     }
@@ -341,12 +337,12 @@ struct ConvertU1 : public QIRToQuantumOpConversionPattern<qir::U1Op> {
         qir::U1OpAdaptor adaptor,
         ConversionPatternRewriter &rewriter) const override
     {
-        auto input = mapping->lookup(adaptor.getInput());
+        Value &input = chains->getVersion(op.getInput(), adaptor.getInput());
         auto u1Op = rewriter.create<quantum::U1Op>(
             op.getLoc(),
             input,
             adaptor.getLambda());
-        mapping->map(adaptor.getInput(), u1Op.getResult());
+        input = u1Op.getResult();
         rewriter.eraseOp(op);
         return success();
     }
@@ -360,13 +356,13 @@ struct ConvertU2 : public QIRToQuantumOpConversionPattern<qir::U2Op> {
         qir::U2OpAdaptor adaptor,
         ConversionPatternRewriter &rewriter) const override
     {
-        auto input = mapping->lookup(adaptor.getInput());
+        Value &input = chains->getVersion(op.getInput(), adaptor.getInput());
         auto u2Op = rewriter.create<quantum::U2Op>(
             op.getLoc(),
             input,
             adaptor.getPhi(),
             adaptor.getLambda());
-        mapping->map(adaptor.getInput(), u2Op.getResult());
+        input = u2Op.getResult();
         rewriter.eraseOp(op);
         return success();
     }
@@ -380,8 +376,10 @@ struct ConvertCRy : public QIRToQuantumOpConversionPattern<qir::CRyOp> {
         qir::CRyOpAdaptor adaptor,
         ConversionPatternRewriter &rewriter) const override
     {
-        auto controlQubit = mapping->lookup(adaptor.getControl());
-        auto targetQubit = mapping->lookup(adaptor.getTarget());
+        Value &controlQubit =
+            chains->getVersion(op.getControl(), adaptor.getControl());
+        Value &targetQubit =
+            chains->getVersion(op.getTarget(), adaptor.getTarget());
         auto angle = adaptor.getAngle();
 
         auto cryOp = rewriter.create<quantum::CRyOp>(
@@ -390,9 +388,9 @@ struct ConvertCRy : public QIRToQuantumOpConversionPattern<qir::CRyOp> {
             targetQubit,
             angle);
 
-        // Update the qubit map with outputs
-        mapping->map(adaptor.getControl(), cryOp.getControlOut());
-        mapping->map(adaptor.getTarget(), cryOp.getTargetOut());
+        // Advance the chains to the outputs
+        controlQubit = cryOp.getControlOut();
+        targetQubit = cryOp.getTargetOut();
 
         rewriter.eraseOp(op);
         return success();
@@ -407,8 +405,10 @@ struct ConvertCRz : public QIRToQuantumOpConversionPattern<qir::CRzOp> {
         qir::CRzOpAdaptor adaptor,
         ConversionPatternRewriter &rewriter) const override
     {
-        auto controlQubit = mapping->lookup(adaptor.getControl());
-        auto targetQubit = mapping->lookup(adaptor.getTarget());
+        Value &controlQubit =
+            chains->getVersion(op.getControl(), adaptor.getControl());
+        Value &targetQubit =
+            chains->getVersion(op.getTarget(), adaptor.getTarget());
         auto angle = adaptor.getAngle();
 
         auto crzOp = rewriter.create<quantum::CRzOp>(
@@ -417,9 +417,9 @@ struct ConvertCRz : public QIRToQuantumOpConversionPattern<qir::CRzOp> {
             targetQubit,
             angle);
 
-        // Update the qubit map with outputs
-        mapping->map(adaptor.getControl(), crzOp.getControlOut());
-        mapping->map(adaptor.getTarget(), crzOp.getTargetOut());
+        // Advance the chains to the outputs
+        controlQubit = crzOp.getControlOut();
+        targetQubit = crzOp.getTargetOut();
 
         rewriter.eraseOp(op);
         return success();
@@ -434,7 +434,7 @@ struct ConvertReset : public QIRToQuantumOpConversionPattern<qir::ResetOp> {
         ResetOpAdaptor adaptor,
         ConversionPatternRewriter &rewriter) const override
     {
-        auto in = mapping->lookup(adaptor.getInput());
+        auto in = chains->getVersion(op.getInput(), adaptor.getInput());
         rewriter.replaceOpWithNewOp<quantum::DeallocateOp>(op, in);
         return success();
     }
@@ -448,7 +448,7 @@ struct ConvertMeasure : public QIRToQuantumOpConversionPattern<qir::MeasureOp> {
         MeasureOpAdaptor adaptor,
         ConversionPatternRewriter &rewriter) const override
     {
-        auto input = mapping->lookup(adaptor.getInput());
+        Value &input = chains->getVersion(op.getInput(), adaptor.getInput());
         auto loc = op.getLoc();
 
         auto i1Type = rewriter.getI1Type();
@@ -460,7 +460,7 @@ struct ConvertMeasure : public QIRToQuantumOpConversionPattern<qir::MeasureOp> {
             input.getType(),
             input);
 
-        mapping->map(adaptor.getInput(), genMeasureOp.getResult());
+        input = genMeasureOp.getResult();
 
         // qir.measure (%q, %r)
         // Find uses of %r and get %m of
@@ -516,21 +516,16 @@ struct ConvertGateOp : public QIRToQuantumOpConversionPattern<qir::GateOp> {
             op.getResAttrs().value_or(ArrayAttr()),
             ftype);
 
-        Block* newEntryBlock = gateOp.addEntryBlock();
-        Block &oldEntryBlock = op.getBody().front();
-
-        for (auto [oldArg, newArg] : llvm::zip(
-                 oldEntryBlock.getArguments(),
-                 newEntryBlock->getArguments())) {
-            mapping->map(oldArg, newArg);
-            mapping->map(newArg, newArg);
-        }
-        rewriter.setInsertionPointToStart(newEntryBlock);
-        for (Operation &op : oldEntryBlock.without_terminator())
-            rewriter.clone(op, *mapping);
-
-        Operation* terminator = oldEntryBlock.getTerminator();
-        rewriter.clone(*terminator, *mapping);
+        // The body is moved rather than cloned, so its ops are lifted in
+        // place and keep the qubit IDs of the chains.
+        rewriter.inlineRegionBefore(
+            op.getBody(),
+            gateOp.getBody(),
+            gateOp.getBody().end());
+        if (failed(rewriter.convertRegionTypes(
+                &gateOp.getBody(),
+                *getTypeConverter())))
+            return failure();
 
         rewriter.eraseOp(op);
         return success();
@@ -549,10 +544,12 @@ struct ConvertGateReturnOp
         auto gate = op->getParentOfType<quantum::GateOp>();
         if (!gate) op.emitOpError("Failed to access enclosing GateOp");
 
+        // The arguments are the first qubits of the chains, so a gate
+        // returns the latest version of every argument.
         auto &entryBlock = gate.getBody().front();
         SmallVector<Value> results;
-        for (auto arg : entryBlock.getArguments())
-            results.push_back(getLastUsage(arg));
+        for (auto [id, arg] : llvm::enumerate(entryBlock.getArguments()))
+            results.push_back(chains->getVersion(id, arg));
         rewriter.create<quantum::ReturnOp>(op->getLoc(), results);
         rewriter.eraseOp(op);
         return success();
@@ -568,9 +565,13 @@ struct ConvertGateCallOp
         GateCallOpAdaptor adaptor,
         ConversionPatternRewriter &rewriter) const override
     {
+        SmallVector<Value*> versions;
         SmallVector<Value> args;
-        for (auto arg : adaptor.getOperands())
-            args.push_back(mapping->lookup(arg));
+        for (auto [operand, converted] :
+             llvm::zip_equal(op->getOperands(), adaptor.getOperands())) {
+            versions.push_back(&chains->getVersion(operand, converted));
+            args.push_back(*versions.back());
+        }
 
         SmallVector<Type> resultTypes;
         if (failed(
@@ -585,9 +586,9 @@ struct ConvertGateCallOp
             resultTypes,
             args);
 
-        for (auto [arg, result] :
-             llvm::zip_equal(adaptor.getOperands(), callOp->getResults()))
-            mapping->map(arg, result);
+        for (auto [version, result] :
+             llvm::zip_equal(versions, callOp->getResults()))
+            *version = result;
 
         rewriter.eraseOp(op);
         return success();
@@ -596,13 +597,22 @@ struct ConvertGateCallOp
 
 } // namespace
 
+QubitChains::QubitChains(Operation* root)
+{
+    if (root->getNumRegions() != 0 && !root->getRegion(0).empty())
+        for (BlockArgument arg : root->getRegion(0).front().getArguments())
+            ids.try_emplace(arg, ids.size());
+    root->walk([&](qir::AllocOp op) {
+        ids.try_emplace(op.getResult(), ids.size());
+    });
+    versions.resize(ids.size());
+}
+
 void ConvertQIRToQuantumPass::runOnOperation()
 {
     TypeConverter typeConverter;
     auto context = &getContext();
     ConversionTarget target(*context);
-    RewritePatternSet patterns(context);
-    IRMapping mapping;
 
     typeConverter.addConversion([](Type ty) { return ty; });
     typeConverter.addConversion([](qir::QubitType ty) {
@@ -620,8 +630,6 @@ void ConvertQIRToQuantumPass::runOnOperation()
         return FunctionType::get(fty.getContext(), argTypes, resTypes);
     });
 
-    qir::populateConvertQIRToQuantumPatterns(typeConverter, patterns, mapping);
-
     target.addIllegalDialect<qir::QIRDialect>();
     target.addLegalDialect<quantum::QuantumDialect>();
     target.addDynamicallyLegalOp<func::FuncOp>([&](func::FuncOp op) {
@@ -636,17 +644,41 @@ void ConvertQIRToQuantumPass::runOnOperation()
         return legal;
     });
 
-    if (failed(applyPartialConversion(
-            getOperation(),
-            target,
-            std::move(patterns))))
+    // Every function is lifted with its own qubit table, so functions are
+    // independent and are lifted concurrently. Gates replace their op in
+    // the module and are lifted afterwards, as are the remaining ops.
+    const auto lift = [&](Operation* op) {
+        QubitChains chains(op);
+        RewritePatternSet patterns(context);
+        qir::populateConvertQIRToQuantumPatterns(
+            typeConverter,
+            patterns,
+            chains);
+        return applyPartialConversion(op, target, std::move(patterns));
+    };
+    auto module = dyn_cast<ModuleOp>(getOperation());
+    if (!module) {
+        if (failed(lift(getOperation()))) signalPassFailure();
+        return;
+    }
+
+    SmallVector<Operation*> functions, others;
+    for (Operation &op : *module.getBody()) {
+        if (isa<func::FuncOp>(op))
+            functions.push_back(&op);
+        else
+            others.push_back(&op);
+    }
+    if (failed(failableParallelForEach(context, functions, lift)))
         return signalPassFailure();
+    for (Operation* op : others)
+        if (failed(lift(op))) return signalPassFailure();
 }
 
 void mlir::qir::populateConvertQIRToQuantumPatterns(
     TypeConverter &typeConverter,
     RewritePatternSet &patterns,
-    IRMapping &mapping)
+    QubitChains &chains)
 {
     patterns.add<
         ConvertFuncFunc,
@@ -678,7 +710,7 @@ void mlir::qir::populateConvertQIRToQuantumPatterns(
         ConvertReset,
         ConvertGateOp,
         ConvertGateReturnOp,
-        ConvertGateCallOp>(typeConverter, patterns.getContext(), &mapping);
+        ConvertGateCallOp>(typeConverter, patterns.getContext(), &chains);
 }
 
 std::unique_ptr<Pass> mlir::createConvertQIRToQuantumPass()
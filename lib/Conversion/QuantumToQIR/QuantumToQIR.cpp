@@ -7,6 +7,8 @@
 
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/PatternMatch.h"
+#include "mlir/IR/Threading.h"
+#include "mlir/Interfaces/FunctionInterfaces.h"
 #include "mlir/Pass/Pass.h"
 #include "mlir/Transforms/DialectConversion.h"
 #include "quantum-mlir/Dialect/QIR/IR/QIR.h"
@@ -21,6 +23,7 @@
 #include <llvm/ADT/SmallVector.h>
 #include <llvm/Support/Casting.h>
 #include <mlir/Dialect/Func/IR/FuncOps.h>
+#include <mlir/Dialect/SCF/IR/SCF.h>
 #include <mlir/Dialect/Tensor/IR/Tensor.h>
 #include <mlir/IR/BuiltinTypes.h>
 #include <mlir/IR/Types.h>
@@ -131,24 +134,133 @@ struct ConvertFunc : public OpConversionPattern<func::FuncOp> {
     {
         auto ftype = op.getFunctionType();
 
-        auto genFuncTy = typeConverter->convertType(ftype);
-        auto genFunc = rewriter.create<func::FuncOp>(
-            op->getLoc(),
-            op.getSymName(),
-            llvm::dyn_cast<FunctionType>(genFuncTy));
-
-        if (!op.isExternal()) {
-            rewriter.inlineRegionBefore(
-                adaptor.getBody(),
-                genFunc.getBody(),
-                genFunc.end());
-        }
-        rewriter.replaceOp(op, genFunc);
+        auto genFuncTy = llvm::dyn_cast_if_present<FunctionType>(
+            typeConverter->convertType(ftype));
+        if (!genFuncTy) return failure();
+
+        // The function is updated in place rather than replaced, so that
+        // the module is not modified while functions are converted
+        // concurrently.
+        if (!op.isExternal()
+            && failed(rewriter.convertRegionTypes(
+                &op.getBody(),
+                *typeConverter)))
+            return failure();
+        rewriter.modifyOpInPlace(op, [&] { op.setFunctionType(genFuncTy); });
 
         return success();
     }
 }; // struct ConvertFunc
 
+/// Returns the qubit operand of the op defining @p qubit that the lowered op
+/// keeps using as @p qubit , or null if there is none, e.g. for allocations.
+Value getInputQubit(OpResult qubit)
+{
+    // The lowered ops replace their k-th qubit result by their k-th qubit
+    // operand.
+    const auto isQubit = [](Value value) {
+        return llvm::isa<quantum::QubitType>(value.getType());
+    };
+    Operation* op = qubit.getOwner();
+    auto index = llvm::count_if(
+        op->getResults().take_front(qubit.getResultNumber()),
+        isQubit);
+    for (Value operand : op->getOperands()) {
+        if (!isQubit(operand)) continue;
+        if (index == 0) return operand;
+        --index;
+    }
+    return {};
+}
+
+/// Returns whether the qubit @p yielded lowers to the same QIR qubit as the
+/// region argument @p arg .
+bool isSameQubit(Value yielded, BlockArgument arg)
+{
+    while (auto result = llvm::dyn_cast<OpResult>(yielded)) {
+        yielded = getInputQubit(result);
+        if (!yielded) return false;
+    }
+    return yielded == arg;
+}
+
+struct ConvertFor : public OpConversionPattern<quantum::ForOp> {
+    using OpConversionPattern::OpConversionPattern;
+
+    LogicalResult matchAndRewrite(
+        ForOp op,
+        ForOpAdaptor adaptor,
+        ConversionPatternRewriter &rewriter) const override
+    {
+        // QIR qubits are references that the gates do not change, so only
+        // classical values are carried from one iteration to the next. This
+        // requires every iteration to yield its qubits where it received
+        // them.
+        auto yield =
+            llvm::cast<quantum::YieldOp>(op.getBody()->getTerminator());
+        for (auto [yielded, arg] : llvm::zip_equal(
+                 yield->getOperands(),
+                 op.getRegionCapturedArgs()))
+            if (llvm::isa<quantum::QubitType>(arg.getType())
+                && !isSameQubit(yielded, arg))
+                return rewriter.notifyMatchFailure(
+                    op,
+                    "qubit is not yielded at the position it was captured at");
+
+        SmallVector<Value> iterArgs;
+        for (Value captured : adaptor.getCapturedArgs())
+            if (!llvm::isa<qir::QubitType>(captured.getType()))
+                iterArgs.push_back(captured);
+
+        auto loop = rewriter.create<scf::ForOp>(
+            op.getLoc(),
+            adaptor.getLowerBound(),
+            adaptor.getUpperBound(),
+            adaptor.getStep(),
+            iterArgs,
+            [](OpBuilder &, Location, Value, ValueRange) {});
+
+        SmallVector<Value> bodyArgs{loop.getInductionVar()};
+        SmallVector<Value> results;
+        auto regionIterArgs = loop.getRegionIterArgs().begin();
+        auto loopResults = loop.getResults().begin();
+        for (Value captured : adaptor.getCapturedArgs()) {
+            if (llvm::isa<qir::QubitType>(captured.getType())) {
+                bodyArgs.push_back(captured);
+                results.push_back(captured);
+                continue;
+            }
+            bodyArgs.push_back(*regionIterArgs++);
+            results.push_back(*loopResults++);
+        }
+
+        rewriter.mergeBlocks(op.getBody(), loop.getBody(), bodyArgs);
+        rewriter.replaceOp(op, results);
+        return success();
+    }
+}; // struct ConvertFor
+
+struct ConvertYield : public OpConversionPattern<quantum::YieldOp> {
+    using OpConversionPattern::OpConversionPattern;
+
+    LogicalResult matchAndRewrite(
+        YieldOp op,
+        YieldOpAdaptor adaptor,
+        ConversionPatternRewriter &rewriter) const override
+    {
+        if (!llvm::isa<scf::ForOp>(op->getParentOp()))
+            return rewriter.notifyMatchFailure(op, "expected a lowered loop");
+
+        // The qubits are not carried by the lowered loop, see ConvertFor.
+        SmallVector<Value> results;
+        for (Value result : adaptor.getResults())
+            if (!llvm::isa<qir::QubitType>(result.getType()))
+                results.push_back(result);
+        rewriter.replaceOpWithNewOp<scf::YieldOp>(op, results);
+        return success();
+    }
+}; // struct ConvertYield
+
 template<typename SourceOp, typename TargetOp>
 struct ConvertUnaryOp : public OpConversionPattern<SourceOp> {
     using OpConversionPattern<SourceOp>::OpConversionPattern;
@@ -227,14 +339,32 @@ void ConvertQuantumToQIRPass::runOnOperation()
 
     target.addIllegalDialect<quantum::QuantumDialect>();
     target.addLegalDialect<qir::QIRDialect>();
+    target.addLegalDialect<scf::SCFDialect>();
     target.addDynamicallyLegalOp<func::FuncOp>([&](func::FuncOp op) {
         return typeConverter.isLegal(op.getFunctionType());
     });
 
-    if (failed(applyPartialConversion(
-            getOperation(),
-            target,
-            std::move(patterns))))
+    // Functions are independent, so they are converted concurrently, and the
+    // remaining ops of a module afterwards.
+    const FrozenRewritePatternSet frozenPatterns(std::move(patterns));
+    const auto convert = [&](auto ops) {
+        return applyPartialConversion(ops, target, frozenPatterns);
+    };
+    auto module = dyn_cast<ModuleOp>(getOperation());
+    if (!module) {
+        if (failed(convert(getOperation()))) signalPassFailure();
+        return;
+    }
+
+    SmallVector<Operation*> functions, others;
+    for (Operation &op : *module.getBody()) {
+        if (isa<FunctionOpInterface>(op))
+            functions.push_back(&op);
+        else
+            others.push_back(&op);
+    }
+    if (failed(failableParallelForEach(context, functions, convert))
+        || failed(convert(ArrayRef<Operation*>(others))))
         return signalPassFailure();
 }
 
@@ -249,6 +379,8 @@ void mlir::quantum::populateConvertQuantumToQIRPatterns(
         ConvertUnaryOp<quantum::XOp, qir::XOp>,
         ConvertRotationOp<quantum::RzOp, qir::RzOp>,
         ConvertFunc,
+        ConvertFor,
+        ConvertYield,
         ConvertSwap,
         ConvertDealloc>(typeConverter, patterns.getContext(), /* benefit*/ 1);
 }
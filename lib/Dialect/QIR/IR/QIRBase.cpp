@@ -5,8 +5,11 @@
 
 #include "quantum-mlir/Dialect/QIR/IR/QIRBase.h"
 
+#include "mlir/Bytecode/BytecodeImplementation.h"
 #include "quantum-mlir/Dialect/QIR/IR/QIR.h"
 
+#include <cstdint>
+
 using namespace mlir;
 using namespace mlir::qir;
 
@@ -16,7 +19,47 @@ using namespace mlir::qir;
 
 //===----------------------------------------------------------------------===//
 
-namespace {} // namespace
+namespace {
+
+/// The codes of the types in bytecode, which must never be reordered.
+enum class TypeCode : std::uint64_t {
+    Qubit = 0,
+    Result = 1,
+};
+
+/// Encodes the parameterless types of the dialect in bytecode as a single
+/// varint each, instead of their textual form.
+struct QIRBytecodeInterface : BytecodeDialectInterface {
+    using BytecodeDialectInterface::BytecodeDialectInterface;
+
+    Type readType(DialectBytecodeReader &reader) const override
+    {
+        std::uint64_t code;
+        if (failed(reader.readVarInt(code))) return Type();
+        switch (static_cast<TypeCode>(code)) {
+        case TypeCode::Qubit: return QubitType::get(getContext());
+        case TypeCode::Result: return ResultType::get(getContext());
+        }
+        reader.emitError() << "unknown qir type code: " << code;
+        return Type();
+    }
+
+    LogicalResult
+    writeType(Type type, DialectBytecodeWriter &writer) const override
+    {
+        if (isa<QubitType>(type)) {
+            writer.writeVarInt(static_cast<std::uint64_t>(TypeCode::Qubit));
+            return success();
+        }
+        if (isa<ResultType>(type)) {
+            writer.writeVarInt(static_cast<std::uint64_t>(TypeCode::Result));
+            return success();
+        }
+        return failure();
+    }
+};
+
+} // namespace
 
 //===----------------------------------------------------------------------===//
 // QIRDialect
@@ -26,4 +69,5 @@ void QIRDialect::initialize()
 {
     registerOps();
     registerTypes();
+    addInterfaces<QIRBytecodeInterface>();
 }
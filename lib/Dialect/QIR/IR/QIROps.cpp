@@ -99,6 +99,36 @@ void GateOp::build(
         getResAttrsAttrName(state.name));
 }
 
+//===----------------------------------------------------------------------===//
+// Noise channels
+//===----------------------------------------------------------------------===//
+
+static LogicalResult
+verifyProbability(Operation* op, StringRef name, APFloat value)
+{
+    const double probability = value.convertToDouble();
+    if (probability < 0.0 || probability > 1.0)
+        return op->emitOpError() << "expects '" << name
+                                 << "' to be in [0, 1], but got "
+                                 << probability;
+    return success();
+}
+
+LogicalResult DepolarizingOp::verify()
+{
+    return verifyProbability(*this, "probability", getProbability());
+}
+
+LogicalResult AmplitudeDampingOp::verify()
+{
+    return verifyProbability(*this, "gamma", getGamma());
+}
+
+LogicalResult ReadoutErrorOp::verify()
+{
+    return verifyProbability(*this, "probability", getProbability());
+}
+
 void QIRDialect::registerOps()
 {
     addOperations<
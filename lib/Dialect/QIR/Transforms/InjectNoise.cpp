@@ -0,0 +1,215 @@
+/// Implements the QIR noise injection from a JSON noise model.
+///
+/// @file
+
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Pass/Pass.h"
+#include "quantum-mlir/Dialect/QIR/IR/QIR.h"
+#include "quantum-mlir/Dialect/QIR/IR/QIROps.h"
+#include "quantum-mlir/Dialect/QIR/Transforms/Passes.h"
+
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+#include <optional>
+
+using namespace mlir;
+using namespace mlir::qir;
+
+//===- Generated includes -------------------------------------------------===//
+
+namespace mlir::qir {
+
+#define GEN_PASS_DEF_INJECTNOISE
+#include "quantum-mlir/Dialect/QIR/Transforms/Passes.h.inc"
+
+} // namespace mlir::qir
+
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+/// The channels attached to one gate kind.
+struct NoiseSpec {
+    std::optional<double> depolarizing;
+    std::optional<double> amplitudeDamping;
+    std::optional<double> readoutError;
+};
+
+/// A noise model keyed by gate kind.
+struct NoiseModel {
+    llvm::StringMap<NoiseSpec> kinds;
+    std::optional<NoiseSpec> fallback;
+
+    /// Returns the channels for @p kind , or nullptr if it is noiseless.
+    const NoiseSpec* lookup(StringRef kind) const
+    {
+        auto it = kinds.find(kind);
+        if (it != kinds.end()) return &it->second;
+        // Measurements and resets are never covered by the fallback.
+        if (kind == "measure" || kind == "reset") return nullptr;
+        return fallback ? &*fallback : nullptr;
+    }
+};
+
+/// Parses the channels of @p kind from @p value into @p spec .
+LogicalResult parseSpec(
+    function_ref<InFlightDiagnostic()> emitError,
+    StringRef kind,
+    const llvm::json::Value &value,
+    NoiseSpec &spec)
+{
+    const llvm::json::Object* channels = value.getAsObject();
+    if (!channels)
+        return emitError() << "noise model entry '" << kind
+                           << "' must be an object";
+
+    for (const auto &[key, channelValue] : *channels) {
+        std::optional<double> probability = channelValue.getAsNumber();
+        if (!probability || *probability < 0.0 || *probability > 1.0)
+            return emitError() << "noise model entry '" << kind << "."
+                               << key.str() << "' must be a number in [0, 1]";
+
+        if (key == "depolarizing") {
+            spec.depolarizing = probability;
+        } else if (key == "amplitude_damping") {
+            spec.amplitudeDamping = probability;
+        } else if (key == "readout_error") {
+            if (kind != "measure")
+                return emitError() << "'readout_error' is only supported for "
+                                      "'measure', but found in '"
+                                   << kind << "'";
+            spec.readoutError = probability;
+        } else {
+            return emitError() << "unknown noise channel '" << key.str()
+                               << "' in '" << kind << "'";
+        }
+    }
+    return success();
+}
+
+/// Parses the JSON document @p text into @p model .
+LogicalResult parseNoiseModel(
+    function_ref<InFlightDiagnostic()> emitError,
+    StringRef text,
+    NoiseModel &model)
+{
+    llvm::Expected<llvm::json::Value> root = llvm::json::parse(text);
+    if (!root)
+        return emitError() << "invalid noise model: "
+                           << llvm::toString(root.takeError());
+
+    const llvm::json::Object* kinds = root->getAsObject();
+    if (!kinds) return emitError() << "noise model must be a JSON object";
+
+    for (const auto &[kind, value] : *kinds) {
+        NoiseSpec spec;
+        if (failed(parseSpec(emitError, kind, value, spec))) return failure();
+        if (kind == "*")
+            model.fallback = spec;
+        else
+            model.kinds[kind] = spec;
+    }
+    return success();
+}
+
+struct InjectNoisePass : mlir::qir::impl::InjectNoiseBase<InjectNoisePass> {
+    using InjectNoiseBase::InjectNoiseBase;
+
+    LogicalResult initialize(MLIRContext* context) override;
+    void runOnOperation() override;
+
+private:
+    void insertChannels(
+        OpBuilder &builder,
+        Location loc,
+        Value qubit,
+        const NoiseSpec &spec);
+
+    NoiseModel model;
+};
+
+} // namespace
+
+LogicalResult InjectNoisePass::initialize(MLIRContext* context)
+{
+    auto emitError = [&]() {
+        return mlir::emitError(UnknownLoc::get(context));
+    };
+
+    if (noiseModel.empty())
+        return emitError() << "qir-inject-noise requires a 'noise-model'";
+
+    auto buffer = llvm::MemoryBuffer::getFile(noiseModel);
+    if (!buffer)
+        return emitError() << "cannot open noise model '" << noiseModel
+                           << "': " << buffer.getError().message();
+
+    return parseNoiseModel(emitError, (*buffer)->getBuffer(), model);
+}
+
+void InjectNoisePass::insertChannels(
+    OpBuilder &builder,
+    Location loc,
+    Value qubit,
+    const NoiseSpec &spec)
+{
+    if (spec.depolarizing)
+        builder.create<DepolarizingOp>(
+            loc,
+            qubit,
+            builder.getF64FloatAttr(*spec.depolarizing));
+    if (spec.amplitudeDamping)
+        builder.create<AmplitudeDampingOp>(
+            loc,
+            qubit,
+            builder.getF64FloatAttr(*spec.amplitudeDamping));
+}
+
+void InjectNoisePass::runOnOperation()
+{
+    // Collect first so that the inserted channels are not visited.
+    SmallVector<std::pair<Operation*, const NoiseSpec*>> noisyOps;
+    getOperation()->walk([&](Operation* op) {
+        if (!isa_and_nonnull<QIRDialect>(op->getDialect())) return;
+        if (isa<DepolarizingOp, AmplitudeDampingOp, ReadoutErrorOp>(op))
+            return;
+        // Barriers have no physical effect and calls are covered by the
+        // gates in the callee.
+        if (isa<BarrierOp, GateCallOp>(op)) return;
+        if (const NoiseSpec* spec = model.lookup(op->getName().stripDialect()))
+            noisyOps.emplace_back(op, spec);
+    });
+
+    OpBuilder builder(&getContext());
+    for (auto [op, spec] : noisyOps) {
+        if (auto measureOp = dyn_cast<MeasureOp>(op)) {
+            builder.setInsertionPoint(measureOp);
+            insertChannels(
+                builder,
+                measureOp.getLoc(),
+                measureOp.getInput(),
+                *spec);
+            if (spec->readoutError) {
+                builder.setInsertionPointAfter(measureOp);
+                builder.create<ReadoutErrorOp>(
+                    measureOp.getLoc(),
+                    measureOp.getResult(),
+                    builder.getF64FloatAttr(*spec->readoutError));
+            }
+            continue;
+        }
+
+        builder.setInsertionPointAfter(op);
+        for (Value operand : op->getOperands())
+            if (isa<QubitType>(operand.getType()))
+                insertChannels(builder, op->getLoc(), operand, *spec);
+    }
+}
+
+std::unique_ptr<Pass> mlir::qir::createInjectNoisePass()
+{
+    return std::make_unique<InjectNoisePass>();
+}
@@ -0,0 +1,231 @@
+/// Implements the localization of qubits for distributed simulation.
+///
+/// @file
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/Dominance.h"
+#include "mlir/IR/SymbolTable.h"
+#include "mlir/Pass/Pass.h"
+#include "quantum-mlir/Dialect/QIR/IR/QIR.h"
+#include "quantum-mlir/Dialect/QIR/IR/QIROps.h"
+#include "quantum-mlir/Dialect/QIR/Transforms/Passes.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/TypeSwitch.h"
+
+#include <limits>
+
+using namespace mlir;
+using namespace mlir::qir;
+
+//===- Generated includes -------------------------------------------------===//
+
+namespace mlir::qir {
+
+#define GEN_PASS_DEF_LOCALIZEQUBITS
+#include "quantum-mlir/Dialect/QIR/Transforms/Passes.h.inc"
+
+} // namespace mlir::qir
+
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+/// Returns the qubit that @p op acts on non-diagonally, or a null value.
+///
+/// Only these operands exchange amplitudes when they occupy a global slot.
+Value getNonDiagonalTarget(Operation* op)
+{
+    return TypeSwitch<Operation*, Value>(op)
+        .Case<
+            HOp,
+            XOp,
+            YOp,
+            RxOp,
+            RyOp,
+            U2Op,
+            U3Op,
+            ResetOp,
+            DepolarizingOp,
+            AmplitudeDampingOp>([](auto gate) { return gate.getInput(); })
+        .Case<CNOTOp, CRyOp, CCXOp>([](auto gate) { return gate.getTarget(); })
+        .Default([](Operation*) { return Value(); });
+}
+
+/// Returns whether qubits must not be renamed across @p op .
+bool endsRenaming(Operation* op)
+{
+    if (op->hasTrait<OpTrait::IsTerminator>() || op->getNumRegions() > 0)
+        return true;
+    // Gate calls apply their body to the renamed qubits, and the printed
+    // state would expose the permutation.
+    if (isa<GateCallOp, ShowStateOp>(op)) return true;
+    if (isa_and_nonnull<QIRDialect>(op->getDialect())) return false;
+    return llvm::any_of(op->getOperandTypes(), [](Type type) {
+        return isa<QubitType>(type);
+    });
+}
+
+struct LocalizeQubitsPass
+        : mlir::qir::impl::LocalizeQubitsBase<LocalizeQubitsPass> {
+    using LocalizeQubitsBase::LocalizeQubitsBase;
+
+    void runOnOperation() override;
+
+private:
+    void localize(ArrayRef<Operation*> segment, Operation* end);
+    Value selectLocal(
+        ArrayRef<Operation*> segment,
+        std::size_t pos,
+        const DenseMap<Value, Value> &location);
+    bool endsProgram(Operation* end);
+
+    /// The qubits that select the rank at runtime.
+    llvm::DenseSet<Value> global;
+    /// The remaining qubits in allocation order.
+    SmallVector<Value> local;
+    DominanceInfo* dominance = nullptr;
+    /// Whether a function is never referenced from the module.
+    DenseMap<Operation*, bool> uncalled;
+};
+
+} // namespace
+
+Value LocalizeQubitsPass::selectLocal(
+    ArrayRef<Operation*> segment,
+    std::size_t pos,
+    const DenseMap<Value, Value> &location)
+{
+    // Evict the qubit whose next non-diagonal gate is furthest away, so that
+    // it is least likely to be wanted back in a local slot.
+    Value best;
+    std::size_t bestDistance = 0;
+    for (Value candidate : local) {
+        if (location.contains(candidate)) continue;
+        if (!dominance->properlyDominates(candidate, segment[pos])) continue;
+
+        std::size_t distance = std::numeric_limits<std::size_t>::max();
+        for (std::size_t next = pos; next < segment.size(); ++next) {
+            if (getNonDiagonalTarget(segment[next]) == candidate) {
+                distance = next - pos;
+                break;
+            }
+        }
+        if (!best || distance > bestDistance) {
+            best = candidate;
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
+
+bool LocalizeQubitsPass::endsProgram(Operation* end)
+{
+    if (!end || !isa<func::ReturnOp>(end)) return false;
+    auto func = end->getParentOfType<func::FuncOp>();
+    auto [it, inserted] = uncalled.try_emplace(func);
+    if (inserted)
+        it->second = SymbolTable::symbolKnownUseEmpty(func, getOperation());
+    return it->second;
+}
+
+void LocalizeQubitsPass::localize(ArrayRef<Operation*> segment, Operation* end)
+{
+    if (segment.empty()) return;
+    Block* block = segment.front()->getBlock();
+
+    // A swap is undone before the op that ends the renaming. Blocks that run
+    // again, such as loop bodies, and functions that are called again find
+    // their qubits in the slots they were allocated to, since the lowering
+    // addresses qubits statically. Only the return of a function that is
+    // never called keeps the swap if no other block uses either qubit.
+    const bool keepAtEnd = endsProgram(end);
+    auto needsRestore = [&](Value qubit) {
+        if (!keepAtEnd) return true;
+        return llvm::any_of(qubit.getUsers(), [&](Operation* user) {
+            return user->getBlock() != block;
+        });
+    };
+
+    // Maps each moved qubit to the slot that currently holds its state.
+    DenseMap<Value, Value> location;
+    SmallVector<std::pair<Value, Value>> swaps;
+    bool restore = false;
+    OpBuilder builder(&getContext());
+
+    for (auto [pos, op] : llvm::enumerate(segment)) {
+        const Value target = getNonDiagonalTarget(op);
+        if (target && global.contains(target) && !location.contains(target)) {
+            const auto uses = llvm::count_if(
+                segment.drop_front(pos),
+                [&](Operation* next) {
+                    return getNonDiagonalTarget(next) == target;
+                });
+            if (const Value free = selectLocal(segment, pos, location)) {
+                const bool undo = needsRestore(target) || needsRestore(free);
+                // Every swap between a global and a local qubit costs one
+                // exchange, just like every gate it saves.
+                if (static_cast<std::size_t>(uses) > (undo ? 2u : 1u)) {
+                    builder.setInsertionPoint(op);
+                    builder.create<SwapOp>(op->getLoc(), target, free);
+                    location[target] = free;
+                    location[free] = target;
+                    swaps.emplace_back(target, free);
+                    restore |= undo;
+                }
+            }
+        }
+
+        for (OpOperand &operand : op->getOpOperands())
+            if (const Value moved = location.lookup(operand.get()))
+                operand.set(moved);
+    }
+
+    if (!restore) return;
+    if (end)
+        builder.setInsertionPoint(end);
+    else
+        builder.setInsertionPointToEnd(block);
+    // The swaps act on disjoint pairs, so they commute.
+    for (auto [lhs, rhs] : swaps)
+        builder.create<SwapOp>(builder.getUnknownLoc(), lhs, rhs);
+}
+
+void LocalizeQubitsPass::runOnOperation()
+{
+    if (globalQubits == 0) return;
+
+    // The lowering numbers qubits in walk order, and the runtime hands the
+    // global slots to the lowest numbers.
+    global.clear();
+    local.clear();
+    getOperation()->walk([&](AllocOp allocOp) {
+        if (global.size() < globalQubits)
+            global.insert(allocOp.getResult());
+        else
+            local.push_back(allocOp.getResult());
+    });
+    if (local.empty()) return;
+
+    dominance = &getAnalysis<DominanceInfo>();
+    getOperation()->walk([&](Block* block) {
+        SmallVector<Operation*> segment;
+        for (Operation &op : *block) {
+            if (!endsRenaming(&op)) {
+                segment.push_back(&op);
+                continue;
+            }
+            localize(segment, &op);
+            segment.clear();
+        }
+        localize(segment, nullptr);
+    });
+}
+
+std::unique_ptr<Pass> mlir::qir::createLocalizeQubitsPass()
+{
+    return std::make_unique<LocalizeQubitsPass>();
+}
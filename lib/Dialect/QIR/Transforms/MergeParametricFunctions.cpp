@@ -0,0 +1,232 @@
+/// Implements the merging of functions that only differ in their angles.
+///
+/// @file
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/SymbolTable.h"
+#include "mlir/Pass/Pass.h"
+#include "quantum-mlir/Dialect/QIR/IR/QIR.h"
+#include "quantum-mlir/Dialect/QIR/Transforms/Passes.h"
+#include "quantum-mlir/Support/StringKey.h"
+
+#include <cstdint>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringMap.h>
+#include <string>
+
+using namespace mlir;
+
+//===- Generated includes -------------------------------------------------===//
+
+namespace mlir::qir {
+
+#define GEN_PASS_DEF_MERGEPARAMETRICFUNCTIONS
+#include "quantum-mlir/Dialect/QIR/Transforms/Passes.h.inc"
+
+} // namespace mlir::qir
+
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+struct MergeParametricFunctionsPass
+        : mlir::qir::impl::MergeParametricFunctionsBase<
+              MergeParametricFunctionsPass> {
+    using MergeParametricFunctionsBase::MergeParametricFunctionsBase;
+
+    void runOnOperation() override;
+};
+
+/// Returns whether @p type is a qubit or a result of qir.
+bool isQIRType(Type type) { return isa<qir::QubitType, qir::ResultType>(type); }
+
+/// The structure of a function with its angles left out.
+struct FunctionForm {
+    /// Op names, attributes, types and the numbers of the operands.
+    SmallVector<std::uintptr_t> form;
+    /// The floating-point constants, which become parameters.
+    SmallVector<arith::ConstantOp> angles;
+
+    /// Computes the form of @p func . Returns false if the function cannot
+    /// be merged.
+    bool analyse(func::FuncOp func)
+    {
+        // The runtime addresses qubits and results statically per qir.alloc
+        // and qir.ralloc, so merged functions would share them. Such functions
+        // must take their qubits and results as arguments instead.
+        if (func.isExternal()
+            || llvm::any_of(func.getResultTypes(), isQIRType))
+            return false;
+        const auto allocates = [](Operation* op) {
+            return isa<qir::AllocOp, qir::AllocResultOp>(op)
+                       ? WalkResult::interrupt()
+                       : WalkResult::advance();
+        };
+        if (func.walk(allocates).wasInterrupted()) return false;
+
+        const auto push = [&](const void* ptr) {
+            form.push_back(reinterpret_cast<std::uintptr_t>(ptr));
+        };
+        push(func.getFunctionType().getAsOpaquePointer());
+        push(func.getArgAttrsAttr().getAsOpaquePointer());
+        push(func.getResAttrsAttr().getAsOpaquePointer());
+
+        // Blocks are numbered in advance, since branches may go forward.
+        DenseMap<Block*, unsigned> blockIds;
+        func.getBody().walk<WalkOrder::PreOrder>([&](Block* block) {
+            blockIds.try_emplace(block, blockIds.size());
+        });
+
+        // Values are numbered in the order of their definition.
+        DenseMap<Value, unsigned> ids;
+        const auto define = [&](ValueRange values) {
+            for (Value value : values) ids.try_emplace(value, ids.size());
+        };
+        func.getBody().walk<WalkOrder::PreOrder>([&](Block* block) {
+            form.push_back(block->getNumArguments());
+            define(block->getArguments());
+            for (Operation &op : *block) {
+                auto constant = dyn_cast<arith::ConstantOp>(op);
+                if (constant && isa<FloatType>(constant.getType())
+                    && constant->getParentWithTrait<
+                           OpTrait::IsIsolatedFromAbove>()
+                           == func.getOperation()) {
+                    angles.push_back(constant);
+                    push(constant.getType().getAsOpaquePointer());
+                } else {
+                    push(op.getName().getAsOpaquePointer());
+                    push(op.getAttrDictionary().getAsOpaquePointer());
+                }
+                form.push_back(op.getNumOperands());
+                for (Value operand : op.getOperands()) {
+                    // Values from above the function are compared as is.
+                    auto it = ids.find(operand);
+                    form.push_back(it != ids.end() ? it->second : ~0u);
+                    if (it == ids.end()) push(operand.getAsOpaquePointer());
+                }
+                form.push_back(op.getNumResults());
+                for (Type type : op.getResultTypes())
+                    push(type.getAsOpaquePointer());
+                form.push_back(op.getNumRegions());
+                for (Region &region : op.getRegions())
+                    form.push_back(region.getBlocks().size());
+                form.push_back(op.getNumSuccessors());
+                for (Block* successor : op.getSuccessors())
+                    form.push_back(blockIds.lookup(successor));
+                define(op.getResults());
+            }
+        });
+        return true;
+    }
+
+    /// Returns the form as a key of a string map.
+    StringRef key() const { return quantum::getStringKey(form); }
+};
+
+/// Creates a function that computes @p func with its angles as additional
+/// arguments after the original ones.
+func::FuncOp createParametric(
+    OpBuilder &builder,
+    func::FuncOp func,
+    ArrayRef<arith::ConstantOp> angles)
+{
+    SmallVector<Type> inputs(func.getArgumentTypes());
+    for (arith::ConstantOp angle : angles) inputs.push_back(angle.getType());
+
+    auto parametric = builder.create<func::FuncOp>(
+        func.getLoc(),
+        (func.getSymName() + ".parametric").str(),
+        builder.getFunctionType(inputs, func.getResultTypes()));
+    parametric.setPrivate();
+
+    IRMapping mapping;
+    func.getBody().cloneInto(&parametric.getBody(), mapping);
+    Block &entry = parametric.getBody().front();
+    for (arith::ConstantOp angle : angles) {
+        auto clone =
+            cast<arith::ConstantOp>(mapping.lookup(angle.getOperation()));
+        clone.replaceAllUsesWith(
+            entry.addArgument(angle.getType(), angle.getLoc()));
+        clone.erase();
+    }
+    return parametric;
+}
+
+/// Replaces the body of @p func by a call of @p parametric with its angles.
+void replaceByCall(
+    func::FuncOp func,
+    func::FuncOp parametric,
+    ArrayRef<arith::ConstantOp> angles)
+{
+    SmallVector<TypedAttr> values;
+    SmallVector<Location> locs;
+    for (arith::ConstantOp angle : angles) {
+        values.push_back(angle.getValue());
+        locs.push_back(angle.getLoc());
+    }
+    func.getBody().dropAllReferences();
+    func.getBody().getBlocks().clear();
+
+    OpBuilder builder(func.getContext());
+    Block* entry = func.addEntryBlock();
+    builder.setInsertionPointToStart(entry);
+    SmallVector<Value> operands(entry->getArguments());
+    for (auto [value, loc] : llvm::zip_equal(values, locs))
+        operands.push_back(
+            builder.create<arith::ConstantOp>(loc, value));
+    auto call =
+        builder.create<func::CallOp>(func.getLoc(), parametric, operands);
+    builder.create<func::ReturnOp>(func.getLoc(), call.getResults());
+}
+
+} // namespace
+
+void MergeParametricFunctionsPass::runOnOperation()
+{
+    ModuleOp module = getOperation();
+
+    // Group the functions by their exact form.
+    llvm::StringMap<SmallVector<unsigned>> groups;
+    SmallVector<StringRef> order;
+    SmallVector<func::FuncOp> functions;
+    SmallVector<FunctionForm> forms;
+    for (auto func : module.getOps<func::FuncOp>()) {
+        FunctionForm form;
+        if (!form.analyse(func)) continue;
+        functions.push_back(func);
+        forms.push_back(std::move(form));
+    }
+    for (auto [index, form] : llvm::enumerate(forms)) {
+        auto [it, inserted] = groups.try_emplace(form.key());
+        if (inserted) order.push_back(it->first());
+        it->second.push_back(index);
+    }
+
+    SymbolTable symbolTable(module);
+    OpBuilder builder(module.getBodyRegion());
+    bool changed = false;
+    for (StringRef key : order) {
+        const auto &members = groups.find(key)->second;
+        if (members.size() < minFunctions) continue;
+
+        func::FuncOp first = functions[members.front()];
+        builder.setInsertionPoint(first);
+        func::FuncOp parametric =
+            createParametric(builder, first, forms[members.front()].angles);
+        symbolTable.insert(parametric);
+        for (unsigned index : members)
+            replaceByCall(functions[index], parametric, forms[index].angles);
+        changed = true;
+    }
+    if (!changed) markAllAnalysesPreserved();
+}
+
+std::unique_ptr<Pass> mlir::qir::createMergeParametricFunctionsPass()
+{
+    return std::make_unique<MergeParametricFunctionsPass>();
+}
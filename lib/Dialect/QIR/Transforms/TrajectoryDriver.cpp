@@ -0,0 +1,94 @@
+/// Implements the generation of a parallel trajectory driver.
+///
+/// @file
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Pass/Pass.h"
+#include "quantum-mlir/Dialect/QIR/IR/QIR.h"
+#include "quantum-mlir/Dialect/QIR/Transforms/Passes.h"
+
+using namespace mlir;
+
+//===- Generated includes -------------------------------------------------===//
+
+namespace mlir::qir {
+
+#define GEN_PASS_DEF_TRAJECTORYDRIVER
+#include "quantum-mlir/Dialect/QIR/Transforms/Passes.h.inc"
+
+} // namespace mlir::qir
+
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+/// Name of the runtime entry point that executes the trajectories.
+constexpr StringLiteral kRunTrajectories = "__quantum__rt__run_trajectories";
+
+struct TrajectoryDriverPass
+        : mlir::qir::impl::TrajectoryDriverBase<TrajectoryDriverPass> {
+    using TrajectoryDriverBase::TrajectoryDriverBase;
+
+    void runOnOperation() override;
+};
+
+} // namespace
+
+void TrajectoryDriverPass::runOnOperation()
+{
+    ModuleOp module = getOperation();
+
+    auto kernelOp = module.lookupSymbol<func::FuncOp>(kernel);
+    if (!kernelOp) {
+        module.emitError() << "trajectory kernel '" << kernel << "' not found";
+        return signalPassFailure();
+    }
+    FunctionType kernelType = kernelOp.getFunctionType();
+    if (kernelType.getNumInputs() != 0 || kernelType.getNumResults() != 0) {
+        kernelOp.emitError()
+            << "trajectory kernel must not take arguments or return results";
+        return signalPassFailure();
+    }
+    if (module.lookupSymbol(driver)) {
+        module.emitError() << "symbol '" << driver << "' already exists";
+        return signalPassFailure();
+    }
+
+    OpBuilder builder = OpBuilder::atBlockEnd(module.getBody());
+    Location loc = kernelOp.getLoc();
+
+    if (!module.lookupSymbol<func::FuncOp>(kRunTrajectories)) {
+        const Type kernelRefType = kernelType;
+        auto runOp = builder.create<func::FuncOp>(
+            loc,
+            kRunTrajectories,
+            builder.getFunctionType(kernelRefType, {}));
+        runOp.setPrivate();
+    }
+
+    auto driverOp = builder.create<func::FuncOp>(
+        loc,
+        driver,
+        builder.getFunctionType({}, {}));
+    builder.setInsertionPointToStart(driverOp.addEntryBlock());
+    // The runtime options passed on qir.init select the number of
+    // trajectories and threads, and are the options of every trajectory.
+    builder.create<qir::InitOp>(loc);
+    Value kernelRef = builder.create<func::ConstantOp>(
+        loc,
+        kernelType,
+        SymbolRefAttr::get(kernelOp));
+    builder.create<func::CallOp>(
+        loc,
+        kRunTrajectories,
+        TypeRange{},
+        ValueRange{kernelRef});
+    builder.create<func::ReturnOp>(loc);
+}
+
+std::unique_ptr<Pass> mlir::qir::createTrajectoryDriverPass()
+{
+    return std::make_unique<TrajectoryDriverPass>();
+}
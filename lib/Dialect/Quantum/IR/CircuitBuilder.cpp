@@ -0,0 +1,238 @@
+/// Implements the circuit builder for the Quantum dialect.
+///
+/// @file
+
+#include "quantum-mlir/Dialect/Quantum/IR/CircuitBuilder.h"
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+
+#include "llvm/ADT/STLExtras.h"
+
+#include <bit>
+
+using namespace mlir;
+using namespace mlir::quantum;
+
+CircuitBuilder::CircuitBuilder(OpBuilder &builder, Location loc)
+        : builder(builder),
+          loc(loc),
+          qubitType(QubitType::get(builder.getContext(), 1)),
+          f64Type(builder.getF64Type())
+{}
+
+void CircuitBuilder::reserve(std::size_t numQubits, std::size_t numAngles)
+{
+    qubits.reserve(numQubits);
+    angles.reserve(numAngles);
+}
+
+Operation* CircuitBuilder::track(Operation* op)
+{
+    if (!front) front = op;
+    return op;
+}
+
+unsigned CircuitBuilder::allocQubits(unsigned count)
+{
+    const unsigned first = qubits.size();
+    qubits.reserve(first + count);
+    for (unsigned i = 0; i < count; ++i)
+        qubits.push_back(
+            track(builder.create<AllocOp>(loc, qubitType))->getResult(0));
+    return first;
+}
+
+unsigned CircuitBuilder::addQubit(Value qubit)
+{
+    assert(qubit.getType() == qubitType && "expected a single qubit");
+    qubits.push_back(qubit);
+    return qubits.size() - 1;
+}
+
+Value CircuitBuilder::getAngle(double value)
+{
+    // Keyed by the bits, so that 0.0 and -0.0 stay distinct.
+    const auto bits = std::bit_cast<std::uint64_t>(value);
+    auto [it, inserted] = angles.try_emplace(bits);
+    if (!inserted) return it->second;
+
+    // Constants precede the circuit, so they dominate every gate using them.
+    OpBuilder::InsertionGuard guard(builder);
+    if (front) builder.setInsertionPoint(front);
+    it->second = builder.create<arith::ConstantOp>(
+        loc,
+        builder.getFloatAttr(f64Type, value));
+    return it->second;
+}
+
+template<typename Op>
+CircuitBuilder &
+CircuitBuilder::apply(ArrayRef<unsigned> indices, ValueRange params)
+{
+    OperationState state(loc, Op::getOperationName());
+    state.operands.reserve(indices.size() + params.size());
+    for (unsigned index : indices) state.operands.push_back(qubits[index]);
+    state.addOperands(params);
+    state.types.assign(indices.size(), qubitType);
+
+    Operation* op = track(builder.create(state));
+    for (auto [index, result] : llvm::zip_equal(indices, op->getResults()))
+        qubits[index] = result;
+    return *this;
+}
+
+//===----------------------------------------------------------------------===//
+// Gates
+//===----------------------------------------------------------------------===//
+
+CircuitBuilder &CircuitBuilder::h(unsigned qubit)
+{
+    return apply<HOp>(qubit);
+}
+
+CircuitBuilder &CircuitBuilder::x(unsigned qubit)
+{
+    return apply<XOp>(qubit);
+}
+
+CircuitBuilder &CircuitBuilder::y(unsigned qubit)
+{
+    return apply<YOp>(qubit);
+}
+
+CircuitBuilder &CircuitBuilder::z(unsigned qubit)
+{
+    return apply<ZOp>(qubit);
+}
+
+CircuitBuilder &CircuitBuilder::s(unsigned qubit)
+{
+    return apply<SOp>(qubit);
+}
+
+CircuitBuilder &CircuitBuilder::sdg(unsigned qubit)
+{
+    return apply<SdgOp>(qubit);
+}
+
+CircuitBuilder &CircuitBuilder::t(unsigned qubit)
+{
+    return apply<TOp>(qubit);
+}
+
+CircuitBuilder &CircuitBuilder::tdg(unsigned qubit)
+{
+    return apply<TdgOp>(qubit);
+}
+
+CircuitBuilder &CircuitBuilder::rx(unsigned qubit, double theta)
+{
+    return rx(qubit, getAngle(theta));
+}
+
+CircuitBuilder &CircuitBuilder::rx(unsigned qubit, Value theta)
+{
+    return apply<RxOp>(qubit, theta);
+}
+
+CircuitBuilder &CircuitBuilder::ry(unsigned qubit, double theta)
+{
+    return ry(qubit, getAngle(theta));
+}
+
+CircuitBuilder &CircuitBuilder::ry(unsigned qubit, Value theta)
+{
+    return apply<RyOp>(qubit, theta);
+}
+
+CircuitBuilder &CircuitBuilder::rz(unsigned qubit, double theta)
+{
+    return rz(qubit, getAngle(theta));
+}
+
+CircuitBuilder &CircuitBuilder::rz(unsigned qubit, Value theta)
+{
+    return apply<RzOp>(qubit, theta);
+}
+
+CircuitBuilder &CircuitBuilder::u1(unsigned qubit, double lambda)
+{
+    return apply<U1Op>(qubit, getAngle(lambda));
+}
+
+CircuitBuilder &CircuitBuilder::u2(unsigned qubit, double phi, double lambda)
+{
+    return apply<U2Op>(qubit, {getAngle(phi), getAngle(lambda)});
+}
+
+CircuitBuilder &
+CircuitBuilder::u3(unsigned qubit, double theta, double phi, double lambda)
+{
+    return apply<U3Op>(
+        qubit,
+        {getAngle(theta), getAngle(phi), getAngle(lambda)});
+}
+
+CircuitBuilder &CircuitBuilder::cnot(unsigned control, unsigned target)
+{
+    return apply<CNOTOp>({control, target});
+}
+
+CircuitBuilder &CircuitBuilder::cz(unsigned control, unsigned target)
+{
+    return apply<CZOp>({control, target});
+}
+
+CircuitBuilder &CircuitBuilder::swap(unsigned lhs, unsigned rhs)
+{
+    return apply<SWAPOp>({lhs, rhs});
+}
+
+CircuitBuilder &
+CircuitBuilder::crz(unsigned control, unsigned target, double angle)
+{
+    return apply<CRzOp>({control, target}, getAngle(angle));
+}
+
+CircuitBuilder &
+CircuitBuilder::cry(unsigned control, unsigned target, double angle)
+{
+    return apply<CRyOp>({control, target}, getAngle(angle));
+}
+
+CircuitBuilder &
+CircuitBuilder::ccx(unsigned control1, unsigned control2, unsigned target)
+{
+    return apply<CCXOp>({control1, control2, target});
+}
+
+CircuitBuilder &CircuitBuilder::barrier(ArrayRef<unsigned> indices)
+{
+    if (!indices.empty()) return apply<BarrierOp>(indices);
+    SmallVector<unsigned> live;
+    for (auto [index, qubit] : llvm::enumerate(qubits))
+        if (qubit) live.push_back(index);
+    return apply<BarrierOp>(live);
+}
+
+//===----------------------------------------------------------------------===//
+// Memory
+//===----------------------------------------------------------------------===//
+
+Value CircuitBuilder::measure(unsigned index)
+{
+    auto op = builder.create<MeasureSingleOp>(
+        loc,
+        builder.getI1Type(),
+        qubitType,
+        qubits[index]);
+    track(op);
+    qubits[index] = op.getResult();
+    return op.getMeasurement();
+}
+
+void CircuitBuilder::deallocate(unsigned index)
+{
+    track(builder.create<DeallocateOp>(loc, qubits[index]));
+    qubits[index] = nullptr;
+}
@@ -5,8 +5,11 @@
 
 #include "quantum-mlir/Dialect/Quantum/IR/QuantumBase.h"
 
+#include "mlir/Bytecode/BytecodeImplementation.h"
 #include "quantum-mlir/Dialect/Quantum/IR/Quantum.h"
 
+#include <cstdint>
+
 #define DEBUG_TYPE "quantum-base"
 
 using namespace mlir;
@@ -18,7 +21,53 @@ using namespace mlir::quantum;
 
 //===----------------------------------------------------------------------===//
 
-namespace {} // namespace
+namespace {
+
+/// The codes of the types in bytecode, which must never be reordered.
+enum class TypeCode : std::uint64_t {
+    Qubit = 0,
+};
+
+/// Encodes the types of the dialect in bytecode.
+///
+/// Ops need no custom encoding, since their properties are serialized by the
+/// generated code. The regions of the isolated quantum.gate and quantum.if
+/// ops are stored in their own sections and may therefore be loaded lazily.
+struct QuantumBytecodeInterface : BytecodeDialectInterface {
+    using BytecodeDialectInterface::BytecodeDialectInterface;
+
+    Type readType(DialectBytecodeReader &reader) const override
+    {
+        std::uint64_t code;
+        if (failed(reader.readVarInt(code))) return Type();
+        switch (static_cast<TypeCode>(code)) {
+        case TypeCode::Qubit:
+        {
+            std::int64_t size;
+            if (failed(reader.readSignedVarInt(size))) return Type();
+            return QubitType::getChecked(
+                [&] { return reader.emitError(); },
+                getContext(),
+                size);
+        }
+        }
+        reader.emitError() << "unknown quantum type code: " << code;
+        return Type();
+    }
+
+    LogicalResult
+    writeType(Type type, DialectBytecodeWriter &writer) const override
+    {
+        if (auto qubit = dyn_cast<QubitType>(type)) {
+            writer.writeVarInt(static_cast<std::uint64_t>(TypeCode::Qubit));
+            writer.writeSignedVarInt(qubit.getSize());
+            return success();
+        }
+        return failure();
+    }
+};
+
+} // namespace
 
 //===----------------------------------------------------------------------===//
 // QuantumDialect
@@ -28,4 +77,5 @@ void QuantumDialect::initialize()
 {
     registerOps();
     registerTypes();
+    addInterfaces<QuantumBytecodeInterface>();
 }
\ No newline at end of file
@@ -159,6 +159,21 @@ LogicalResult NoClone<ConcreteType>::verifyTrait(Operation* op)
         }
     }
 
+    // Check whether the qubits captured by the ForOp are used more than a
+    // single time in its body
+    if (auto forOp = llvm::dyn_cast_if_present<quantum::ForOp>(op)) {
+        for (auto value : forOp.getRegionCapturedArgs()) {
+            if (!llvm::isa<quantum::QubitType>(value.getType())) continue;
+            auto uses = value.getUses();
+            int numUses = std::distance(uses.begin(), uses.end());
+            if (numUses > 1) {
+                return op->emitOpError()
+                       << "captured qubit #" << value.getArgNumber() - 1
+                       << " used more than once within the same block";
+            }
+        }
+    }
+
     // Check whether the qubit values returned from an operation
     // are uses more than a single time.
     for (auto value : op->getOpResults()) {
@@ -196,6 +211,35 @@ LogicalResult IfOp::verify()
     return success();
 }
 
+LogicalResult ForOp::verify()
+{
+    if (getNumResults() != getCapturedArgs().size())
+        return emitOpError("# return values != # captured values");
+
+    Block* body = getBody();
+    if (body->getNumArguments() != 1 + getCapturedArgs().size())
+        return emitOpError("expected the induction variable and one region "
+                           "argument per captured value");
+    if (!getInductionVar().getType().isIndex())
+        return emitOpError("induction variable must be of index type");
+
+    for (auto [arg, captured, result] : llvm::zip_equal(
+             getRegionCapturedArgs(),
+             getCapturedArgs(),
+             getResults()))
+        if (arg.getType() != captured.getType()
+            || result.getType() != captured.getType())
+            return emitOpError("types of captured value #")
+                   << arg.getArgNumber() - 1
+                   << ", its region argument and its result must match";
+
+    auto yield = cast<quantum::YieldOp>(body->getTerminator());
+    if (!llvm::equal(yield->getOperandTypes(), getResultTypes()))
+        return emitOpError("body must yield the types of the results");
+
+    return success();
+}
+
 LogicalResult ReturnOp::verify()
 {
     auto customGate = cast<GateOp>((*this)->getParentOp());
@@ -480,6 +524,135 @@ void IfOp::getRegionInvocationBounds(
     }
 }
 
+//===----------------------------------------------------------------------===//
+// ForOp
+//===----------------------------------------------------------------------===//
+
+void ForOp::build(
+    OpBuilder &builder,
+    OperationState &result,
+    Value lowerBound,
+    Value upperBound,
+    Value step,
+    ValueRange capturedArgs,
+    function_ref<void(OpBuilder &, Location, Value, ValueRange)> bodyBuilder)
+{
+    OpBuilder::InsertionGuard guard(builder);
+    result.addOperands({lowerBound, upperBound, step});
+    result.addOperands(capturedArgs);
+
+    for (Value v : capturedArgs) result.addTypes(v.getType());
+
+    Region* bodyRegion = result.addRegion();
+    Block* body = builder.createBlock(bodyRegion);
+    body->addArgument(builder.getIndexType(), result.location);
+    for (Value v : capturedArgs) body->addArgument(v.getType(), v.getLoc());
+
+    // Without a builder, the body can only be terminated if it yields
+    // nothing.
+    if (bodyBuilder) {
+        builder.setInsertionPointToStart(body);
+        bodyBuilder(
+            builder,
+            result.location,
+            body->getArgument(0),
+            body->getArguments().drop_front());
+    } else if (capturedArgs.empty()) {
+        ForOp::ensureTerminator(*bodyRegion, builder, result.location);
+    }
+}
+
+ParseResult ForOp::parse(OpAsmParser &parser, OperationState &result)
+{
+    auto &builder = parser.getBuilder();
+    Type indexType = builder.getIndexType();
+
+    // Parse the induction variable and the bounds
+    OpAsmParser::Argument inductionVar;
+    OpAsmParser::UnresolvedOperand lowerBound, upperBound, step;
+    if (parser.parseArgument(inductionVar) || parser.parseEqual()
+        || parser.parseOperand(lowerBound) || parser.parseKeyword("to")
+        || parser.parseOperand(upperBound) || parser.parseKeyword("step")
+        || parser.parseOperand(step)
+        || parser.resolveOperand(lowerBound, indexType, result.operands)
+        || parser.resolveOperand(upperBound, indexType, result.operands)
+        || parser.resolveOperand(step, indexType, result.operands))
+        return failure();
+    inductionVar.type = indexType;
+
+    // Parse the capture list
+    SmallVector<OpAsmParser::Argument, 4> regionArgs;
+    SmallVector<OpAsmParser::UnresolvedOperand, 4> operands;
+    if (succeeded(parser.parseOptionalKeyword("ins"))) {
+        if (parser.parseAssignmentList(regionArgs, operands)) return failure();
+    }
+
+    // Parse the result type list
+    if (parser.parseOptionalArrowTypeList(result.types)) return failure();
+
+    if (regionArgs.size() != result.types.size())
+        return parser.emitError(
+            parser.getNameLoc(),
+            "mismatch in number of captured values and defined values");
+
+    for (auto [capturedArg, type] : llvm::zip_equal(regionArgs, result.types))
+        capturedArg.type = type;
+    if (parser.resolveOperands(
+            operands,
+            result.types,
+            parser.getNameLoc(),
+            result.operands))
+        return failure();
+
+    // Parse the body
+    regionArgs.insert(regionArgs.begin(), inductionVar);
+    Region* body = result.addRegion();
+    if (parser.parseRegion(*body, regionArgs)) return failure();
+    ForOp::ensureTerminator(*body, builder, result.location);
+
+    // Parse the optional attribute list.
+    if (parser.parseOptionalAttrDict(result.attributes)) return failure();
+
+    return success();
+}
+
+void ForOp::print(OpAsmPrinter &p)
+{
+    p << " " << getInductionVar() << " = " << getLowerBound() << " to "
+      << getUpperBound() << " step " << getStep();
+
+    printInitializationList(
+        p,
+        getRegionCapturedArgs(),
+        getCapturedArgs(),
+        " ins");
+
+    if (!getResults().empty()) p << " -> (" << getResultTypes() << ")";
+    p << ' ';
+    p.printRegion(
+        getBodyRegion(),
+        /*printEntryBlockArgs=*/false,
+        /*printBlockTerminators=*/true);
+
+    p.printOptionalAttrDict((*this)->getAttrs());
+}
+
+void ForOp::getSuccessorRegions(
+    RegionBranchPoint point,
+    SmallVectorImpl<RegionSuccessor> &regions)
+{
+    // Both the parent and the end of the body branch either into the body or
+    // out of the loop.
+    regions.push_back(
+        RegionSuccessor(&getBodyRegion(), getRegionCapturedArgs()));
+    regions.push_back(RegionSuccessor(getResults()));
+}
+
+OperandRange ForOp::getEntrySuccessorOperands(RegionBranchPoint point)
+{
+    return getCapturedArgs();
+}
+
 //===----------------------------------------------------------------------===//
 // GateCallOp
 //===----------------------------------------------------------------------===//
@@ -0,0 +1,144 @@
+/// Implements the pooling of angle constants.
+///
+/// @file
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Pass/Pass.h"
+#include "quantum-mlir/Dialect/Quantum/IR/Quantum.h"
+#include "quantum-mlir/Dialect/Quantum/Transforms/Commutation.h"
+#include "quantum-mlir/Dialect/Quantum/Transforms/Passes.h"
+
+#include <llvm/ADT/APFloat.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/SmallVector.h>
+
+using namespace mlir;
+using namespace mlir::quantum;
+
+//===- Generated includes -------------------------------------------------===//
+
+namespace mlir::quantum {
+
+#define GEN_PASS_DEF_QUANTUMPOOLANGLES
+#include "quantum-mlir/Dialect/Quantum/Transforms/Passes.h.inc"
+
+} // namespace mlir::quantum
+
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+struct QuantumPoolAnglesPass
+        : mlir::quantum::impl::QuantumPoolAnglesBase<QuantumPoolAnglesPass> {
+    using QuantumPoolAnglesBase::QuantumPoolAnglesBase;
+
+    void runOnOperation() override;
+};
+
+/// The pooled constants of a region, at the start of its entry block.
+class AnglePool {
+public:
+    explicit AnglePool(Region &region) : block(region.front()) {}
+
+    /// Returns the pooled constant of @p value , which is built at @p loc if
+    /// needed.
+    Value get(FloatAttr value, Location loc)
+    {
+        Value &pooled = constants[value];
+        if (pooled) return pooled;
+        OpBuilder builder(&block, getInsertionPoint());
+        auto constant = builder.create<arith::ConstantOp>(loc, value);
+        last = constant;
+        return pooled = constant;
+    }
+
+    /// Makes @p op the pooled constant of its value if there is none yet,
+    /// and returns whether it was kept.
+    bool adopt(arith::ConstantOp op, FloatAttr value)
+    {
+        Value &pooled = constants[value];
+        if (pooled) return false;
+        // The first constants of a function may already be in place.
+        const Block::iterator insertionPoint = getInsertionPoint();
+        if (insertionPoint == block.end() || &*insertionPoint != op)
+            op->moveBefore(&block, insertionPoint);
+        last = op;
+        pooled = op;
+        return true;
+    }
+
+private:
+    Block::iterator getInsertionPoint() const
+    {
+        return last ? std::next(last->getIterator()) : block.begin();
+    }
+
+    Block &block;
+    llvm::DenseMap<Attribute, Value> constants;
+    Operation* last = nullptr;
+};
+
+/// Pools the constants of @p region , without the regions of nested ops that
+/// are isolated from above.
+void poolRegion(Region &region)
+{
+    SmallVector<Operation*> ops;
+    for (Operation &op : region.getOps()) {
+        op.walk<WalkOrder::PreOrder>([&](Operation* nested) {
+            if (nested != &op
+                && nested->hasTrait<OpTrait::IsIsolatedFromAbove>())
+                return WalkResult::skip();
+            if (isa<arith::ConstantOp, arith::AddFOp>(nested))
+                ops.push_back(nested);
+            return WalkResult::advance();
+        });
+    }
+
+    AnglePool pool(region);
+    for (Operation* op : ops) {
+        if (auto constant = dyn_cast<arith::ConstantOp>(op)) {
+            auto value = dyn_cast<FloatAttr>(constant.getValue());
+            if (!value || pool.adopt(constant, value)) continue;
+            constant.replaceAllUsesWith(pool.get(value, constant.getLoc()));
+            constant.erase();
+            continue;
+        }
+
+        // Operands are visited before their users, so the constants of a
+        // chain of additions have all been pooled already.
+        auto add = cast<arith::AddFOp>(op);
+        const FloatAttr lhs = getConstantFloat(add.getLhs());
+        const FloatAttr rhs = getConstantFloat(add.getRhs());
+        if (!lhs || !rhs || lhs.getType() != rhs.getType()) continue;
+        llvm::APFloat sum = lhs.getValue();
+        sum.add(rhs.getValue(), llvm::APFloat::rmNearestTiesToEven);
+        add.replaceAllUsesWith(
+            pool.get(FloatAttr::get(lhs.getType(), sum), add.getLoc()));
+        add.erase();
+    }
+}
+
+} // namespace
+
+void QuantumPoolAnglesPass::runOnOperation()
+{
+    // Every isolated op owns the pools of its regions. The module itself is
+    // a graph region without an order to hoist to.
+    SmallVector<Region*> regions;
+    getOperation()->walk([&](Operation* op) {
+        if (op == getOperation()
+            || !op->hasTrait<OpTrait::IsIsolatedFromAbove>())
+            return;
+        for (Region &region : op->getRegions())
+            if (!region.empty()) regions.push_back(&region);
+    });
+
+    for (Region* region : regions) poolRegion(*region);
+}
+
+std::unique_ptr<Pass> mlir::quantum::createQuantumPoolAnglesPass()
+{
+    return std::make_unique<QuantumPoolAnglesPass>();
+}
@@ -0,0 +1,121 @@
+/// Implements the commutation rules of the Quantum gates.
+///
+/// @file
+
+#include "quantum-mlir/Dialect/Quantum/Transforms/Commutation.h"
+
+#include "mlir/IR/Matchers.h"
+#include "quantum-mlir/Dialect/Quantum/IR/Quantum.h"
+
+#include <llvm/ADT/APFloat.h>
+#include <llvm/ADT/STLExtras.h>
+
+using namespace mlir;
+using namespace mlir::quantum;
+
+bool mlir::quantum::isPrimitiveGate(Operation* op)
+{
+    return isa<
+        HOp,
+        XOp,
+        YOp,
+        ZOp,
+        SOp,
+        SdgOp,
+        TOp,
+        TdgOp,
+        RxOp,
+        RyOp,
+        RzOp,
+        U1Op,
+        U2Op,
+        U3Op,
+        CNOTOp,
+        CZOp,
+        SWAPOp,
+        CRzOp,
+        CRyOp,
+        CCXOp>(op);
+}
+
+bool mlir::quantum::isRotation(Operation* op)
+{
+    return isa<RxOp, RyOp, RzOp, U1Op>(op);
+}
+
+PauliAxis mlir::quantum::getAxis(Operation* op)
+{
+    if (isa<ZOp, SOp, SdgOp, TOp, TdgOp, RzOp, U1Op>(op)) return PauliAxis::Z;
+    if (isa<XOp, RxOp>(op)) return PauliAxis::X;
+    if (isa<YOp, RyOp>(op)) return PauliAxis::Y;
+    return PauliAxis::None;
+}
+
+PauliAxis mlir::quantum::getAxis(Operation* op, unsigned index)
+{
+    if (isa<CZOp, CRzOp>(op)) return PauliAxis::Z;
+    if (isa<CNOTOp>(op)) return index == 0 ? PauliAxis::Z : PauliAxis::X;
+    if (isa<CRyOp>(op)) return index == 0 ? PauliAxis::Z : PauliAxis::Y;
+    if (isa<CCXOp>(op)) return index < 2 ? PauliAxis::Z : PauliAxis::X;
+    return getAxis(op);
+}
+
+bool mlir::quantum::isInversePair(Operation* lhs, Operation* rhs)
+{
+    if (lhs->getName() == rhs->getName()) return lhs->hasTrait<Hermitian>();
+    return (isa<SOp>(lhs) && isa<SdgOp>(rhs))
+           || (isa<SdgOp>(lhs) && isa<SOp>(rhs))
+           || (isa<TOp>(lhs) && isa<TdgOp>(rhs))
+           || (isa<TdgOp>(lhs) && isa<TOp>(rhs));
+}
+
+FloatAttr mlir::quantum::getConstantFloat(Value value)
+{
+    FloatAttr attr;
+    if (matchPattern(value, m_Constant(&attr))) return attr;
+    return {};
+}
+
+FloatAttr mlir::quantum::addConstantAngles(FloatAttr lhs, FloatAttr rhs)
+{
+    if (!lhs || !rhs || lhs.getType() != rhs.getType()) return {};
+    llvm::APFloat sum = lhs.getValue();
+    sum.add(rhs.getValue(), llvm::APFloat::rmNearestTiesToEven);
+    return FloatAttr::get(lhs.getType(), sum);
+}
+
+bool mlir::quantum::anglesCancel(Value lhs, Value rhs)
+{
+    const FloatAttr sum =
+        addConstantAngles(getConstantFloat(lhs), getConstantFloat(rhs));
+    return sum && sum.getValue().isZero();
+}
+
+void mlir::quantum::mapParams(
+    OpBuilder &builder,
+    ValueRange captured,
+    Operation* gate,
+    IRMapping &map)
+{
+    for (Value param : gate->getOperands().drop_front(gate->getNumResults())) {
+        if (auto arg = dyn_cast<BlockArgument>(param)) {
+            // Leading block arguments, like an induction variable, are not
+            // captured.
+            const unsigned offset =
+                arg.getOwner()->getNumArguments() - captured.size();
+            map.map(param, captured[arg.getArgNumber() - offset]);
+        } else {
+            builder.clone(*param.getDefiningOp(), map);
+        }
+    }
+}
+
+void mlir::quantum::eraseGate(Operation* gate)
+{
+    const auto params =
+        llvm::to_vector(gate->getOperands().drop_front(gate->getNumResults()));
+    gate->erase();
+    for (Value param : params)
+        if (Operation* def = param.getDefiningOp(); def && def->use_empty())
+            def->erase();
+}
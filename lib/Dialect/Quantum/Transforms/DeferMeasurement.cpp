@@ -0,0 +1,342 @@
+/// Implements the hoisting of common gates out of quantum.if and the
+/// deferral of measurements.
+///
+/// @file
+
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Pass/Pass.h"
+#include "quantum-mlir/Dialect/Quantum/IR/Quantum.h"
+#include "quantum-mlir/Dialect/Quantum/Transforms/Commutation.h"
+#include "quantum-mlir/Dialect/Quantum/Transforms/Passes.h"
+
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/ADT/SmallVector.h>
+
+using namespace mlir;
+using namespace mlir::quantum;
+
+//===- Generated includes -------------------------------------------------===//
+
+namespace mlir::quantum {
+
+#define GEN_PASS_DEF_QUANTUMDEFERMEASUREMENT
+#include "quantum-mlir/Dialect/Quantum/Transforms/Passes.h.inc"
+
+} // namespace mlir::quantum
+
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+struct QuantumDeferMeasurementPass
+        : mlir::quantum::impl::QuantumDeferMeasurementBase<
+              QuantumDeferMeasurementPass> {
+    using QuantumDeferMeasurementBase::QuantumDeferMeasurementBase;
+
+    void runOnOperation() override;
+
+private:
+    bool deferMeasurement(IfOp ifOp);
+};
+
+/// Returns whether @p op has a controlled version built by buildControlled.
+bool isControllable(Operation* op)
+{
+    return isa<XOp, YOp, ZOp, RzOp, RyOp, CNOTOp>(op);
+}
+
+YieldOp getYield(Block* block) { return cast<YieldOp>(block->getTerminator()); }
+
+/// Returns whether @p lhs in one branch and @p rhs in the other branch of a
+/// quantum.if hold the same value, i.e. the same captured value or equal
+/// constants.
+bool isSameValue(Value lhs, Value rhs)
+{
+    auto lhsArg = dyn_cast<BlockArgument>(lhs);
+    auto rhsArg = dyn_cast<BlockArgument>(rhs);
+    if (lhsArg || rhsArg)
+        return lhsArg && rhsArg
+               && lhsArg.getArgNumber() == rhsArg.getArgNumber();
+
+    Attribute lhsValue, rhsValue;
+    return matchPattern(lhs, m_Constant(&lhsValue))
+           && matchPattern(rhs, m_Constant(&rhsValue)) && lhsValue == rhsValue;
+}
+
+/// Returns whether the operands of @p gate after its qubits are captured
+/// values or constants, which are available outside of the branch.
+bool hasInvariantParams(Operation* gate)
+{
+    return llvm::all_of(
+        gate->getOperands().drop_front(gate->getNumResults()),
+        [](Value param) {
+            return isa<BlockArgument>(param)
+                   || matchPattern(param, m_Constant());
+        });
+}
+
+/// Returns whether @p lhs and @p rhs apply the same gate with the same
+/// params, in different branches of a quantum.if.
+bool isSameGate(Operation* lhs, Operation* rhs)
+{
+    if (lhs->getName() != rhs->getName()
+        || lhs->getAttrDictionary() != rhs->getAttrDictionary()
+        || !hasInvariantParams(lhs))
+        return false;
+    return llvm::all_of(
+        llvm::zip(
+            lhs->getOperands().drop_front(lhs->getNumResults()),
+            rhs->getOperands().drop_front(rhs->getNumResults())),
+        [](auto pair) {
+            return isSameValue(std::get<0>(pair), std::get<1>(pair));
+        });
+}
+
+/// Applies a gate that both branches of @p ifOp apply first to the same
+/// captured qubits before @p ifOp instead. Returns whether one was hoisted.
+bool hoistLeadingGates(IfOp ifOp)
+{
+    Block* thenBlock = ifOp.thenBlock();
+    Block* elseBlock = ifOp.elseBlock();
+    for (Operation &op : thenBlock->without_terminator()) {
+        if (!isPrimitiveGate(&op)) continue;
+        // The gate must be the first on all of its qubits.
+        const auto qubits = op.getOperands().take_front(op.getNumResults());
+        if (!llvm::all_of(qubits, llvm::IsaPred<BlockArgument>)) continue;
+        const unsigned first = cast<BlockArgument>(qubits[0]).getArgNumber();
+        const BlockArgument elseQubit = elseBlock->getArgument(first);
+        if (!elseQubit.hasOneUse()) continue;
+        Operation* other = *elseQubit.getUsers().begin();
+        if (!isSameGate(&op, other)
+            || !llvm::all_of(
+                llvm::zip(qubits, other->getOperands()),
+                [](auto pair) {
+                    return isSameValue(std::get<0>(pair), std::get<1>(pair));
+                }))
+            continue;
+
+        OpBuilder builder(ifOp);
+        IRMapping map;
+        for (Value qubit : qubits) {
+            const unsigned index = cast<BlockArgument>(qubit).getArgNumber();
+            map.map(qubit, ifOp.getCapturedArgs()[index]);
+        }
+        mapParams(builder, ifOp.getCapturedArgs(), &op, map);
+        Operation* hoisted = builder.clone(op, map);
+
+        for (auto [qubit, result, otherResult, hoistedResult] : llvm::zip(
+                 qubits,
+                 op.getResults(),
+                 other->getResults(),
+                 hoisted->getResults())) {
+            const unsigned index = cast<BlockArgument>(qubit).getArgNumber();
+            ifOp.getCapturedArgsMutable()[index].set(hoistedResult);
+            result.replaceAllUsesWith(thenBlock->getArgument(index));
+            otherResult.replaceAllUsesWith(elseBlock->getArgument(index));
+        }
+        eraseGate(other);
+        eraseGate(&op);
+        return true;
+    }
+    return false;
+}
+
+/// Applies a gate that both branches of @p ifOp apply last to the same
+/// yielded qubits after @p ifOp instead. Returns whether one was sunk.
+bool sinkTrailingGates(IfOp ifOp)
+{
+    YieldOp thenYield = getYield(ifOp.thenBlock());
+    YieldOp elseYield = getYield(ifOp.elseBlock());
+    for (Operation &op :
+         llvm::reverse(ifOp.thenBlock()->without_terminator())) {
+        if (!isPrimitiveGate(&op) || !hasInvariantParams(&op)) continue;
+        // Every qubit must be yielded right away, at the same position as
+        // the qubits of the same gate in the other branch.
+        SmallVector<unsigned> positions;
+        for (OpResult result : op.getResults()) {
+            if (!result.hasOneUse() || *result.user_begin() != thenYield)
+                break;
+            positions.push_back(result.getUses().begin()->getOperandNumber());
+        }
+        if (positions.size() != op.getNumResults()) continue;
+        Operation* other = elseYield.getOperand(positions[0]).getDefiningOp();
+        if (!other || !isSameGate(&op, other)) continue;
+        if (!llvm::all_of(
+                llvm::zip(other->getResults(), positions),
+                [&](auto pair) {
+                    OpResult result = std::get<0>(pair);
+                    return result.hasOneUse()
+                           && elseYield.getOperand(std::get<1>(pair))
+                                  == result;
+                }))
+            continue;
+
+        OpBuilder builder(ifOp->getContext());
+        builder.setInsertionPointAfter(ifOp);
+        IRMapping map;
+        for (auto [qubit, position] : llvm::zip(op.getOperands(), positions))
+            map.map(qubit, ifOp.getResult(position));
+        mapParams(builder, ifOp.getCapturedArgs(), &op, map);
+        Operation* sunk = builder.clone(op, map);
+
+        for (auto [index, position] : llvm::enumerate(positions)) {
+            ifOp.getResult(position).replaceAllUsesExcept(
+                sunk->getResult(index),
+                sunk);
+            thenYield.setOperand(position, op.getOperand(index));
+            elseYield.setOperand(position, other->getOperand(index));
+        }
+        eraseGate(other);
+        eraseGate(&op);
+        return true;
+    }
+    return false;
+}
+
+/// Returns whether @p block only yields its arguments in order.
+bool isIdentity(Block* block)
+{
+    if (!block) return true;
+    YieldOp yield = getYield(block);
+    return &block->front() == yield
+           && llvm::equal(yield.getOperands(), block->getArguments());
+}
+
+/// Builds @p ControlledOp from @p control and the targets of the branch gate
+/// @p op at the insertion point of @p builder , maps the results of @p op in
+/// @p map and returns the new value of the control.
+template<class ControlledOp>
+Value buildControlled(
+    OpBuilder &builder,
+    Operation* op,
+    Value control,
+    IRMapping &map)
+{
+    SmallVector<Value> operands{control};
+    for (Value operand : op->getOperands())
+        operands.push_back(map.lookupOrDefault(operand));
+    const SmallVector<Type> types(1 + op->getNumResults(), control.getType());
+    Operation* gate =
+        builder.create<ControlledOp>(op->getLoc(), types, operands);
+    map.map(op->getResults(), gate->getResults().drop_front());
+    return gate->getResult(0);
+}
+
+/// Builds the version of the branch gate @p op controlled by @p control at
+/// the insertion point of @p builder , maps the results of @p op in @p map
+/// and returns the new value of the control.
+Value buildControlled(
+    OpBuilder &builder,
+    Operation* op,
+    Value control,
+    IRMapping &map)
+{
+    if (isa<XOp>(op))
+        return buildControlled<CNOTOp>(builder, op, control, map);
+    if (isa<ZOp>(op)) return buildControlled<CZOp>(builder, op, control, map);
+    if (isa<RzOp>(op))
+        return buildControlled<CRzOp>(builder, op, control, map);
+    if (isa<RyOp>(op))
+        return buildControlled<CRyOp>(builder, op, control, map);
+    if (isa<CNOTOp>(op))
+        return buildControlled<CCXOp>(builder, op, control, map);
+
+    // Y = S X Sdg, so the controlled Y conjugates a CNOT on the target.
+    const Location loc = op->getLoc();
+    const Type type = control.getType();
+    const Value target = map.lookupOrDefault(op->getOperand(0));
+    auto sdg = builder.create<SdgOp>(loc, type, target);
+    auto cnot = builder.create<CNOTOp>(
+        loc,
+        TypeRange{type, type},
+        ValueRange{control, sdg.getResult()});
+    auto s = builder.create<SOp>(loc, type, cnot->getResult(1));
+    map.map(op->getResult(0), s.getResult());
+    return cnot->getResult(0);
+}
+
+} // namespace
+
+/// Replaces @p ifOp , which applies its then branch if a qubit was measured
+/// as 1, by the controlled gates of that branch, and moves the measurement
+/// after them. Returns whether @p ifOp was replaced.
+bool QuantumDeferMeasurementPass::deferMeasurement(IfOp ifOp)
+{
+    auto measure = ifOp.getCondition().getDefiningOp<MeasureSingleOp>();
+    if (!measure || measure->getBlock() != ifOp->getBlock()
+        || !isIdentity(ifOp.elseBlock()))
+        return false;
+
+    // The outcome and the measured qubit must not be used before the gates
+    // they will be computed after.
+    Block* block = ifOp->getBlock();
+    for (Value value : measure->getResults()) {
+        for (OpOperand &use : value.getUses()) {
+            if (&use == &ifOp->getOpOperand(0)) continue;
+            Operation* ancestor =
+                block->findAncestorOpInBlock(*use.getOwner());
+            if (!ancestor || !ifOp->isBeforeInBlock(ancestor)) return false;
+        }
+    }
+
+    const Type type = measure.getInput().getType();
+    unsigned numGates = 0;
+    for (Operation &op : ifOp.thenBlock()->without_terminator()) {
+        if (op.hasTrait<OpTrait::ConstantLike>()) continue;
+        if (!isControllable(&op) || ++numGates > maxGates) return false;
+        for (Value qubit : op.getOperands().take_front(op.getNumResults()))
+            if (qubit.getType() != type) return false;
+    }
+
+    OpBuilder builder(ifOp);
+    IRMapping map;
+    map.map(ifOp.thenBlock()->getArguments(), ifOp.getCapturedArgs());
+    Value control = measure.getInput();
+    for (Operation &op : ifOp.thenBlock()->without_terminator()) {
+        if (op.hasTrait<OpTrait::ConstantLike>())
+            builder.clone(op, map);
+        else
+            control = buildControlled(builder, &op, control, map);
+    }
+    for (auto [result, yielded] :
+         llvm::zip(ifOp.getResults(), getYield(ifOp.thenBlock()).getOperands()))
+        result.replaceAllUsesWith(map.lookupOrDefault(yielded));
+
+    auto deferred = builder.create<MeasureSingleOp>(
+        measure.getLoc(),
+        measure.getMeasurement().getType(),
+        measure.getResult().getType(),
+        control);
+    ifOp.erase();
+    measure->replaceAllUsesWith(deferred);
+    measure.erase();
+    return true;
+}
+
+void QuantumDeferMeasurementPass::runOnOperation()
+{
+    // Inner quantum.if ops are visited first, so that hoisting out of them
+    // can make the outer ones simpler.
+    SmallVector<IfOp> ifOps;
+    getOperation()->walk([&](IfOp ifOp) { ifOps.push_back(ifOp); });
+
+    for (IfOp ifOp : ifOps) {
+        if (ifOp.elseBlock()) {
+            while (hoistLeadingGates(ifOp) || sinkTrailingGates(ifOp)) {}
+            if (isIdentity(ifOp.thenBlock()) && isIdentity(ifOp.elseBlock())) {
+                ifOp.replaceAllUsesWith(ifOp.getCapturedArgs());
+                ifOp.erase();
+                continue;
+            }
+        }
+        deferMeasurement(ifOp);
+    }
+}
+
+std::unique_ptr<Pass> mlir::quantum::createQuantumDeferMeasurementPass()
+{
+    return std::make_unique<QuantumDeferMeasurementPass>();
+}
@@ -0,0 +1,171 @@
+/// Implements the cost-driven inlining of custom gates.
+///
+/// @file
+
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/SymbolTable.h"
+#include "mlir/Pass/Pass.h"
+#include "quantum-mlir/Dialect/Quantum/IR/Quantum.h"
+#include "quantum-mlir/Dialect/Quantum/Transforms/Passes.h"
+
+#include <limits>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/SmallVector.h>
+
+using namespace mlir;
+using namespace mlir::quantum;
+
+//===- Generated includes -------------------------------------------------===//
+
+namespace mlir::quantum {
+
+#define GEN_PASS_DEF_QUANTUMINLINEGATES
+#include "quantum-mlir/Dialect/Quantum/Transforms/Passes.h.inc"
+
+} // namespace mlir::quantum
+
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+struct QuantumInlineGatesPass
+        : mlir::quantum::impl::QuantumInlineGatesBase<QuantumInlineGatesPass> {
+    using QuantumInlineGatesBase::QuantumInlineGatesBase;
+
+    void runOnOperation() override;
+};
+
+/// The cost of gates that cannot be expanded, i.e. of recursive ones.
+constexpr unsigned kUnbounded = std::numeric_limits<unsigned>::max();
+
+/// Computes the number of ops every gate expands to.
+class GateCosts {
+public:
+    explicit GateCosts(SymbolTable &symbolTable) : symbolTable(symbolTable) {}
+
+    /// Returns the gate called by @p call , or null if it is unknown.
+    GateOp getCallee(GateCallOp call)
+    {
+        return symbolTable.lookup<GateOp>(call.getCallee());
+    }
+
+    /// Returns the cost of @p gate , or kUnbounded if it is recursive.
+    unsigned getCost(GateOp gate)
+    {
+        auto [it, inserted] = costs.try_emplace(gate, kUnbounded);
+        // A gate that is still being visited is part of a cycle.
+        if (!inserted) return it->second;
+
+        unsigned cost = 0;
+        gate.getBody().walk([&](Operation* op) {
+            if (op->hasTrait<OpTrait::IsTerminator>())
+                return WalkResult::advance();
+            unsigned opCost = 1;
+            if (auto call = dyn_cast<GateCallOp>(op)) {
+                GateOp callee = getCallee(call);
+                opCost = callee ? getCost(callee) : kUnbounded;
+            }
+            if (opCost == kUnbounded || cost > kUnbounded - opCost - 1) {
+                cost = kUnbounded;
+                return WalkResult::interrupt();
+            }
+            cost += opCost;
+            return WalkResult::advance();
+        });
+        // The iterator may have been invalidated by nested gates.
+        costs[gate] = cost;
+        return cost;
+    }
+
+private:
+    SymbolTable &symbolTable;
+    DenseMap<Operation*, unsigned> costs;
+};
+
+/// Replaces @p call by a copy of the body of @p gate . The copied calls are
+/// appended to @p calls .
+void inlineCall(
+    GateCallOp call,
+    GateOp gate,
+    SmallVectorImpl<GateCallOp> &calls)
+{
+    Block &body = gate.getBody().front();
+    IRMapping mapping;
+    mapping.map(body.getArguments(), call.getOperands());
+
+    OpBuilder builder(call);
+    for (Operation &op : body.without_terminator()) {
+        Operation* clone = builder.clone(op, mapping);
+        // Keep the call site, as the MLIR inliner does, so that profiles
+        // still attribute the inlined gates to the call.
+        clone->walk([&](Operation* nested) {
+            nested->setLoc(CallSiteLoc::get(nested->getLoc(), call.getLoc()));
+            if (auto nestedCall = dyn_cast<GateCallOp>(nested))
+                calls.push_back(nestedCall);
+        });
+    }
+
+    SmallVector<Value> results;
+    for (Value result : body.getTerminator()->getOperands())
+        results.push_back(mapping.lookupOrDefault(result));
+    call.replaceAllUsesWith(results);
+    call.erase();
+}
+
+} // namespace
+
+void QuantumInlineGatesPass::runOnOperation()
+{
+    ModuleOp module = getOperation();
+    SymbolTable symbolTable(module);
+    GateCosts costs(symbolTable);
+
+    SmallVector<GateCallOp> calls;
+    DenseMap<Operation*, unsigned> numCalls;
+    module.walk([&](GateCallOp call) {
+        calls.push_back(call);
+        if (GateOp gate = costs.getCallee(call)) ++numCalls[gate];
+    });
+
+    bool changed = false;
+    while (!calls.empty()) {
+        GateCallOp call = calls.pop_back_val();
+        GateOp gate = costs.getCallee(call);
+        if (!gate || gate.getBody().empty()) continue;
+
+        // A gate with a single call does not grow the code when inlined.
+        const unsigned cost = costs.getCost(gate);
+        if (cost == kUnbounded || (cost > maxCost && numCalls[gate] != 1))
+            continue;
+
+        const std::size_t firstNested = calls.size();
+        inlineCall(call, gate, calls);
+        --numCalls[gate];
+        for (std::size_t i = firstNested; i < calls.size(); ++i)
+            if (GateOp callee = costs.getCallee(calls[i])) ++numCalls[callee];
+        changed = true;
+    }
+
+    if (!changed) return markAllAnalysesPreserved();
+
+    // Erase the gates whose calls are gone, and with them the calls they
+    // make, which may leave further gates without calls.
+    SmallVector<Operation*> dead;
+    for (auto [gate, count] : numCalls)
+        if (count == 0) dead.push_back(gate);
+    while (!dead.empty()) {
+        Operation* gate = dead.pop_back_val();
+        gate->walk([&](GateCallOp call) {
+            if (GateOp callee = costs.getCallee(call))
+                if (--numCalls[callee] == 0 && callee != gate)
+                    dead.push_back(callee);
+        });
+        symbolTable.erase(gate);
+    }
+}
+
+std::unique_ptr<Pass> mlir::quantum::createQuantumInlineGatesPass()
+{
+    return std::make_unique<QuantumInlineGatesPass>();
+}
@@ -7,8 +7,8 @@
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/PatternMatch.h"
 #include "mlir/Pass/Pass.h"
-#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
 #include "quantum-mlir/Dialect/Quantum/IR/Quantum.h"
+#include "quantum-mlir/Dialect/Quantum/Transforms/Passes.h"
 
 using namespace mlir;
 using namespace mlir::quantum;
@@ -53,10 +53,12 @@ struct DropPhaseBeforeMeasure : OpRewritePattern<ZOp> {
 
 void QuantumOptimisePass::runOnOperation()
 {
-    RewritePatternSet patterns(&getContext());
-    populateQuantumOptimisePatterns(patterns);
-    if (failed(applyPatternsGreedily(getOperation(), std::move(patterns))))
-        signalPassFailure();
+    PeepholeOptions options;
+    options.window = 0;
+    options.cancelInverses = false;
+    options.mergeRotations = false;
+    options.dropAllDiagonal = false;
+    applyPeephole(getOperation(), options);
 }
 
 void mlir::quantum::populateQuantumOptimisePatterns(RewritePatternSet &patterns)
@@ -0,0 +1,279 @@
+/// Implements the outlining of repeated subcircuits into custom gates.
+///
+/// @file
+
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/SymbolTable.h"
+#include "mlir/Pass/Pass.h"
+#include "quantum-mlir/Dialect/Quantum/IR/Quantum.h"
+#include "quantum-mlir/Dialect/Quantum/Transforms/Passes.h"
+#include "quantum-mlir/Support/StringKey.h"
+
+#include <cstdint>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/Hashing.h>
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringMap.h>
+#include <string>
+
+using namespace mlir;
+using namespace mlir::quantum;
+
+//===- Generated includes -------------------------------------------------===//
+
+namespace mlir::quantum {
+
+#define GEN_PASS_DEF_QUANTUMOUTLINEGATES
+#include "quantum-mlir/Dialect/Quantum/Transforms/Passes.h.inc"
+
+} // namespace mlir::quantum
+
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+struct QuantumOutlineGatesPass
+        : mlir::quantum::impl::QuantumOutlineGatesBase<
+              QuantumOutlineGatesPass> {
+    using QuantumOutlineGatesBase::QuantumOutlineGatesBase;
+
+    void runOnOperation() override;
+};
+
+/// Returns whether @p op is a gate that maps its qubit operands one to one to
+/// its results, which are then the next versions of the same qubits.
+bool isOutlinable(Operation* op)
+{
+    if (!isa<QuantumDialect>(op->getDialect()) || op->getNumRegions() != 0
+        || op->getNumResults() == 0)
+        return false;
+    if (!llvm::all_of(op->getResultTypes(), llvm::IsaPred<QubitType>))
+        return false;
+    return llvm::count_if(op->getOperandTypes(), llvm::IsaPred<QubitType>)
+           == op->getNumResults();
+}
+
+/// A window of consecutive gates in canonical form.
+///
+/// The qubits and classical values the window takes from outside are
+/// numbered in the order of their first use, so that two windows with the
+/// same form compute the same function of their inputs.
+struct Window {
+    /// The canonical form, which consists of op names, attributes, types
+    /// and operand numbers.
+    SmallVector<std::uintptr_t> form;
+    SmallVector<Value> qubits;
+    SmallVector<Value> classical;
+    /// The last version of every qubit, in the order of the qubits.
+    SmallVector<Value> results;
+
+    /// Analyses @p ops . Returns false if a value other than the last version
+    /// of a qubit is used after the window.
+    bool analyse(ArrayRef<Operation*> ops)
+    {
+        form.clear();
+        qubits.clear();
+        classical.clear();
+        results.clear();
+
+        // Maps the values of the window to their wire, i.e. their qubit.
+        DenseMap<Value, unsigned> wires;
+        DenseMap<Value, unsigned> classicalIds;
+        for (Operation* op : ops) {
+            form.push_back(
+                reinterpret_cast<std::uintptr_t>(
+                    op->getName().getAsOpaquePointer()));
+            // Includes the inherent attributes, e.g. the callee of a call.
+            form.push_back(
+                reinterpret_cast<std::uintptr_t>(
+                    op->getAttrDictionary().getAsOpaquePointer()));
+            form.push_back(op->getNumOperands());
+
+            unsigned result = 0;
+            for (Value operand : op->getOperands()) {
+                form.push_back(
+                    reinterpret_cast<std::uintptr_t>(
+                        operand.getType().getAsOpaquePointer()));
+                if (!isa<QubitType>(operand.getType())) {
+                    auto [it, inserted] =
+                        classicalIds.try_emplace(operand, classical.size());
+                    if (inserted) classical.push_back(operand);
+                    form.push_back(it->second);
+                    continue;
+                }
+                auto [it, inserted] = wires.try_emplace(operand, qubits.size());
+                if (inserted) {
+                    qubits.push_back(operand);
+                    results.push_back(operand);
+                }
+                const unsigned wire = it->second;
+                form.push_back(wire);
+                Value next = op->getResult(result++);
+                form.push_back(
+                    reinterpret_cast<std::uintptr_t>(
+                        next.getType().getAsOpaquePointer()));
+                wires.try_emplace(next, wire);
+                results[wire] = next;
+            }
+        }
+
+        // Qubit values are used once, but nothing in the IR enforces it.
+        const SmallPtrSet<Operation*, 8> inside(ops.begin(), ops.end());
+        for (Operation* op : ops)
+            for (Value value : op->getResults())
+                if (results[wires.lookup(value)] != value)
+                    for (Operation* user : value.getUsers())
+                        if (!inside.contains(user)) return false;
+        return true;
+    }
+
+    /// Returns the hash of the canonical form.
+    llvm::hash_code hash() const
+    {
+        return llvm::hash_combine_range(form.begin(), form.end());
+    }
+
+    /// Returns the canonical form as a key of a string map.
+    StringRef key() const { return quantum::getStringKey(form); }
+};
+
+/// Returns the maximal runs of consecutive outlinable ops in @p root .
+SmallVector<SmallVector<Operation*>> collectRuns(Operation* root)
+{
+    SmallVector<SmallVector<Operation*>> runs;
+    root->walk([&](Block* block) {
+        SmallVector<Operation*> run;
+        for (Operation &op : *block) {
+            if (isOutlinable(&op)) {
+                run.push_back(&op);
+                continue;
+            }
+            if (!run.empty()) runs.push_back(std::move(run));
+            run.clear();
+        }
+        if (!run.empty()) runs.push_back(std::move(run));
+    });
+    return runs;
+}
+
+/// Creates a gate that computes @p window .
+GateOp createGate(
+    OpBuilder &builder,
+    Location loc,
+    StringRef name,
+    ArrayRef<Operation*> ops,
+    const Window &window)
+{
+    SmallVector<Type> inputs, outputs;
+    for (Value value : window.qubits) inputs.push_back(value.getType());
+    for (Value value : window.classical) inputs.push_back(value.getType());
+    for (Value value : window.results) outputs.push_back(value.getType());
+
+    auto gate = builder.create<GateOp>(
+        loc,
+        name,
+        builder.getFunctionType(inputs, outputs));
+    Block* body = builder.createBlock(&gate.getBody());
+    IRMapping mapping;
+    for (Value value : window.qubits)
+        mapping.map(value, body->addArgument(value.getType(), value.getLoc()));
+    for (Value value : window.classical)
+        mapping.map(value, body->addArgument(value.getType(), value.getLoc()));
+
+    for (Operation* op : ops) builder.clone(*op, mapping);
+    SmallVector<Value> results;
+    for (Value value : window.results) results.push_back(mapping.lookup(value));
+    builder.create<ReturnOp>(loc, results);
+    return gate;
+}
+
+/// Replaces the ops of @p window by a call of @p gate .
+void replaceByCall(GateOp gate, ArrayRef<Operation*> ops, const Window &window)
+{
+    SmallVector<Value> operands(window.qubits);
+    operands.append(window.classical);
+
+    OpBuilder builder(ops.front());
+    auto call =
+        builder.create<GateCallOp>(ops.front()->getLoc(), gate, operands);
+    for (auto [value, result] :
+         llvm::zip_equal(window.results, call.getResults()))
+        value.replaceAllUsesWith(result);
+    for (Operation* op : llvm::reverse(ops)) op->erase();
+}
+
+} // namespace
+
+void QuantumOutlineGatesPass::runOnOperation()
+{
+    ModuleOp module = getOperation();
+    const unsigned size = windowSize;
+    if (size < 2 || minRepeats < 2) return markAllAnalysesPreserved();
+
+    // Count the forms of all windows in one pass over the module.
+    auto runs = collectRuns(module);
+    SmallVector<SmallVector<llvm::hash_code>> hashes(runs.size());
+    DenseMap<llvm::hash_code, unsigned> counts;
+    Window window;
+    for (auto [run, runHashes] : llvm::zip_equal(runs, hashes)) {
+        for (std::size_t begin = 0; begin + size <= run.size(); ++begin) {
+            const bool valid =
+                window.analyse(ArrayRef(run).slice(begin, size));
+            // Invalid windows are marked by a zero hash and never chosen.
+            runHashes.push_back(valid ? window.hash() : llvm::hash_code(0));
+            if (valid) ++counts[runHashes.back()];
+        }
+    }
+
+    // Choose non-overlapping occurrences of repeated forms, and group them by
+    // their exact form, which also separates hash collisions.
+    llvm::StringMap<SmallVector<ArrayRef<Operation*>>> groups;
+    SmallVector<std::string> order;
+    for (auto [run, runHashes] : llvm::zip_equal(runs, hashes)) {
+        for (std::size_t begin = 0; begin < runHashes.size();) {
+            const llvm::hash_code hash = runHashes[begin];
+            if (hash == llvm::hash_code(0) || counts[hash] < minRepeats) {
+                ++begin;
+                continue;
+            }
+            const auto ops = ArrayRef(run).slice(begin, size);
+            window.analyse(ops);
+            auto [it, inserted] = groups.try_emplace(window.key());
+            if (inserted) order.push_back(it->first().str());
+            it->second.push_back(ops);
+            begin += size;
+        }
+    }
+
+    SymbolTable symbolTable(module);
+    OpBuilder builder(module.getBodyRegion());
+    unsigned numOutlined = 0;
+    for (const std::string &form : order) {
+        const auto &occurrences = groups.find(form)->second;
+        if (occurrences.size() < minRepeats) continue;
+
+        // Calls of earlier gates may have replaced the inputs, so every
+        // occurrence is analysed again right before it is replaced.
+        window.analyse(occurrences.front());
+        builder.setInsertionPointToStart(module.getBody());
+        GateOp gate = createGate(
+            builder,
+            occurrences.front().front()->getLoc(),
+            "outlined_" + std::to_string(numOutlined++),
+            occurrences.front(),
+            window);
+        symbolTable.insert(gate);
+        for (ArrayRef<Operation*> ops : occurrences) {
+            window.analyse(ops);
+            replaceByCall(gate, ops, window);
+        }
+    }
+    if (numOutlined == 0) markAllAnalysesPreserved();
+}
+
+std::unique_ptr<Pass> mlir::quantum::createQuantumOutlineGatesPass()
+{
+    return std::make_unique<QuantumOutlineGatesPass>();
+}
@@ -7,11 +7,10 @@
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/PatternMatch.h"
 #include "mlir/Pass/Pass.h"
-#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
 #include "quantum-mlir/Dialect/Quantum/IR/Quantum.h"
 #include "quantum-mlir/Dialect/Quantum/Transforms/Passes.h"
 
-#include <algorithm>
+#include <llvm/ADT/STLExtras.h>
 
 using namespace mlir;
 using namespace mlir::quantum;
@@ -37,27 +36,26 @@ struct HermitianCancelPass
 };
 
 /// Pattern: Cancel double Hermitian ops
+///
+/// Both ops must act on the same qubits in the same order, i.e. result i of
+/// the inner op is operand i of the outer op and has no other use.
 struct FoldDoubleHermitian : OpTraitRewritePattern<Hermitian> {
     using OpTraitRewritePattern::OpTraitRewritePattern;
 
     LogicalResult
     matchAndRewrite(Operation* op, PatternRewriter &rewriter) const override
     {
-        bool isSame = std::all_of(
-            op->getOperands().begin(),
-            op->getOperands().end(),
-            [&](auto operand) {
-                auto inner = operand.getDefiningOp();
-                return inner && inner->template hasTrait<Hermitian>()
-                       && inner->getName() == op->getName();
-            });
-
-        if (isSame) {
-            auto inner = op->getOperand(0).getDefiningOp();
-            rewriter.replaceOp(op, inner->getOperands());
-            return success();
-        }
-        return failure();
+        auto inner = op->getOperand(0).getDefiningOp();
+        if (!inner || inner->getName() != op->getName()
+            || inner->getNumResults() != op->getNumOperands())
+            return failure();
+
+        for (auto [result, operand] :
+             llvm::zip(inner->getResults(), op->getOperands()))
+            if (operand != result || !result.hasOneUse()) return failure();
+
+        rewriter.replaceOp(op, inner->getOperands());
+        return success();
     }
 };
 
@@ -65,10 +63,12 @@ struct FoldDoubleHermitian : OpTraitRewritePattern<Hermitian> {
 
 void HermitianCancelPass::runOnOperation()
 {
-    RewritePatternSet patterns(&getContext());
-    populateHermitianCancelPatterns(patterns);
-    if (failed(applyPatternsGreedily(getOperation(), std::move(patterns))))
-        signalPassFailure();
+    PeepholeOptions options;
+    options.window = 0;
+    options.cancelPhasePairs = false;
+    options.mergeRotations = false;
+    options.dropPhases = false;
+    applyPeephole(getOperation(), options);
 }
 
 void mlir::quantum::populateHermitianCancelPatterns(RewritePatternSet &patterns)
@@ -0,0 +1,259 @@
+/// Implements the single-pass peephole engine.
+///
+/// @file
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+#include "mlir/Pass/Pass.h"
+#include "quantum-mlir/Dialect/Quantum/IR/Quantum.h"
+#include "quantum-mlir/Dialect/Quantum/Transforms/Commutation.h"
+#include "quantum-mlir/Dialect/Quantum/Transforms/Passes.h"
+
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/ADT/SetVector.h>
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/SmallVector.h>
+
+using namespace mlir;
+using namespace mlir::quantum;
+
+//===- Generated includes -------------------------------------------------===//
+
+namespace mlir::quantum {
+
+#define GEN_PASS_DEF_QUANTUMPEEPHOLE
+#include "quantum-mlir/Dialect/Quantum/Transforms/Passes.h.inc"
+
+} // namespace mlir::quantum
+
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+struct QuantumPeepholePass
+        : mlir::quantum::impl::QuantumPeepholeBase<QuantumPeepholePass> {
+    using QuantumPeepholeBase::QuantumPeepholeBase;
+
+    void runOnOperation() override;
+};
+
+/// Returns whether @p op is a single-qubit gate the engine rewrites.
+bool isSingleQubitGate(Operation* op)
+{
+    return isa<
+        HOp,
+        XOp,
+        YOp,
+        ZOp,
+        SOp,
+        SdgOp,
+        TOp,
+        TdgOp,
+        RxOp,
+        RyOp,
+        RzOp,
+        U1Op>(op);
+}
+
+/// Rewrites the gates of a block in a single walk.
+///
+/// Every op is visited once, after the ops defining its qubits, and only
+/// looks back along its qubits. Erasing a gate makes the gates before it the
+/// predecessors of the gates after it, which are still to be visited, so no
+/// op is ever revisited.
+class Peephole {
+public:
+    explicit Peephole(const PeepholeOptions &options) : options(options) {}
+
+    void run(Block &block)
+    {
+        for (Operation &op : llvm::make_early_inc_range(block)) visit(&op);
+
+        // Angles that lost their users are erased once the walk is done, as
+        // they may follow the op being visited in graph regions. An angle
+        // that is still used is checked again when its users are erased.
+        SmallVector<Operation*> worklist = deadAngles.takeVector();
+        llvm::SmallPtrSet<Operation*, 16> erased;
+        while (!worklist.empty()) {
+            Operation* def = worklist.pop_back_val();
+            if (erased.contains(def) || !isOpTriviallyDead(def)) continue;
+            for (Value operand : def->getOperands())
+                if (Operation* inner = operand.getDefiningOp())
+                    worklist.push_back(inner);
+            erased.insert(def);
+            def->erase();
+        }
+    }
+
+private:
+    void visit(Operation* op)
+    {
+        if (isa<MeasureOp, MeasureSingleOp>(op)) {
+            if (options.dropPhases) dropPhases(op);
+            return;
+        }
+
+        if (isSingleQubitGate(op)) {
+            if (isRotation(op) && options.mergeRotations
+                && isZero(op->getOperand(1))) {
+                erase(op);
+                return;
+            }
+            Operation* prev = findPartner(op);
+            if (!prev) return;
+            if (isRotation(op)) {
+                merge(prev, op);
+                return;
+            }
+            erase(op);
+            erase(prev);
+            return;
+        }
+
+        if (options.cancelInverses && op->hasTrait<Hermitian>())
+            if (Operation* prev = findInverse(op)) {
+                erase(op);
+                erase(prev);
+            }
+    }
+
+    /// Returns whether the single-qubit gate @p op can be rewritten together
+    /// with the earlier @p prev .
+    bool isPartner(Operation* prev, Operation* op) const
+    {
+        if (isRotation(op))
+            return options.mergeRotations && prev->getName() == op->getName();
+        return options.cancelInverses && isInversePair(prev, op)
+               && (options.cancelPhasePairs
+                   || prev->getName() == op->getName());
+    }
+
+    /// Returns the closest gate before the single-qubit gate @p op on its
+    /// qubit that it can be rewritten with, looking through at most `window`
+    /// gates that commute with @p op .
+    Operation* findPartner(Operation* op) const
+    {
+        const PauliAxis axis = getAxis(op);
+        Value qubit = op->getOperand(0);
+        for (unsigned step = 0; step <= options.window; ++step) {
+            auto result = dyn_cast<OpResult>(qubit);
+            if (!result || !result.hasOneUse()) return nullptr;
+            Operation* def = result.getOwner();
+            if (def->getBlock() != op->getBlock()) return nullptr;
+            if (isPartner(def, op)) return def;
+            const unsigned index = result.getResultNumber();
+            if (axis == PauliAxis::None || getAxis(def, index) != axis)
+                return nullptr;
+            qubit = def->getOperand(index);
+        }
+        return nullptr;
+    }
+
+    /// Returns the gate right before @p op on all of its qubits if it is the
+    /// inverse of @p op .
+    Operation* findInverse(Operation* op) const
+    {
+        auto first = dyn_cast<OpResult>(op->getOperand(0));
+        if (!first) return nullptr;
+        Operation* prev = first.getOwner();
+        if (prev->getNumResults() != op->getNumResults()
+            || !isInversePair(prev, op))
+            return nullptr;
+        for (auto [result, operand] :
+             llvm::zip(prev->getResults(), op->getOperands()))
+            if (operand != result || !result.hasOneUse()) return nullptr;
+        return prev;
+    }
+
+    /// Folds the angle of the rotation @p prev into the rotation @p op of the
+    /// same kind, and erases @p prev .
+    void merge(Operation* prev, Operation* op)
+    {
+        OpBuilder builder(op);
+        const Value lhs = prev->getOperand(1);
+        const Value rhs = op->getOperand(1);
+        Value angle;
+        if (const FloatAttr sum = addConstantAngles(
+                getConstantFloat(lhs),
+                getConstantFloat(rhs))) {
+            angle = builder.create<arith::ConstantOp>(op->getLoc(), sum);
+        } else {
+            angle = builder.create<arith::AddFOp>(op->getLoc(), lhs, rhs);
+        }
+
+        op->setOperand(1, angle);
+        dropAngle(rhs);
+        erase(prev);
+        if (isZero(angle)) erase(op);
+    }
+
+    /// Erases the diagonal gates right before the measurement @p measure ,
+    /// which cannot change its outcome.
+    void dropPhases(Operation* measure)
+    {
+        // Every step erases a gate, so this is linear over the whole walk.
+        while (Operation* def = measure->getOperand(0).getDefiningOp()) {
+            if (def->getBlock() != measure->getBlock()
+                || !isSingleQubitGate(def) || getAxis(def) != PauliAxis::Z
+                || (!options.dropAllDiagonal && !isa<ZOp>(def))
+                || !def->getResult(0).hasOneUse())
+                return;
+            erase(def);
+        }
+    }
+
+    /// Replaces the qubits @p gate produces with the ones it consumes, and
+    /// erases it.
+    void erase(Operation* gate)
+    {
+        for (auto [result, operand] :
+             llvm::zip(gate->getResults(), gate->getOperands()))
+            result.replaceAllUsesWith(operand);
+        const auto angles = llvm::to_vector(
+            gate->getOperands().drop_front(gate->getNumResults()));
+        gate->erase();
+        for (Value angle : angles) dropAngle(angle);
+    }
+
+    /// Records that @p angle lost a user.
+    void dropAngle(Value angle)
+    {
+        if (Operation* def = angle.getDefiningOp()) deadAngles.insert(def);
+    }
+
+    static bool isZero(Value angle)
+    {
+        const FloatAttr value = getConstantFloat(angle);
+        return value && value.getValue().isZero();
+    }
+
+    const PeepholeOptions &options;
+    llvm::SetVector<Operation*> deadAngles;
+};
+
+} // namespace
+
+void mlir::quantum::applyPeephole(
+    Operation* root,
+    const PeepholeOptions &options)
+{
+    SmallVector<Block*> blocks;
+    root->walk([&](Block* block) { blocks.push_back(block); });
+
+    Peephole peephole(options);
+    for (Block* block : blocks) peephole.run(*block);
+}
+
+void QuantumPeepholePass::runOnOperation()
+{
+    PeepholeOptions options;
+    options.window = window;
+    applyPeephole(getOperation(), options);
+}
+
+std::unique_ptr<Pass> mlir::quantum::createQuantumPeepholePass()
+{
+    return std::make_unique<QuantumPeepholePass>();
+}
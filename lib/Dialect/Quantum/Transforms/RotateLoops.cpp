@@ -0,0 +1,151 @@
+/// Implements the rotation of quantum.for loops.
+///
+/// @file
+
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Pass/Pass.h"
+#include "quantum-mlir/Dialect/Quantum/IR/Quantum.h"
+#include "quantum-mlir/Dialect/Quantum/Transforms/Commutation.h"
+#include "quantum-mlir/Dialect/Quantum/Transforms/Passes.h"
+
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/ADT/SmallVector.h>
+
+using namespace mlir;
+using namespace mlir::quantum;
+
+//===- Generated includes -------------------------------------------------===//
+
+namespace mlir::quantum {
+
+#define GEN_PASS_DEF_QUANTUMROTATELOOPS
+#include "quantum-mlir/Dialect/Quantum/Transforms/Passes.h.inc"
+
+} // namespace mlir::quantum
+
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+struct QuantumRotateLoopsPass
+        : mlir::quantum::impl::QuantumRotateLoopsBase<QuantumRotateLoopsPass> {
+    using QuantumRotateLoopsBase::QuantumRotateLoopsBase;
+
+    void runOnOperation() override;
+};
+
+/// Returns whether @p lhs followed by @p rhs is the identity, including
+/// rotations by opposite constant angles.
+bool isInverse(Operation* lhs, Operation* rhs)
+{
+    if (isInversePair(lhs, rhs)) return true;
+    return isRotation(lhs) && lhs->getName() == rhs->getName()
+           && anglesCancel(lhs->getOperand(1), rhs->getOperand(1));
+}
+
+/// Returns the position of the captured value that the body argument
+/// @p qubit of a quantum.for receives.
+unsigned getPosition(Value qubit)
+{
+    return cast<BlockArgument>(qubit).getArgNumber() - 1;
+}
+
+/// Peels a gate that the body of @p loop starts with off before the loop, and
+/// its inverse that the body ends with off after the loop. Returns whether a
+/// pair was peeled off.
+bool rotate(ForOp loop)
+{
+    Block* body = loop.getBody();
+    auto yield = cast<YieldOp>(body->getTerminator());
+
+    // Params must be available outside of the loop, with the same value in
+    // every iteration.
+    const auto isInvariant = [&](Value param) {
+        if (auto arg = dyn_cast<BlockArgument>(param))
+            return arg != loop.getInductionVar()
+                   && yield.getOperand(getPosition(arg)) == arg;
+        return matchPattern(param, m_Constant());
+    };
+
+    for (Operation &head : body->without_terminator()) {
+        if (!isPrimitiveGate(&head)) continue;
+        const auto qubits = head.getOperands().take_front(head.getNumResults());
+        if (!llvm::all_of(qubits, llvm::IsaPred<BlockArgument>)
+            || !llvm::all_of(
+                head.getOperands().drop_front(head.getNumResults()),
+                isInvariant))
+            continue;
+
+        // The inverse must be the last gate on the same qubits, and yield
+        // them at the positions they were captured at.
+        Operation* tail =
+            yield.getOperand(getPosition(qubits[0])).getDefiningOp();
+        if (!tail || tail == &head
+            || tail->getNumResults() != head.getNumResults()
+            || !isInverse(tail, &head)
+            || !llvm::all_of(
+                tail->getOperands().drop_front(tail->getNumResults()),
+                isInvariant))
+            continue;
+        if (!llvm::all_of(
+                llvm::zip(qubits, tail->getResults()),
+                [&](auto pair) {
+                    OpResult result = std::get<1>(pair);
+                    return result.hasOneUse()
+                           && yield.getOperand(getPosition(std::get<0>(pair)))
+                                  == result;
+                }))
+            continue;
+
+        OpBuilder builder(loop);
+        IRMapping headMap;
+        for (Value qubit : qubits)
+            headMap.map(qubit, loop.getCapturedArgs()[getPosition(qubit)]);
+        mapParams(builder, loop.getCapturedArgs(), &head, headMap);
+        Operation* peeledHead = builder.clone(head, headMap);
+
+        builder.setInsertionPointAfter(loop);
+        IRMapping tailMap;
+        for (auto [qubit, operand] : llvm::zip(qubits, tail->getOperands()))
+            tailMap.map(operand, loop.getResult(getPosition(qubit)));
+        mapParams(builder, loop.getCapturedArgs(), tail, tailMap);
+        Operation* peeledTail = builder.clone(*tail, tailMap);
+
+        for (auto [index, qubit] : llvm::enumerate(qubits)) {
+            const unsigned position = getPosition(qubit);
+            loop.getCapturedArgsMutable()[position].set(
+                peeledHead->getResult(index));
+            loop.getResult(position).replaceAllUsesExcept(
+                peeledTail->getResult(index),
+                peeledTail);
+            yield.setOperand(position, tail->getOperand(index));
+        }
+        eraseGate(tail);
+        for (auto [result, qubit] : llvm::zip(head.getResults(), qubits))
+            result.replaceAllUsesWith(qubit);
+        eraseGate(&head);
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+void QuantumRotateLoopsPass::runOnOperation()
+{
+    // Inner loops are visited first, so that the gates peeled off them can
+    // be peeled off the outer loops.
+    SmallVector<ForOp> loops;
+    getOperation()->walk([&](ForOp loop) { loops.push_back(loop); });
+
+    for (ForOp loop : loops)
+        while (rotate(loop)) {}
+}
+
+std::unique_ptr<Pass> mlir::quantum::createQuantumRotateLoopsPass()
+{
+    return std::make_unique<QuantumRotateLoopsPass>();
+}
@@ -140,6 +140,73 @@ struct TransformScfIfOp : public OpConversionPattern<scf::IfOp> {
     }
 };
 
+struct TransformScfForOp : public OpConversionPattern<scf::ForOp> {
+    using OpConversionPattern<scf::ForOp>::OpConversionPattern;
+
+    LogicalResult matchAndRewrite(
+        scf::ForOp op,
+        scf::ForOpAdaptor adaptor,
+        ConversionPatternRewriter &rewriter) const override
+    {
+        if (!op.getInductionVar().getType().isIndex())
+            return rewriter.notifyMatchFailure(op, "expected index bounds");
+
+        // The loop-carried values are followed by the classical values
+        // defined above, which every iteration yields unchanged.
+        SetVector<Value> capturedValues;
+        mlir::getUsedValuesDefinedAbove(
+            op.getRegion(),
+            op.getRegion(),
+            capturedValues);
+
+        // A qubit from above would be consumed again by every iteration, and
+        // only loop-carried qubits may change from one iteration to the next.
+        if (llvm::any_of(capturedValues, [](Value value) {
+                return llvm::isa<quantum::QubitType>(value.getType());
+            }))
+            return rewriter.notifyMatchFailure(
+                op,
+                "qubits used in the body must be iteration arguments");
+
+        auto capturedValueList = llvm::to_vector(adaptor.getInitArgs());
+        capturedValueList.append(capturedValues.begin(), capturedValues.end());
+
+        auto genOp = rewriter.create<quantum::ForOp>(
+            op.getLoc(),
+            adaptor.getLowerBound(),
+            adaptor.getUpperBound(),
+            adaptor.getStep(),
+            capturedValueList,
+            [](OpBuilder &, Location, Value, ValueRange) {});
+
+        Block* body = genOp.getBody();
+        const unsigned numLoopArgs = 1 + op.getNumRegionIterArgs();
+        const auto capturedArgs = body->getArguments().drop_front(numLoopArgs);
+        for (auto [captured, arg] :
+             llvm::zip_equal(capturedValues, capturedArgs))
+            rewriter.replaceUsesWithIf(captured, arg, [&](OpOperand &use) {
+                return op->isProperAncestor(use.getOwner());
+            });
+
+        auto yield = cast<scf::YieldOp>(op.getBody()->getTerminator());
+        auto yielded = llvm::to_vector<4>(yield.getOperands());
+        yielded.append(capturedArgs.begin(), capturedArgs.end());
+
+        rewriter.mergeBlocks(
+            op.getBody(),
+            body,
+            body->getArguments().take_front(numLoopArgs));
+        rewriter.setInsertionPointToEnd(body);
+        rewriter.create<quantum::YieldOp>(yield.getLoc(), yielded);
+        rewriter.eraseOp(yield);
+
+        rewriter.replaceOp(
+            op,
+            genOp.getResults().take_front(op.getNumResults()));
+        return success();
+    }
+};
+
 } // namespace
 
 void ScfToRVSDGPass::runOnOperation()
@@ -185,6 +252,20 @@ void ScfToRVSDGPass::runOnOperation()
         }
         return isLegal;
     });
+    // Only allow scf::ForOp with classic operands
+    target.addDynamicallyLegalOp<scf::ForOp>([](scf::ForOp op) {
+        bool isLegal = llvm::none_of(
+            op.getInitArgs().getTypes(),
+            llvm::IsaPred<quantum::QubitType>);
+        mlir::visitUsedValuesDefinedAbove(
+            op.getRegion(),
+            op.getRegion(),
+            [&](OpOperand* operand) {
+                if (llvm::isa<quantum::QubitType>(operand->get().getType()))
+                    isLegal = false;
+            });
+        return isLegal;
+    });
     // Only allow scf::YieldOp with classic operands
     target.addDynamicallyLegalOp<scf::YieldOp>([](scf::YieldOp op) {
         for (auto result : op.getOperands())
@@ -207,7 +288,9 @@ void mlir::quantum::populateScfToRVSDGPatterns(
     TypeConverter converter,
     RewritePatternSet &patterns)
 {
-    patterns.add<TransformScfIfOp>(converter, patterns.getContext());
+    patterns.add<TransformScfIfOp, TransformScfForOp>(
+        converter,
+        patterns.getContext());
 }
 
 std::unique_ptr<Pass> mlir::quantum::createScfToRVSDGPass()
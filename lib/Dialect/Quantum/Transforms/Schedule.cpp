@@ -0,0 +1,290 @@
+/// Implements the scheduling of gates.
+///
+/// @file
+
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/RegionKindInterface.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+#include "mlir/Pass/Pass.h"
+#include "quantum-mlir/Dialect/Quantum/IR/Quantum.h"
+#include "quantum-mlir/Dialect/Quantum/Transforms/Commutation.h"
+#include "quantum-mlir/Dialect/Quantum/Transforms/Passes.h"
+
+#include <algorithm>
+#include <functional>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/ADT/SmallVector.h>
+#include <queue>
+#include <utility>
+
+using namespace mlir;
+using namespace mlir::quantum;
+
+//===- Generated includes -------------------------------------------------===//
+
+namespace mlir::quantum {
+
+#define GEN_PASS_DEF_QUANTUMSCHEDULE
+#include "quantum-mlir/Dialect/Quantum/Transforms/Passes.h.inc"
+
+} // namespace mlir::quantum
+
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+struct QuantumSchedulePass
+        : mlir::quantum::impl::QuantumScheduleBase<QuantumSchedulePass> {
+    using QuantumScheduleBase::QuantumScheduleBase;
+
+    LogicalResult initialize(MLIRContext* context) override;
+    void runOnOperation() override;
+
+private:
+    void scheduleBlock(Block &block);
+
+    bool fusion = false;
+    bool alap = false;
+};
+
+/// Returns whether @p op may be reordered with the ops around it.
+bool isSchedulable(Operation* op)
+{
+    if (op->getNumRegions() != 0 || op->hasTrait<OpTrait::IsTerminator>())
+        return false;
+    // Primitive gates only act on their qubits, even where they lack the
+    // trait, like SWAP.
+    return isMemoryEffectFree(op) || isPrimitiveGate(op);
+}
+
+/// Returns whether @p op produces qubits, i.e. occupies a layer.
+bool occupiesLayer(Operation* op)
+{
+    return llvm::any_of(op->getResultTypes(), llvm::IsaPred<QubitType>);
+}
+
+/// The side-effect free ops of a block between two ops with effects.
+class Segment {
+public:
+    explicit Segment(ArrayRef<Operation*> ops) : ops(ops) {}
+
+    /// Assigns the ASAP layers, after moving every single-qubit gate ahead
+    /// of up to @p window gates it commutes with if that lowers its layer.
+    void assignLayers(unsigned window)
+    {
+        for (Operation* op : ops) {
+            if (window != 0) hoist(op, window);
+            layers[op] = getLayer(op);
+        }
+    }
+
+    /// Replaces the layers by the ALAP layers, which keep the depth.
+    void assignLatestLayers()
+    {
+        unsigned depth = 0;
+        for (Operation* op : ops) depth = std::max(depth, layers[op]);
+
+        // Users have a greater ASAP layer, or the same one and a greater
+        // position if they are classical, so they are visited first.
+        llvm::DenseMap<Operation*, unsigned> latest;
+        for (Operation* op : llvm::reverse(sortByLayer())) {
+            unsigned layer = depth;
+            for (Operation* user : op->getUsers())
+                if (auto it = latest.find(user); it != latest.end())
+                    layer = std::min(
+                        layer,
+                        it->second - occupiesLayer(user));
+            latest[op] = layer;
+        }
+        layers = std::move(latest);
+    }
+
+    /// Returns the ops by increasing layer, and in their original order
+    /// within a layer.
+    SmallVector<Operation*> sortByLayer() const
+    {
+        SmallVector<Operation*> order(ops);
+        llvm::stable_sort(order, [&](Operation* lhs, Operation* rhs) {
+            return layers.lookup(lhs) < layers.lookup(rhs);
+        });
+        return order;
+    }
+
+    /// Returns the ops in runs of gates acting on the qubits of the run.
+    SmallVector<Operation*> sortByRuns() const
+    {
+        llvm::DenseMap<Operation*, unsigned> positions;
+        for (auto [position, op] : llvm::enumerate(ops))
+            positions[op] = position;
+
+        // The number of operands every op still waits for.
+        llvm::DenseMap<Operation*, unsigned> pending;
+        for (Operation* op : ops) {
+            unsigned count = 0;
+            for (Value operand : op->getOperands())
+                if (positions.contains(operand.getDefiningOp())) ++count;
+            pending[op] = count;
+        }
+
+        using Entry = std::pair<unsigned, unsigned>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> ready;
+        llvm::DenseMap<Operation*, unsigned> runs;
+        SmallVector<Operation*> chain;
+        unsigned run = 0;
+
+        // Returns whether all qubits of @p op were last touched by the run.
+        const auto continuesRun = [&](Operation* op) {
+            return llvm::all_of(op->getOperands(), [&](Value operand) {
+                if (!isa<QubitType>(operand.getType())) return true;
+                auto it = runs.find(operand.getDefiningOp());
+                return it != runs.end() && it->second == run;
+            });
+        };
+        const auto schedule = [&](Operation* op) {
+            // Classical ops never delay a run, so they are emitted at once.
+            if (!occupiesLayer(op) || continuesRun(op))
+                chain.push_back(op);
+            else
+                ready.emplace(layers.lookup(op), positions.lookup(op));
+        };
+
+        SmallVector<Operation*> order;
+        order.reserve(ops.size());
+        const auto emitChain = [&] {
+            while (!chain.empty()) {
+                Operation* op = chain.pop_back_val();
+                order.push_back(op);
+                runs[op] = run;
+                for (Operation* user : op->getUsers()) {
+                    auto it = pending.find(user);
+                    if (it != pending.end() && --it->second == 0)
+                        schedule(user);
+                }
+            }
+        };
+
+        for (Operation* op : ops)
+            if (pending.lookup(op) == 0) schedule(op);
+        emitChain();
+        while (!ready.empty()) {
+            chain.push_back(ops[ready.top().second]);
+            ready.pop();
+            ++run;
+            emitChain();
+        }
+        return order;
+    }
+
+private:
+    /// Returns the layer of the op defining @p value , which is 0 outside of
+    /// the segment.
+    unsigned getLayer(Value value) const
+    {
+        if (Operation* def = value.getDefiningOp()) return layers.lookup(def);
+        return 0;
+    }
+
+    /// Returns the ASAP layer of @p op from the layers of its operands.
+    unsigned getLayer(Operation* op) const
+    {
+        unsigned layer = 0;
+        for (Value operand : op->getOperands())
+            layer = std::max(layer, getLayer(operand));
+        return layer + occupiesLayer(op);
+    }
+
+    /// Moves the single-qubit gate @p gate ahead of the gates before it on its
+    /// qubit that it commutes with, as long as it then fits into an earlier
+    /// layer than theirs. Their layers do not change, as they depend on an
+    /// earlier gate on another qubit.
+    void hoist(Operation* gate, unsigned window)
+    {
+        const PauliAxis axis = getAxis(gate);
+        if (axis == PauliAxis::None) return;
+
+        unsigned params = 0;
+        for (Value operand : gate->getOperands().drop_front())
+            params = std::max(params, getLayer(operand));
+
+        for (unsigned step = 0; step < window; ++step) {
+            auto result = dyn_cast<OpResult>(gate->getOperand(0));
+            if (!result || !result.hasOneUse()) return;
+            Operation* prev = result.getOwner();
+            auto it = layers.find(prev);
+            if (it == layers.end()) return;
+            const unsigned index = result.getResultNumber();
+            if (getAxis(prev, index) != axis) return;
+            const Value input = prev->getOperand(index);
+            if (std::max(getLayer(input), params) + 1 >= it->second) return;
+
+            gate->getResult(0).replaceAllUsesWith(result);
+            gate->setOperand(0, input);
+            prev->setOperand(index, gate->getResult(0));
+        }
+    }
+
+    SmallVector<Operation*> ops;
+    llvm::DenseMap<Operation*, unsigned> layers;
+};
+
+} // namespace
+
+LogicalResult QuantumSchedulePass::initialize(MLIRContext* context)
+{
+    auto emitError = [&]() {
+        return mlir::emitError(UnknownLoc::get(context));
+    };
+
+    if (objective != "depth" && objective != "fusion")
+        return emitError() << "unknown scheduling objective '" << objective
+                           << "', expected 'depth' or 'fusion'";
+    if (layering != "asap" && layering != "alap")
+        return emitError() << "unknown layering '" << layering
+                           << "', expected 'asap' or 'alap'";
+
+    fusion = objective == "fusion";
+    alap = layering == "alap";
+    return success();
+}
+
+void QuantumSchedulePass::scheduleBlock(Block &block)
+{
+    SmallVector<Operation*> ops;
+    const auto flush = [&](Block::iterator end) {
+        if (ops.size() > 1) {
+            Segment segment(ops);
+            segment.assignLayers(fusion ? 0 : window);
+            if (alap) segment.assignLatestLayers();
+            for (Operation* op :
+                 fusion ? segment.sortByRuns() : segment.sortByLayer())
+                op->moveBefore(&block, end);
+        }
+        ops.clear();
+    };
+
+    for (Operation &op : block) {
+        if (isSchedulable(&op)) {
+            ops.push_back(&op);
+            continue;
+        }
+        flush(op.getIterator());
+    }
+    flush(block.end());
+}
+
+void QuantumSchedulePass::runOnOperation()
+{
+    // Only blocks whose order follows the dependencies can be scheduled.
+    SmallVector<Block*> blocks;
+    getOperation()->walk([&](Block* block) {
+        if (mayHaveSSADominance(*block->getParent())) blocks.push_back(block);
+    });
+
+    for (Block* block : blocks) scheduleBlock(*block);
+}
+
+std::unique_ptr<Pass> mlir::quantum::createQuantumSchedulePass()
+{
+    return std::make_unique<QuantumSchedulePass>();
+}
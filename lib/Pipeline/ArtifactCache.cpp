@@ -0,0 +1,201 @@
+/// Implements the on-disk cache of compiled artifacts.
+///
+/// @file
+
+#include "quantum-mlir/Pipeline/ArtifactCache.h"
+
+#include "mlir/IR/OperationSupport.h"
+
+#include <algorithm>
+#include <chrono>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Support/BLAKE3.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/Process.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/TargetParser/Host.h>
+#include <tuple>
+
+using namespace mlir;
+using namespace mlir::quantum;
+
+namespace {
+
+/// Bumped whenever the artifacts of the same input change, e.g. because the
+/// printer or a conversion changed.
+constexpr StringLiteral kFormatVersion = "quantum-artifact-1";
+
+#ifndef QUANTUM_MLIR_BUILD_ID
+#define QUANTUM_MLIR_BUILD_ID "unknown"
+#endif
+
+/// The build of the compiler, which may lower the same input differently
+/// without a change of the format version.
+constexpr StringLiteral kBuildId = QUANTUM_MLIR_BUILD_ID;
+
+/// The extension of the files of the cache, so that eviction never touches
+/// other files in the directory.
+constexpr StringLiteral kExtension = ".artifact";
+
+/// A stream that hashes everything written to it.
+class HashingStream : public llvm::raw_ostream {
+public:
+    explicit HashingStream(llvm::BLAKE3 &hasher) : hasher(hasher) {}
+    ~HashingStream() override { flush(); }
+
+private:
+    void write_impl(const char* ptr, std::size_t size) override
+    {
+        hasher.update(StringRef(ptr, size));
+        pos += size;
+    }
+    std::uint64_t current_pos() const override { return pos; }
+
+    llvm::BLAKE3 &hasher;
+    std::uint64_t pos = 0;
+};
+
+/// Hashes @p str with its length, so that adjacent strings cannot collide.
+void update(llvm::BLAKE3 &hasher, StringRef str)
+{
+    const std::uint64_t size = str.size();
+    hasher.update(
+        ArrayRef(reinterpret_cast<const std::uint8_t*>(&size), sizeof(size)));
+    hasher.update(str);
+}
+
+/// Hashes the contents of the files that the options of @p pipeline name,
+/// e.g. the `noise-model` of `qir-inject-noise`, since the passes read them
+/// while lowering.
+void updateFiles(llvm::BLAKE3 &hasher, StringRef pipeline)
+{
+    SmallVector<StringRef> tokens;
+    llvm::SplitString(pipeline, tokens, "{}(), ");
+    for (StringRef token : tokens) {
+        const StringRef path = token.split('=').second.trim("'\"");
+        if (path.empty() || !llvm::sys::fs::is_regular_file(path)) continue;
+        update(hasher, path);
+        // An unreadable file fails the pipeline anyway.
+        if (auto buffer = llvm::MemoryBuffer::getFile(path))
+            update(hasher, (*buffer)->getBuffer());
+    }
+}
+
+} // namespace
+
+ArtifactCache::ArtifactCache(StringRef directory, std::uint64_t maxBytes)
+        : directory(directory.str()),
+          maxBytes(maxBytes)
+{}
+
+std::string
+ArtifactCache::getKey(Operation* module, StringRef pipeline, ArtifactKind kind)
+{
+    llvm::BLAKE3 hasher;
+    update(hasher, kFormatVersion);
+    update(hasher, kBuildId);
+    update(hasher, kind == ArtifactKind::Object ? "object" : "llvm");
+    update(hasher, pipeline);
+    updateFiles(hasher, pipeline);
+    // Objects are specific to the host they were compiled for.
+    if (kind == ArtifactKind::Object) {
+        update(hasher, llvm::sys::getDefaultTargetTriple());
+        update(hasher, llvm::sys::getHostCPUName());
+    }
+
+    // The generic form does not depend on custom printers that may elide
+    // attributes, and is streamed into the hash without a copy.
+    {
+        HashingStream os(hasher);
+        module->print(
+            os,
+            OpPrintingFlags().printGenericOpForm().enableDebugInfo());
+    }
+    const auto hash = hasher.final();
+    return llvm::toHex(hash, /*LowerCase=*/true);
+}
+
+std::string ArtifactCache::getPath(StringRef key) const
+{
+    SmallString<128> path(directory);
+    llvm::sys::path::append(path, Twine(key) + kExtension);
+    return std::string(path);
+}
+
+std::unique_ptr<llvm::MemoryBuffer> ArtifactCache::lookup(StringRef key)
+{
+    const std::string path = getPath(key);
+    int fd;
+    if (llvm::sys::fs::openFileForRead(path, fd)) return nullptr;
+
+    // Mark the artifact as recently used. Failures only affect eviction.
+    (void)llvm::sys::fs::setLastAccessAndModificationTime(
+        fd,
+        std::chrono::system_clock::now());
+    auto buffer = llvm::MemoryBuffer::getOpenFile(
+        llvm::sys::fs::convertFDToNativeFile(fd),
+        path,
+        /*FileSize=*/-1,
+        /*RequiresNullTerminator=*/false);
+    llvm::sys::Process::SafelyCloseFileDescriptor(fd);
+    if (!buffer) return nullptr;
+    return std::move(*buffer);
+}
+
+LogicalResult ArtifactCache::store(StringRef key, StringRef data)
+{
+    if (data.size() > maxBytes) return failure();
+    if (llvm::sys::fs::create_directories(directory)) return failure();
+
+    // Written to a temporary file and renamed, so that concurrent lookups
+    // never see a partial artifact.
+    llvm::Error error =
+        llvm::writeToOutput(getPath(key), [&](raw_ostream &os) {
+            os << data;
+            return llvm::Error::success();
+        });
+    if (error) {
+        llvm::consumeError(std::move(error));
+        return failure();
+    }
+    evict();
+    return success();
+}
+
+void ArtifactCache::evict()
+{
+    struct Entry {
+        std::string path;
+        llvm::sys::TimePoint<> time;
+        std::uint64_t size;
+    };
+    SmallVector<Entry> entries;
+    std::uint64_t total = 0;
+
+    std::error_code ec;
+    for (llvm::sys::fs::directory_iterator it(directory, ec), end;
+         !ec && it != end;
+         it.increment(ec)) {
+        if (!StringRef(it->path()).ends_with(kExtension)) continue;
+        llvm::sys::fs::file_status status;
+        if (llvm::sys::fs::status(it->path(), status)) continue;
+        entries.push_back(
+            {it->path(), status.getLastModificationTime(), status.getSize()});
+        total += status.getSize();
+    }
+    if (total <= maxBytes) return;
+
+    llvm::sort(entries, [](const Entry &lhs, const Entry &rhs) {
+        return std::tie(lhs.time, lhs.path) < std::tie(rhs.time, rhs.path);
+    });
+    for (const Entry &entry : entries) {
+        if (total <= maxBytes) break;
+        // Another process may have removed the file already.
+        (void)llvm::sys::fs::remove(entry.path);
+        total -= entry.size;
+    }
+}
@@ -0,0 +1,126 @@
+/// Implements the compilation of modules through the full lowering pipeline.
+///
+/// @file
+
+#include "quantum-mlir/Pipeline/Compile.h"
+
+#include "mlir/InitAllPasses.h"
+#include "mlir/Pass/PassManager.h"
+#include "mlir/Pass/PassRegistry.h"
+#include "mlir/Target/LLVMIR/Dialect/Builtin/BuiltinToLLVMIRTranslation.h"
+#include "mlir/Target/LLVMIR/Dialect/LLVMIR/LLVMToLLVMIRTranslation.h"
+#include "mlir/Target/LLVMIR/Export.h"
+#include "quantum-mlir/Conversion/Passes.h"
+#include "quantum-mlir/Dialect/QIR/Transforms/Passes.h"
+#include "quantum-mlir/Dialect/Quantum/Transforms/Passes.h"
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/Module.h>
+#include <llvm/MC/TargetRegistry.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetMachine.h>
+#include <llvm/TargetParser/Host.h>
+#include <mutex>
+
+using namespace mlir;
+using namespace mlir::quantum;
+
+namespace {
+
+/// Translates the lowered @p module to LLVM IR and compiles it to an object
+/// file for the host.
+LogicalResult emitObject(ModuleOp module, std::string &object)
+{
+    static std::once_flag initialized;
+    std::call_once(initialized, [] {
+        llvm::InitializeNativeTarget();
+        llvm::InitializeNativeTargetAsmPrinter();
+    });
+
+    registerBuiltinDialectTranslation(*module.getContext());
+    registerLLVMDialectTranslation(*module.getContext());
+    llvm::LLVMContext llvmContext;
+    auto llvmModule = translateModuleToLLVMIR(module, llvmContext);
+    if (!llvmModule)
+        return module.emitError("cannot translate the module to LLVM IR");
+
+    const std::string triple = llvm::sys::getDefaultTargetTriple();
+    std::string error;
+    const llvm::Target* target =
+        llvm::TargetRegistry::lookupTarget(triple, error);
+    if (!target) return module.emitError(error);
+    std::unique_ptr<llvm::TargetMachine> machine(target->createTargetMachine(
+        triple,
+        llvm::sys::getHostCPUName(),
+        /*Features=*/"",
+        llvm::TargetOptions(),
+        llvm::Reloc::PIC_));
+    if (!machine) return module.emitError("cannot create a target machine");
+    llvmModule->setTargetTriple(triple);
+    llvmModule->setDataLayout(machine->createDataLayout());
+
+    SmallString<0> buffer;
+    llvm::raw_svector_ostream os(buffer);
+    llvm::legacy::PassManager codegen;
+    if (machine->addPassesToEmitFile(
+            codegen,
+            os,
+            nullptr,
+            llvm::CodeGenFileType::ObjectFile))
+        return module.emitError("the target cannot emit object files");
+    codegen.run(*llvmModule);
+    object.assign(buffer.begin(), buffer.end());
+    return success();
+}
+
+} // namespace
+
+void mlir::quantum::registerPipelinePasses()
+{
+    static std::once_flag registered;
+    std::call_once(registered, [] {
+        registerAllPasses();
+        quantum::registerQuantumPasses();
+        quantum::registerConversionPasses();
+        qir::registerQIRPasses();
+    });
+}
+
+FailureOr<CompiledArtifact> mlir::quantum::compileModule(
+    ModuleOp module,
+    StringRef pipeline,
+    ArtifactKind kind,
+    ArtifactCache* cache)
+{
+    std::string key;
+    if (cache) {
+        key = ArtifactCache::getKey(module, pipeline, kind);
+        if (auto buffer = cache->lookup(key))
+            return CompiledArtifact{buffer->getBuffer().str(), true};
+    }
+
+    registerPipelinePasses();
+    PassManager pm(module.getContext());
+    std::string errors;
+    llvm::raw_string_ostream errorStream(errors);
+    if (failed(parsePassPipeline(pipeline, pm, errorStream)))
+        return module.emitError("invalid pass pipeline: ") << errors;
+    if (failed(pm.run(module))) return failure();
+
+    CompiledArtifact artifact;
+    if (kind == ArtifactKind::Object) {
+        if (failed(emitObject(module, artifact.data))) return failure();
+    } else {
+        llvm::raw_string_ostream os(artifact.data);
+        module.print(os);
+    }
+
+    // A full cache or a read-only directory only costs the next compilation.
+    if (cache && failed(cache->store(key, artifact.data)))
+        module.emitWarning("cannot store the artifact in ")
+            << cache->getDirectory();
+    return artifact;
+}
@@ -0,0 +1,190 @@
+/// Implements the inter-process communication of the distributed runtime.
+///
+/// @file
+
+#include "quantum-mlir/Runtime/Communicator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sched.h>
+#include <string_view>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace quantum::runtime;
+
+namespace {
+
+/// Number of amplitudes per mailbox, i.e. 1 MiB per rank.
+constexpr std::size_t kMailboxSize = std::size_t(1) << 16;
+
+static_assert(
+    std::atomic<unsigned>::is_always_lock_free,
+    "barriers in shared memory require address-free atomics");
+
+unsigned readRank(const char* name)
+{
+    const char* value = std::getenv(name);
+    if (!value) return 0;
+    const std::string_view text(value);
+    unsigned result = 0;
+    const auto [end, ec] =
+        std::from_chars(text.data(), text.data() + text.size(), result);
+    return ec == std::errc() && end == text.data() + text.size() ? result : 0;
+}
+
+} // namespace
+
+/// The start of the shared segment, which is followed by the mailboxes.
+struct SharedMemoryCommunicator::Header {
+    std::atomic<unsigned> arrived;
+    std::atomic<unsigned> generation;
+    alignas(64) double partials[kMaxRanks];
+};
+
+std::size_t SharedMemoryCommunicator::getSegmentSize(unsigned size)
+{
+    return sizeof(Header) + size * kMailboxSize * sizeof(Amplitude);
+}
+
+std::unique_ptr<SharedMemoryCommunicator> SharedMemoryCommunicator::connect(
+    const char* name,
+    unsigned rank,
+    unsigned size)
+{
+    if (size == 0 || size > kMaxRanks || rank >= size) {
+        std::fprintf(
+            stderr,
+            "quantum-runtime: invalid rank %u of %u\n",
+            rank,
+            size);
+        return nullptr;
+    }
+
+    const int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        std::fprintf(
+            stderr,
+            "quantum-runtime: cannot open segment '%s': %s\n",
+            name,
+            std::strerror(errno));
+        return nullptr;
+    }
+    void* segment = mmap(
+        nullptr,
+        getSegmentSize(size),
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED,
+        fd,
+        0);
+    close(fd);
+    if (segment == MAP_FAILED) {
+        std::fprintf(
+            stderr,
+            "quantum-runtime: cannot map segment '%s': %s\n",
+            name,
+            std::strerror(errno));
+        return nullptr;
+    }
+
+    // The constructor is private, so make_unique is not available.
+    return std::unique_ptr<SharedMemoryCommunicator>(
+        new SharedMemoryCommunicator(segment, rank, size));
+}
+
+SharedMemoryCommunicator::SharedMemoryCommunicator(
+    void* segment,
+    unsigned rank,
+    unsigned size)
+        : segment(segment),
+          header(static_cast<Header*>(segment)),
+          rank(rank),
+          size(size)
+{}
+
+SharedMemoryCommunicator::~SharedMemoryCommunicator()
+{
+    munmap(segment, getSegmentSize(size));
+}
+
+Amplitude* SharedMemoryCommunicator::getMailbox(unsigned owner) const
+{
+    auto* mailboxes = reinterpret_cast<Amplitude*>(header + 1);
+    return mailboxes + owner * kMailboxSize;
+}
+
+void SharedMemoryCommunicator::barrier()
+{
+    // A counting barrier that is released by bumping the generation, so it
+    // can be reused immediately.
+    const unsigned generation =
+        header->generation.load(std::memory_order_acquire);
+    if (header->arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == size) {
+        header->arrived.store(0, std::memory_order_relaxed);
+        header->generation.fetch_add(1, std::memory_order_release);
+        return;
+    }
+    while (header->generation.load(std::memory_order_acquire) == generation)
+        sched_yield();
+}
+
+void SharedMemoryCommunicator::exchange(
+    unsigned partner,
+    const Amplitude* send,
+    Amplitude* recv,
+    std::size_t count)
+{
+    for (std::size_t offset = 0; offset < count; offset += kMailboxSize) {
+        const std::size_t piece = std::min(kMailboxSize, count - offset);
+        std::memcpy(getMailbox(rank), send + offset, piece * sizeof(Amplitude));
+        barrier();
+        std::memcpy(
+            recv + offset,
+            getMailbox(partner),
+            piece * sizeof(Amplitude));
+        // The mailboxes are reused by the next piece.
+        barrier();
+    }
+}
+
+double SharedMemoryCommunicator::allReduceSum(double value)
+{
+    header->partials[rank] = value;
+    barrier();
+    // Summing in rank order makes the result identical on every rank.
+    double sum = 0.0;
+    for (unsigned r = 0; r < size; ++r) sum += header->partials[r];
+    barrier();
+    return sum;
+}
+
+Communicator* quantum::runtime::getWorldCommunicator()
+{
+    static std::unique_ptr<Communicator> world = []() {
+        std::unique_ptr<Communicator> result;
+        const char* segment = std::getenv(kSegmentEnvVar);
+        const unsigned size = readRank(kRanksEnvVar);
+        if (!segment || size < 2) return result;
+
+        if (size & (size - 1)) {
+            std::fprintf(
+                stderr,
+                "quantum-runtime: the number of ranks must be a power of "
+                "two\n");
+            std::abort();
+        }
+        result = SharedMemoryCommunicator::connect(
+            segment,
+            readRank(kRankEnvVar),
+            size);
+        if (!result) std::abort();
+        return result;
+    }();
+    return world.get();
+}
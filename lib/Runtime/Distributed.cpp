@@ -0,0 +1,267 @@
+/// Implements the distributed state-vector simulator of the runtime.
+///
+/// @file
+
+#include "quantum-mlir/Runtime/Distributed.h"
+
+#include <bit>
+#include <cassert>
+#include <cmath>
+
+using namespace quantum::runtime;
+
+DistributedSimulator::DistributedSimulator(
+    Communicator &comm,
+    const StorageOptions &storage)
+        : comm(comm),
+          numGlobal(std::countr_zero(comm.getSize())),
+          local(0, storage)
+{
+    // All global slots are |0>, so only rank 0 holds an amplitude.
+    if (comm.getRank() != 0) local.data()[0] = 0.0;
+}
+
+bool DistributedSimulator::getRankBit(QubitIndex index) const
+{
+    return (comm.getRank() >> index) & 1;
+}
+
+void DistributedSimulator::addQubits(std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        if (nextGlobal < numGlobal) {
+            layout.push_back({true, nextGlobal++});
+            continue;
+        }
+        // New local qubits are |0> and extend the local amplitudes at the
+        // most significant end.
+        layout.push_back({false, local.getNumQubits()});
+        local.addQubits(1);
+    }
+}
+
+//===----------------------------------------------------------------------===//
+// Gates
+//===----------------------------------------------------------------------===//
+
+void DistributedSimulator::applyMatrix(const Matrix2 &m, QubitIndex target)
+{
+    apply(m, nullptr, 0, target);
+}
+
+void DistributedSimulator::applyDiagonal(
+    Amplitude d0,
+    Amplitude d1,
+    QubitIndex target)
+{
+    apply({d0, 0.0, 0.0, d1}, nullptr, 0, target);
+}
+
+void DistributedSimulator::applyControlled(
+    const Matrix2 &m,
+    QubitIndex control,
+    QubitIndex target)
+{
+    apply(m, &control, 1, target);
+}
+
+void DistributedSimulator::applyDoublyControlled(
+    const Matrix2 &m,
+    QubitIndex control0,
+    QubitIndex control1,
+    QubitIndex target)
+{
+    const QubitIndex controls[] = {control0, control1};
+    apply(m, controls, 2, target);
+}
+
+void DistributedSimulator::apply(
+    const Matrix2 &m,
+    const QubitIndex* controls,
+    unsigned numControls,
+    QubitIndex target)
+{
+    // Global controls select ranks, local ones are passed on. Partner ranks
+    // share all global bits but the target's, so they agree on this.
+    bool active = true;
+    unsigned numLocal = 0;
+    QubitIndex localControls[2] = {};
+    std::size_t mask = 0;
+    for (unsigned i = 0; i < numControls; ++i) {
+        const Slot slot = layout[controls[i]];
+        if (slot.global) {
+            active &= getRankBit(slot.index);
+            continue;
+        }
+        localControls[numLocal++] = slot.index;
+        mask |= std::size_t(1) << slot.index;
+    }
+
+    const Slot slot = layout[target];
+    const std::size_t numQubits = local.getNumQubits();
+    if (slot.global) {
+        if (gates::isDiagonal(m)) {
+            if (active)
+                kernels::scaleWhere(
+                    local.data(),
+                    numQubits,
+                    mask,
+                    getRankBit(slot.index) ? m[3] : m[0]);
+            return;
+        }
+        // The exchange is collective, so inactive ranks take part as well.
+        fetchPartner(slot.index);
+        if (active) combine(m, slot.index, mask, /*store=*/true);
+        return;
+    }
+
+    if (!active) return;
+    switch (numLocal) {
+    case 0:
+        if (gates::isDiagonal(m))
+            local.applyDiagonal(m[0], m[3], slot.index);
+        else
+            local.applyMatrix(m, slot.index);
+        break;
+    case 1: local.applyControlled(m, localControls[0], slot.index); break;
+    default:
+        local.applyDoublyControlled(
+            m,
+            localControls[0],
+            localControls[1],
+            slot.index);
+        break;
+    }
+}
+
+void DistributedSimulator::swap(QubitIndex lhs, QubitIndex rhs)
+{
+    if (lhs == rhs) return;
+    Slot &lhsSlot = layout[lhs];
+    Slot &rhsSlot = layout[rhs];
+    if (lhsSlot.global == rhsSlot.global) {
+        std::swap(lhsSlot, rhsSlot);
+        return;
+    }
+
+    // Amplitude (g, l) moves to (l, g): indices whose local bit equals the
+    // rank bit stay, the others come from the partner with the local bit
+    // flipped.
+    const QubitIndex global = lhsSlot.global ? lhsSlot.index : rhsSlot.index;
+    const QubitIndex localIndex =
+        lhsSlot.global ? rhsSlot.index : lhsSlot.index;
+    fetchPartner(global);
+    const std::size_t bit = std::size_t(1) << localIndex;
+    const std::size_t keep = getRankBit(global) ? bit : 0;
+    Amplitude* amps = local.data();
+    for (std::size_t i = 0; i < local.size(); ++i)
+        if ((i & bit) != keep) amps[i] = partner[i ^ bit];
+}
+
+//===----------------------------------------------------------------------===//
+// Measurement and noise
+//===----------------------------------------------------------------------===//
+
+double DistributedSimulator::probabilityOfOne(QubitIndex target)
+{
+    const Slot slot = layout[target];
+    double partial = 0.0;
+    if (!slot.global) {
+        partial = local.probabilityOfOne(slot.index);
+    } else if (getRankBit(slot.index)) {
+        for (std::size_t i = 0; i < local.size(); ++i)
+            partial += std::norm(local[i]);
+    }
+    return comm.allReduceSum(partial);
+}
+
+void DistributedSimulator::collapse(
+    QubitIndex target,
+    bool outcome,
+    double probability)
+{
+    const Slot slot = layout[target];
+    if (!slot.global) return local.collapse(slot.index, outcome, probability);
+
+    const double factor =
+        getRankBit(slot.index) == outcome ? 1.0 / std::sqrt(probability) : 0.0;
+    kernels::scale(local.data(), local.getNumQubits(), factor);
+}
+
+void DistributedSimulator::applyChannel(
+    const KrausChannel &channel,
+    QubitIndex target,
+    double sample)
+{
+    if (channel.isUnitaryMixture()) {
+        const std::size_t k = sampleIndex(channel.mixture, sample);
+        applyMatrix(
+            gates::scaled(
+                channel.operators[k],
+                1.0 / std::sqrt(channel.mixture[k])),
+            target);
+        return;
+    }
+
+    // The weights need the amplitudes of the partner only once, since the
+    // state does not change until the operator is selected.
+    const Slot slot = layout[target];
+    if (slot.global) fetchPartner(slot.index);
+    std::vector<double> weights;
+    for (const Matrix2 &op : channel.operators) {
+        const double partial =
+            slot.global ? combine(op, slot.index, 0, /*store=*/false)
+                        : kernels::normAfter(
+                              local.data(),
+                              local.getNumQubits(),
+                              op,
+                              slot.index);
+        weights.push_back(comm.allReduceSum(partial));
+    }
+
+    const std::size_t k = sampleIndex(weights, sample);
+    if (slot.global)
+        combine(channel.operators[k], slot.index, 0, /*store=*/true);
+    else
+        local.applyMatrix(channel.operators[k], slot.index);
+    kernels::scale(
+        local.data(),
+        local.getNumQubits(),
+        1.0 / std::sqrt(weights[k]));
+}
+
+//===----------------------------------------------------------------------===//
+// Communication
+//===----------------------------------------------------------------------===//
+
+void DistributedSimulator::fetchPartner(QubitIndex index)
+{
+    partner.resize(local.size());
+    comm.exchange(
+        comm.getRank() ^ (1u << index),
+        local.data(),
+        partner.data(),
+        local.size());
+    ++numExchanges;
+}
+
+double DistributedSimulator::combine(
+    const Matrix2 &m,
+    QubitIndex index,
+    std::size_t mask,
+    bool store)
+{
+    // This rank holds the half of every amplitude pair selected by its bit.
+    const bool high = getRankBit(index);
+    const Amplitude own = high ? m[3] : m[0];
+    const Amplitude other = high ? m[2] : m[1];
+    Amplitude* amps = local.data();
+    double norm = 0.0;
+    for (std::size_t i = 0; i < local.size(); ++i) {
+        if ((i & mask) != mask) continue;
+        const Amplitude result = own * amps[i] + other * partner[i];
+        norm += std::norm(result);
+        if (store) amps[i] = result;
+    }
+    return norm;
+}
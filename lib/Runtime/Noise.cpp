@@ -0,0 +1,51 @@
+/// Implements the single-qubit noise channels of the simulator runtime.
+///
+/// @file
+
+#include "quantum-mlir/Runtime/Noise.h"
+
+#include <cmath>
+
+using namespace quantum::runtime;
+
+using gates::scaled;
+
+KrausChannel quantum::runtime::depolarizing(double p)
+{
+    KrausChannel channel;
+    const double pauli = p / 3.0;
+    channel.operators = {
+        scaled(gates::identity(), std::sqrt(1.0 - p)),
+        scaled(gates::x(), std::sqrt(pauli)),
+        scaled(gates::y(), std::sqrt(pauli)),
+        scaled(gates::z(), std::sqrt(pauli))};
+    channel.mixture = {1.0 - p, pauli, pauli, pauli};
+    return channel;
+}
+
+std::size_t
+quantum::runtime::sampleIndex(const std::vector<double> &weights, double sample)
+{
+    // Weights that sum to slightly less than one due to rounding must not
+    // select an operator that annihilates the state, whose renormalisation
+    // would divide by zero.
+    std::size_t last = weights.size() - 1;
+    double cumulative = 0.0;
+    for (std::size_t i = 0; i < weights.size(); ++i) {
+        if (weights[i] <= 0.0) continue;
+        cumulative += weights[i];
+        last = i;
+        if (sample < cumulative) return i;
+    }
+    return last;
+}
+
+KrausChannel quantum::runtime::amplitudeDamping(double gamma)
+{
+    KrausChannel channel;
+    channel.operators = {
+        {1.0, 0.0, 0.0, std::sqrt(1.0 - gamma)},
+        {0.0, std::sqrt(gamma), 0.0, 0.0}
+    };
+    return channel;
+}
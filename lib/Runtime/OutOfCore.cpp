@@ -0,0 +1,292 @@
+/// Implements the out-of-core state-vector simulator of the runtime.
+///
+/// @file
+
+#include "quantum-mlir/Runtime/OutOfCore.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+using namespace quantum::runtime;
+
+namespace {
+
+/// Number of queued gates that triggers a flush.
+constexpr std::size_t kMaxQueue = 4096;
+/// Number of queued gates inspected to select a qubit to swap out.
+constexpr std::size_t kLookahead = 256;
+
+} // namespace
+
+OutOfCoreSimulator::OutOfCoreSimulator(const StorageOptions &options)
+        : StateVectorSimulator(options),
+          chunkQubits(
+              options.chunkQubits ? options.chunkQubits : kDefaultChunkQubits)
+{}
+
+const StateVector &OutOfCoreSimulator::getState()
+{
+    flush();
+    // Restore the identity layout. Each swap places logical qubit q, which
+    // is never moved again afterwards.
+    for (QubitIndex q = 0; q < physical.size(); ++q)
+        if (physical[q] != q) swapPhysical(physical[q], q);
+    return state;
+}
+
+void OutOfCoreSimulator::addQubits(std::size_t count)
+{
+    flush();
+    state.addQubits(count);
+    // New qubits are the most significant ones in both orders.
+    for (std::size_t i = 0; i < count; ++i) {
+        physical.push_back(physical.size());
+        logical.push_back(logical.size());
+    }
+}
+
+//===----------------------------------------------------------------------===//
+// Queueing
+//===----------------------------------------------------------------------===//
+
+OutOfCoreSimulator::Gate::Kind OutOfCoreSimulator::kindOf(const Matrix2 &m)
+{
+    return gates::isDiagonal(m) ? Gate::Kind::Diagonal : Gate::Kind::Matrix;
+}
+
+void OutOfCoreSimulator::applyMatrix(const Matrix2 &m, QubitIndex target)
+{
+    enqueue({kindOf(m), m, 0, {}, target});
+}
+
+void OutOfCoreSimulator::applyDiagonal(
+    Amplitude d0,
+    Amplitude d1,
+    QubitIndex target)
+{
+    enqueue({Gate::Kind::Diagonal, {d0, 0.0, 0.0, d1}, 0, {}, target});
+}
+
+void OutOfCoreSimulator::applyControlled(
+    const Matrix2 &m,
+    QubitIndex control,
+    QubitIndex target)
+{
+    enqueue({kindOf(m), m, 1, {control, 0}, target});
+}
+
+void OutOfCoreSimulator::applyDoublyControlled(
+    const Matrix2 &m,
+    QubitIndex control0,
+    QubitIndex control1,
+    QubitIndex target)
+{
+    enqueue({kindOf(m), m, 2, {control0, control1}, target});
+}
+
+void OutOfCoreSimulator::swap(QubitIndex lhs, QubitIndex rhs)
+{
+    if (lhs != rhs) enqueue({Gate::Kind::Relabel, {}, 1, {lhs, 0}, rhs});
+}
+
+void OutOfCoreSimulator::enqueue(const Gate &gate)
+{
+    queue.push_back(gate);
+    if constexpr (kProfilingEnabled) queue.back().op = getCurrentOp();
+    if (queue.size() >= kMaxQueue) flush();
+}
+
+//===----------------------------------------------------------------------===//
+// State access
+//===----------------------------------------------------------------------===//
+
+double OutOfCoreSimulator::probabilityOfOne(QubitIndex target)
+{
+    flush();
+    return StateVectorSimulator::probabilityOfOne(physical[target]);
+}
+
+void OutOfCoreSimulator::collapse(
+    QubitIndex target,
+    bool outcome,
+    double probability)
+{
+    flush();
+    StateVectorSimulator::collapse(physical[target], outcome, probability);
+}
+
+void OutOfCoreSimulator::applyChannel(
+    const KrausChannel &channel,
+    QubitIndex target,
+    double sample)
+{
+    // Unitary mixtures are sampled upfront and end up in the queue.
+    if (channel.isUnitaryMixture())
+        return StateVectorSimulator::applyChannel(channel, target, sample);
+
+    flush();
+    StateVectorSimulator::applyChannel(channel, physical[target], sample);
+}
+
+//===----------------------------------------------------------------------===//
+// Execution
+//===----------------------------------------------------------------------===//
+
+std::size_t OutOfCoreSimulator::getLocalQubits() const
+{
+    return std::min(chunkQubits, state.getNumQubits());
+}
+
+bool OutOfCoreSimulator::isChunkLocal(const Gate &gate) const
+{
+    // Diagonal gates with a high target scale whole chunks.
+    return gate.kind != Gate::Kind::Matrix
+           || physical[gate.target] < getLocalQubits();
+}
+
+void OutOfCoreSimulator::flush()
+{
+    std::size_t pos = 0;
+    while (pos < queue.size()) {
+        if (!isChunkLocal(queue[pos])) makeLocal(pos);
+
+        // Extend the run as long as the gates stay local. Relabels take
+        // effect immediately, so the run is translated to physical qubits
+        // while it is collected.
+        std::vector<Gate> run;
+        for (; pos < queue.size(); ++pos) {
+            const Gate &gate = queue[pos];
+            if (gate.kind == Gate::Kind::Relabel) {
+                const QubitIndex lhs = gate.controls[0], rhs = gate.target;
+                std::swap(physical[lhs], physical[rhs]);
+                logical[physical[lhs]] = lhs;
+                logical[physical[rhs]] = rhs;
+                continue;
+            }
+            if (!isChunkLocal(gate)) break;
+
+            Gate translated = gate;
+            translated.target = physical[gate.target];
+            for (unsigned i = 0; i < gate.numControls; ++i)
+                translated.controls[i] = physical[gate.controls[i]];
+            run.push_back(translated);
+        }
+        if (!run.empty()) applyRun(run);
+    }
+    queue.clear();
+}
+
+void OutOfCoreSimulator::makeLocal(std::size_t pos)
+{
+    const std::size_t local = getLocalQubits();
+    const QubitIndex high = physical[queue[pos].target];
+    assert(high >= local && "target is already local");
+
+    // Evict the local qubit whose next use lies furthest in the future.
+    constexpr std::size_t kNever = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> nextUse(local, kNever);
+    std::vector<QubitIndex> layout = physical;
+    const std::size_t end = std::min(queue.size(), pos + kLookahead);
+    for (std::size_t i = pos; i < end; ++i) {
+        const Gate &gate = queue[i];
+        if (gate.kind == Gate::Kind::Relabel) {
+            std::swap(layout[gate.controls[0]], layout[gate.target]);
+            continue;
+        }
+        const auto use = [&](QubitIndex qubit) {
+            const QubitIndex p = layout[qubit];
+            if (p < local && nextUse[p] == kNever) nextUse[p] = i - pos;
+        };
+        use(gate.target);
+        for (unsigned c = 0; c < gate.numControls; ++c) use(gate.controls[c]);
+    }
+
+    QubitIndex victim = 0;
+    for (QubitIndex p = 1; p < local; ++p)
+        if (nextUse[p] > nextUse[victim]) victim = p;
+    swapPhysical(high, victim);
+}
+
+void OutOfCoreSimulator::applyRun(const std::vector<Gate> &run)
+{
+    const std::size_t local = getLocalQubits();
+    const std::size_t numChunks =
+        std::size_t(1) << (state.getNumQubits() - local);
+    // All but the first gate of a run share its pass over the state.
+    if constexpr (kProfilingEnabled)
+        for (std::size_t i = 1; i < run.size(); ++i)
+            Profiler::get().recordFusion(run[i].op);
+
+    for (std::size_t chunk = 0; chunk < numChunks; ++chunk) {
+        Amplitude* amps = state.data() + (chunk << local);
+        for (const Gate &gate : run) {
+            // High controls select chunks, local ones are passed on.
+            bool active = true;
+            unsigned numLocal = 0;
+            std::array<QubitIndex, 2> controls{};
+            for (unsigned i = 0; i < gate.numControls; ++i) {
+                const QubitIndex p = gate.controls[i];
+                if (p < local)
+                    controls[numLocal++] = p;
+                else if (!((chunk >> (p - local)) & 1))
+                    active = false;
+            }
+            if (!active) continue;
+
+            const Matrix2 &m = gate.matrix;
+            if (gate.target >= local) {
+                assert(gate.kind == Gate::Kind::Diagonal);
+                const bool set = (chunk >> (gate.target - local)) & 1;
+                std::size_t mask = 0;
+                for (unsigned i = 0; i < numLocal; ++i)
+                    mask |= std::size_t(1) << controls[i];
+                kernels::scaleWhere(amps, local, mask, set ? m[3] : m[0]);
+                continue;
+            }
+
+            switch (numLocal) {
+            case 0:
+                if (gate.kind == Gate::Kind::Diagonal)
+                    kernels::applyDiagonal(
+                        amps,
+                        local,
+                        m[0],
+                        m[3],
+                        gate.target);
+                else
+                    kernels::applyMatrix(amps, local, m, gate.target);
+                break;
+            case 1:
+                kernels::applyControlled(
+                    amps,
+                    local,
+                    m,
+                    controls[0],
+                    gate.target);
+                break;
+            default:
+                kernels::applyDoublyControlled(
+                    amps,
+                    local,
+                    m,
+                    controls[0],
+                    controls[1],
+                    gate.target);
+                break;
+            }
+        }
+    }
+    ++numPasses;
+}
+
+void OutOfCoreSimulator::swapPhysical(QubitIndex lhs, QubitIndex rhs)
+{
+    kernels::swap(state.data(), state.getNumQubits(), lhs, rhs);
+    ++numPasses;
+
+    const QubitIndex lhsLogical = logical[lhs], rhsLogical = logical[rhs];
+    std::swap(logical[lhs], logical[rhs]);
+    physical[lhsLogical] = rhs;
+    physical[rhsLogical] = lhs;
+}
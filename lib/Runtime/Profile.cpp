@@ -0,0 +1,346 @@
+/// Implements the optional profiling instrumentation of the simulator runtime.
+///
+/// @file
+
+#include "quantum-mlir/Runtime/Profile.h"
+
+#include "quantum-mlir/Runtime/Communicator.h"
+#include "quantum-mlir/Runtime/Runtime.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <map>
+
+using namespace quantum::runtime;
+
+namespace {
+
+/// The name of each kind and its traffic: the kernel reads and writes at least
+/// 2^-shift of the amplitudes, or none at all for classical operations.
+struct KindInfo {
+    const char* name;
+    int shift;
+};
+
+constexpr KindInfo kKinds[kNumOpKinds] = {
+    {"h",                 0 },
+    {"x",                 0 },
+    {"y",                 0 },
+    {"z",                 0 },
+    {"s",                 0 },
+    {"sdg",               0 },
+    {"t",                 0 },
+    {"tdg",               0 },
+    {"rx",                0 },
+    {"ry",                0 },
+    {"rz",                0 },
+    {"u1",                0 },
+    {"u2",                0 },
+    {"cnot",              1 },
+    {"cz",                1 },
+    {"swap",              1 },
+    {"crz",               1 },
+    {"cry",               1 },
+    {"ccx",               2 },
+    {"mz",                0 },
+    {"reset",             0 },
+    {"depolarizing",      0 },
+    {"amplitude_damping", 0 },
+    {"readout_error",     -1},
+    {"other",             -1},
+};
+
+thread_local OpKind currentOp = OpKind::Other;
+thread_local const char* currentSite = nullptr;
+
+void accumulate(OpCounters &sum, const OpCounters &counters)
+{
+    sum.calls += counters.calls;
+    sum.nanoseconds += counters.nanoseconds;
+    sum.bytes += counters.bytes;
+    sum.fusions += counters.fusions;
+}
+
+/// Prints @p text as a JSON string.
+void printString(std::FILE* file, const char* text)
+{
+    std::fputc('"', file);
+    for (; *text; ++text) {
+        const unsigned char c = *text;
+        if (c == '"' || c == '\\')
+            std::fprintf(file, "\\%c", c);
+        else if (c < 0x20)
+            std::fprintf(file, "\\u%04x", c);
+        else
+            std::fputc(c, file);
+    }
+    std::fputc('"', file);
+}
+
+void printCounters(std::FILE* file, const OpCounters &counters)
+{
+    std::fprintf(
+        file,
+        "{\"calls\": %" PRIu64 ", \"nanoseconds\": %" PRIu64
+        ", \"bytes\": %" PRIu64 ", \"fusions\": %" PRIu64 "}",
+        counters.calls,
+        counters.nanoseconds,
+        counters.bytes,
+        counters.fusions);
+}
+
+/// Prints the counters of all kinds that occurred and of all @p sites as a
+/// JSON object.
+void printSummary(
+    std::FILE* file,
+    const ProfileCounters &totals,
+    const std::vector<std::pair<std::string, OpCounters>> &sites)
+{
+    OpCounters sum;
+    std::fprintf(file, "{\n    \"ops\": {");
+    bool first = true;
+    for (std::size_t i = 0; i < kNumOpKinds; ++i) {
+        const OpCounters &counters = totals[i];
+        if (counters.calls == 0 && counters.fusions == 0) continue;
+        std::fprintf(
+            file,
+            "%s\n      \"%s\": ",
+            first ? "" : ",",
+            kKinds[i].name);
+        printCounters(file, counters);
+        accumulate(sum, counters);
+        first = false;
+    }
+    std::fprintf(file, "\n    },\n    \"total\": ");
+    printCounters(file, sum);
+    if (!sites.empty()) {
+        std::fprintf(file, ",\n    \"sites\": {");
+        first = true;
+        for (const auto &[site, counters] : sites) {
+            std::fprintf(file, "%s\n      ", first ? "" : ",");
+            printString(file, site.c_str());
+            std::fprintf(file, ": ");
+            printCounters(file, counters);
+            first = false;
+        }
+        std::fprintf(file, "\n    }");
+    }
+    std::fprintf(file, "\n  }");
+}
+
+} // namespace
+
+const char* quantum::runtime::getName(OpKind kind)
+{
+    return kKinds[static_cast<std::size_t>(kind)].name;
+}
+
+bool quantum::runtime::parseProfileFormat(
+    std::string_view name,
+    ProfileFormat &format)
+{
+    if (name == "json") {
+        format = ProfileFormat::Summary;
+        return true;
+    }
+    if (name == "chrome") {
+        format = ProfileFormat::ChromeTrace;
+        return true;
+    }
+    return false;
+}
+
+std::uint64_t quantum::runtime::estimateTraffic(OpKind kind)
+{
+    const int shift = kKinds[static_cast<std::size_t>(kind)].shift;
+    if (shift < 0) return 0;
+    const std::uint64_t amplitudes =
+        getRuntimeState().getSimulator().getStorageSize();
+    return (2 * sizeof(Amplitude) * amplitudes) >> shift;
+}
+
+void quantum::runtime::setCurrentOp(OpKind kind) { currentOp = kind; }
+
+OpKind quantum::runtime::getCurrentOp() { return currentOp; }
+
+void quantum::runtime::setCurrentSite(const char* site) { currentSite = site; }
+
+//===----------------------------------------------------------------------===//
+// Profiler
+//===----------------------------------------------------------------------===//
+
+Profiler::Profiler() : epoch(std::chrono::steady_clock::now()) {}
+
+Profiler &Profiler::get()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+std::uint64_t Profiler::now() const
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - epoch)
+        .count();
+}
+
+void Profiler::setOutput(std::string newPath, ProfileFormat newFormat)
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    path = std::move(newPath);
+    format = newFormat;
+}
+
+Profiler::ThreadProfile &Profiler::getThreadProfile()
+{
+    // Blocks are owned by the profiler, so they survive the pool threads
+    // that recorded them.
+    thread_local ThreadProfile* profile = nullptr;
+    if (!profile) {
+        const std::lock_guard<std::mutex> lock(mutex);
+        threads.push_back(std::make_unique<ThreadProfile>());
+        profile = threads.back().get();
+    }
+    return *profile;
+}
+
+void Profiler::record(
+    OpKind kind,
+    std::uint64_t begin,
+    std::uint64_t end,
+    std::uint64_t bytes)
+{
+    ThreadProfile &profile = getThreadProfile();
+    OpCounters &counters = profile.counters[static_cast<std::size_t>(kind)];
+    ++counters.calls;
+    counters.nanoseconds += end - begin;
+    counters.bytes += bytes;
+    if (currentSite) {
+        OpCounters &site = profile.sites[currentSite];
+        ++site.calls;
+        site.nanoseconds += end - begin;
+        site.bytes += bytes;
+    }
+    if (profile.events.size() < kMaxEvents)
+        profile.events.push_back(Event{kind, currentSite, begin, end - begin});
+}
+
+void Profiler::recordFusion(OpKind kind)
+{
+    ++getThreadProfile().counters[static_cast<std::size_t>(kind)].fusions;
+}
+
+ProfileCounters Profiler::getTotals() const
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    ProfileCounters totals{};
+    for (const auto &profile : threads)
+        for (std::size_t i = 0; i < kNumOpKinds; ++i)
+            accumulate(totals[i], profile->counters[i]);
+    return totals;
+}
+
+std::vector<std::pair<std::string, OpCounters>> Profiler::getSiteTotals() const
+{
+    // Sites are merged by name, since every module has its own strings.
+    std::map<std::string, OpCounters> merged;
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        for (const auto &profile : threads)
+            for (const auto &[site, counters] : profile->sites)
+                accumulate(merged[site], counters);
+    }
+
+    std::vector<std::pair<std::string, OpCounters>> sites(
+        merged.begin(),
+        merged.end());
+    std::stable_sort(sites.begin(), sites.end(), [](auto &lhs, auto &rhs) {
+        return lhs.second.nanoseconds > rhs.second.nanoseconds;
+    });
+    return sites;
+}
+
+void Profiler::reset()
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    for (const auto &profile : threads) {
+        profile->counters = {};
+        profile->sites.clear();
+        profile->events.clear();
+    }
+}
+
+bool Profiler::dump()
+{
+    std::string target;
+    ProfileFormat targetFormat;
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        target = path;
+        targetFormat = format;
+    }
+    if (target.empty()) return true;
+
+    // Ranks of a process group must not overwrite each other's profile.
+    if (const Communicator* comm = getWorldCommunicator())
+        if (comm->getRank() != 0)
+            target += "." + std::to_string(comm->getRank());
+    return write(target, targetFormat);
+}
+
+bool Profiler::write(const std::string &file, ProfileFormat fileFormat) const
+{
+    std::FILE* out = std::fopen(file.c_str(), "w");
+    if (!out) {
+        std::fprintf(
+            stderr,
+            "quantum-runtime: cannot write profile '%s'\n",
+            file.c_str());
+        return false;
+    }
+
+    const ProfileCounters totals = getTotals();
+    const auto sites = getSiteTotals();
+    if (fileFormat == ProfileFormat::Summary) {
+        std::fprintf(out, "{\n  \"profile\": ");
+        printSummary(out, totals, sites);
+        std::fprintf(out, "\n}\n");
+        return std::fclose(out) == 0;
+    }
+
+    const Communicator* comm = getWorldCommunicator();
+    const unsigned pid = comm ? comm->getRank() : 0;
+    std::fprintf(out, "{\n  \"traceEvents\": [");
+    bool first = true;
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        for (std::size_t tid = 0; tid < threads.size(); ++tid) {
+            for (const Event &event : threads[tid]->events) {
+                std::fprintf(
+                    out,
+                    "%s\n    {\"name\": \"%s\", \"cat\": \"qis\", "
+                    "\"ph\": \"X\", \"pid\": %u, \"tid\": %zu, "
+                    "\"ts\": %.3f, \"dur\": %.3f",
+                    first ? "" : ",",
+                    getName(event.kind),
+                    pid,
+                    tid,
+                    static_cast<double>(event.begin) * 1e-3,
+                    static_cast<double>(event.duration) * 1e-3);
+                if (event.site) {
+                    std::fprintf(out, ", \"args\": {\"site\": ");
+                    printString(out, event.site);
+                    std::fputc('}', out);
+                }
+                std::fputc('}', out);
+                first = false;
+            }
+        }
+    }
+    std::fprintf(out, "\n  ],\n  \"displayTimeUnit\": \"ns\",\n");
+    std::fprintf(out, "  \"otherData\": ");
+    printSummary(out, totals, sites);
+    std::fprintf(out, "\n}\n");
+    return std::fclose(out) == 0;
+}
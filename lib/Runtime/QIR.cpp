@@ -0,0 +1,280 @@
+/// Implements the QIR entry points exported by the simulator runtime.
+///
+/// @file
+
+#include "quantum-mlir/Runtime/QIR.h"
+
+#include "quantum-mlir/Runtime/Runtime.h"
+#include "quantum-mlir/Runtime/Trajectories.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <numbers>
+
+using namespace quantum::runtime;
+
+namespace {
+
+std::uintptr_t idOf(const void* ptr)
+{
+    return reinterpret_cast<std::uintptr_t>(ptr);
+}
+
+QubitIndex qubit(QirQubit* ptr)
+{
+    return getRuntimeState().getQubit(idOf(ptr));
+}
+
+Simulator &sim() { return getRuntimeState().getSimulator(); }
+
+void applyMatrix(const Matrix2 &m, QirQubit* target)
+{
+    const QubitIndex t = qubit(target);
+    sim().applyMatrix(m, t);
+}
+
+void applyDiagonal(Amplitude d0, Amplitude d1, QirQubit* target)
+{
+    const QubitIndex t = qubit(target);
+    sim().applyDiagonal(d0, d1, t);
+}
+
+void applyControlled(const Matrix2 &m, QirQubit* control, QirQubit* target)
+{
+    const QubitIndex c = qubit(control);
+    const QubitIndex t = qubit(target);
+    sim().applyControlled(m, c, t);
+}
+
+void applyChannel(const KrausChannel &channel, QirQubit* target)
+{
+    RuntimeState &state = getRuntimeState();
+    const QubitIndex t = state.getQubit(idOf(target));
+    state.getSimulator().applyChannel(channel, t, state.sample());
+}
+
+} // namespace
+
+//===----------------------------------------------------------------------===//
+// Runtime
+//===----------------------------------------------------------------------===//
+
+void __quantum__rt__initialize(const char* config)
+{
+    RuntimeConfig effective = getDefaultConfig();
+    if (config) effective.parse(config);
+    getRuntimeState().initialize(effective);
+}
+
+void __quantum__rt__finalize() { Profiler::get().dump(); }
+
+void __quantum__rt__set_site(const char* site) { setCurrentSite(site); }
+
+void set_rng_seed(std::int64_t seed)
+{
+    getRuntimeState().seed(static_cast<std::uint64_t>(seed));
+}
+
+void __quantum__rt__set_rng_stream(std::int64_t seed, std::int64_t stream)
+{
+    RuntimeState &state = getRuntimeState();
+    state.setStream(static_cast<std::uint64_t>(stream));
+    state.seed(static_cast<std::uint64_t>(seed));
+}
+
+void __quantum__rt__run_trajectories(void (*kernel)())
+{
+    const RuntimeConfig config = getRuntimeState().getConfig();
+    const Histogram histogram =
+        runTrajectories(kernel, config.trajectories, config.threads);
+    for (const auto &[bits, hits] : histogram)
+        std::printf("%s: %" PRIu64 "\n", bits.c_str(), hits);
+    std::fflush(stdout);
+}
+
+//===----------------------------------------------------------------------===//
+// Gates
+//===----------------------------------------------------------------------===//
+
+void __quantum__qis__h__body(QirQubit* q)
+{
+    const ProfileScope<> scope(OpKind::H);
+    applyMatrix(gates::h(), q);
+}
+
+void __quantum__qis__x__body(QirQubit* q)
+{
+    const ProfileScope<> scope(OpKind::X);
+    applyMatrix(gates::x(), q);
+}
+
+void __quantum__qis__y__body(QirQubit* q)
+{
+    const ProfileScope<> scope(OpKind::Y);
+    applyMatrix(gates::y(), q);
+}
+
+void __quantum__qis__z__body(QirQubit* q)
+{
+    const ProfileScope<> scope(OpKind::Z);
+    applyDiagonal(1.0, -1.0, q);
+}
+
+void __quantum__qis__s__body(QirQubit* q)
+{
+    const ProfileScope<> scope(OpKind::S);
+    applyDiagonal(1.0, Amplitude(0, 1), q);
+}
+
+void __quantum__qis__sdg__body(QirQubit* q)
+{
+    const ProfileScope<> scope(OpKind::Sdg);
+    applyDiagonal(1.0, Amplitude(0, -1), q);
+}
+
+void __quantum__qis__t__body(QirQubit* q)
+{
+    const ProfileScope<> scope(OpKind::T);
+    const auto [d0, d1] = gates::phaseDiagonal(std::numbers::pi / 4);
+    applyDiagonal(d0, d1, q);
+}
+
+void __quantum__qis__tdg__body(QirQubit* q)
+{
+    const ProfileScope<> scope(OpKind::Tdg);
+    const auto [d0, d1] = gates::phaseDiagonal(-std::numbers::pi / 4);
+    applyDiagonal(d0, d1, q);
+}
+
+void __quantum__qis__rx__body(double theta, QirQubit* q)
+{
+    const ProfileScope<> scope(OpKind::Rx);
+    applyMatrix(gates::rx(theta), q);
+}
+
+void __quantum__qis__ry__body(double theta, QirQubit* q)
+{
+    const ProfileScope<> scope(OpKind::Ry);
+    applyMatrix(gates::ry(theta), q);
+}
+
+void __quantum__qis__rz__body(double theta, QirQubit* q)
+{
+    const ProfileScope<> scope(OpKind::Rz);
+    const auto [d0, d1] = gates::rzDiagonal(theta);
+    applyDiagonal(d0, d1, q);
+}
+
+void __quantum__qis__u1__body(double lambda, QirQubit* q)
+{
+    const ProfileScope<> scope(OpKind::U1);
+    const auto [d0, d1] = gates::phaseDiagonal(lambda);
+    applyDiagonal(d0, d1, q);
+}
+
+void __quantum__qis__u2__body(double phi, double lambda, QirQubit* q)
+{
+    const ProfileScope<> scope(OpKind::U2);
+    applyMatrix(gates::u2(phi, lambda), q);
+}
+
+void __quantum__qis__cnot__body(QirQubit* control, QirQubit* target)
+{
+    const ProfileScope<> scope(OpKind::CNOT);
+    applyControlled(gates::x(), control, target);
+}
+
+void __quantum__qis__cz__body(QirQubit* control, QirQubit* target)
+{
+    const ProfileScope<> scope(OpKind::CZ);
+    applyControlled(gates::z(), control, target);
+}
+
+void __quantum__qis__swap__body(QirQubit* lhs, QirQubit* rhs)
+{
+    const ProfileScope<> scope(OpKind::Swap);
+    const QubitIndex l = qubit(lhs);
+    const QubitIndex r = qubit(rhs);
+    sim().swap(l, r);
+}
+
+void __quantum__qis__crz__body(
+    double theta,
+    QirQubit* control,
+    QirQubit* target)
+{
+    const ProfileScope<> scope(OpKind::CRz);
+    const auto [d0, d1] = gates::rzDiagonal(theta);
+    applyControlled({d0, 0.0, 0.0, d1}, control, target);
+}
+
+void __quantum__qis__cry__body(
+    double theta,
+    QirQubit* control,
+    QirQubit* target)
+{
+    const ProfileScope<> scope(OpKind::CRy);
+    applyControlled(gates::ry(theta), control, target);
+}
+
+void __quantum__qis__ccx__body(
+    QirQubit* control0,
+    QirQubit* control1,
+    QirQubit* target)
+{
+    const ProfileScope<> scope(OpKind::CCX);
+    const QubitIndex c0 = qubit(control0);
+    const QubitIndex c1 = qubit(control1);
+    const QubitIndex t = qubit(target);
+    sim().applyDoublyControlled(gates::x(), c0, c1, t);
+}
+
+//===----------------------------------------------------------------------===//
+// Measurement
+//===----------------------------------------------------------------------===//
+
+void __quantum__qis__mz__body(QirQubit* q, QirResult* result)
+{
+    const ProfileScope<> scope(OpKind::Measure);
+    RuntimeState &state = getRuntimeState();
+    const QubitIndex t = state.getQubit(idOf(q));
+    const bool outcome = state.getSimulator().measure(t, state.sample());
+    state.setResult(idOf(result), outcome);
+}
+
+bool __quantum__qis__read_result__body(QirResult* result)
+{
+    return getRuntimeState().getResult(idOf(result));
+}
+
+void __quantum__qis__reset__body(QirQubit* q)
+{
+    const ProfileScope<> scope(OpKind::Reset);
+    RuntimeState &state = getRuntimeState();
+    const QubitIndex t = state.getQubit(idOf(q));
+    state.getSimulator().reset(t, state.sample());
+}
+
+//===----------------------------------------------------------------------===//
+// Noise channels
+//===----------------------------------------------------------------------===//
+
+void __quantum__qis__depolarizing__body(double probability, QirQubit* q)
+{
+    const ProfileScope<> scope(OpKind::Depolarizing);
+    applyChannel(depolarizing(probability), q);
+}
+
+void __quantum__qis__amplitude_damping__body(double gamma, QirQubit* q)
+{
+    const ProfileScope<> scope(OpKind::AmplitudeDamping);
+    applyChannel(amplitudeDamping(gamma), q);
+}
+
+void __quantum__qis__readout_error__body(double probability, QirResult* result)
+{
+    const ProfileScope<> scope(OpKind::ReadoutError);
+    RuntimeState &state = getRuntimeState();
+    const std::uintptr_t id = idOf(result);
+    if (state.sample() < probability) state.setResult(id, !state.getResult(id));
+}
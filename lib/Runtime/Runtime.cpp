@@ -0,0 +1,185 @@
+/// Implements the execution state of the simulator runtime.
+///
+/// @file
+
+#include "quantum-mlir/Runtime/Runtime.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace quantum::runtime;
+
+namespace {
+
+template<typename T>
+bool parseNumber(std::string_view text, T &value)
+{
+    const auto [end, ec] =
+        std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc() && end == text.data() + text.size();
+}
+
+} // namespace
+
+//===----------------------------------------------------------------------===//
+// RuntimeConfig
+//===----------------------------------------------------------------------===//
+
+void RuntimeConfig::parse(std::string_view text)
+{
+    while (!text.empty()) {
+        const std::size_t end = std::min(text.find(';'), text.size());
+        const std::string_view option = text.substr(0, end);
+        text.remove_prefix(std::min(end + 1, text.size()));
+        if (option.empty()) continue;
+
+        const std::size_t eq = option.find('=');
+        const std::string_view key = option.substr(0, eq);
+        const std::string_view value =
+            eq == std::string_view::npos ? "" : option.substr(eq + 1);
+
+        // Parse into temporaries so that invalid values leave the previous
+        // setting in place.
+        bool valid = false;
+        if (key == "backend") {
+            Backend parsed;
+            valid = parseBackend(value, parsed);
+            if (valid) backend = parsed;
+        } else if (key == "trajectories") {
+            std::size_t parsed;
+            valid = parseNumber(value, parsed) && parsed > 0;
+            if (valid) trajectories = parsed;
+        } else if (key == "threads") {
+            unsigned parsed;
+            valid = parseNumber(value, parsed);
+            if (valid) threads = parsed;
+        } else if (key == "storage") {
+            StorageKind parsed;
+            valid = parseStorageKind(value, parsed);
+            if (valid) storage.kind = parsed;
+        } else if (key == "storage-dir") {
+            valid = !value.empty();
+            if (valid) storage.directory = value;
+        } else if (key == "chunk-qubits") {
+            unsigned parsed;
+            valid = parseNumber(value, parsed) && parsed < 64;
+            if (valid) storage.chunkQubits = parsed;
+        } else if (key == "profile") {
+            valid = !value.empty();
+            if (valid) profile = value;
+            if (valid && !kProfilingEnabled)
+                std::fprintf(
+                    stderr,
+                    "quantum-runtime: profiling is not supported by this "
+                    "build, see QUANTUM_RUNTIME_PROFILING\n");
+        } else if (key == "profile-format") {
+            ProfileFormat parsed;
+            valid = parseProfileFormat(value, parsed);
+            if (valid) profileFormat = parsed;
+        }
+
+        if (!valid)
+            std::fprintf(
+                stderr,
+                "quantum-runtime: ignoring invalid option '%.*s'\n",
+                static_cast<int>(option.size()),
+                option.data());
+    }
+}
+
+RuntimeConfig &quantum::runtime::getDefaultConfig()
+{
+    static RuntimeConfig config = [] {
+        RuntimeConfig result;
+        if (const char* env = std::getenv(kConfigEnvVar)) result.parse(env);
+        return result;
+    }();
+    return config;
+}
+
+//===----------------------------------------------------------------------===//
+// RuntimeState
+//===----------------------------------------------------------------------===//
+
+void RuntimeState::initialize(const RuntimeConfig &config)
+{
+    this->config = config;
+    simulator = createSimulator(config.backend, config.storage);
+    results.clear();
+
+    if constexpr (kProfilingEnabled) {
+        if (!config.profile.empty()) {
+            Profiler::get().setOutput(config.profile, config.profileFormat);
+            // Programs lowered by the compiler do not finalize the runtime.
+            static const bool registered =
+                std::atexit([] { Profiler::get().dump(); }) == 0;
+            (void)registered;
+        }
+    }
+}
+
+Simulator &RuntimeState::getSimulator()
+{
+    if (!simulator) initialize(getDefaultConfig());
+    return *simulator;
+}
+
+const RuntimeConfig &RuntimeState::getConfig()
+{
+    if (!simulator) initialize(getDefaultConfig());
+    return config;
+}
+
+QubitIndex RuntimeState::getQubit(std::uintptr_t id)
+{
+    Simulator &sim = getSimulator();
+    if (id >= sim.getNumQubits()) sim.addQubits(id + 1 - sim.getNumQubits());
+    return id;
+}
+
+void RuntimeState::setResult(std::uintptr_t id, bool value)
+{
+    if (id >= results.size()) results.resize(id + 1, 0);
+    results[id] = value;
+}
+
+bool RuntimeState::getResult(std::uintptr_t id) const
+{
+    return id < results.size() && results[id];
+}
+
+std::string RuntimeState::getBitstring() const
+{
+    std::string bits(results.size(), '0');
+    for (std::size_t id = 0; id < results.size(); ++id)
+        if (results[id]) bits[id] = '1';
+    return bits;
+}
+
+void RuntimeState::copyResults(std::uint8_t* out, std::size_t count) const
+{
+    const std::size_t known = std::min(count, results.size());
+    std::copy_n(results.begin(), known, out);
+    std::fill(out + known, out + count, 0);
+}
+
+void RuntimeState::seed(std::uint64_t value)
+{
+    seedValue = value;
+    random.reset(seedValue, stream);
+}
+
+void RuntimeState::setStream(std::uint64_t value)
+{
+    stream = value;
+    random.reset(seedValue, stream);
+}
+
+RuntimeState &quantum::runtime::getRuntimeState()
+{
+    thread_local RuntimeState state;
+    return state;
+}
@@ -0,0 +1,281 @@
+/// Implements the simulator backends of the runtime.
+///
+/// @file
+
+#include "quantum-mlir/Runtime/Simulator.h"
+
+#include "quantum-mlir/Runtime/Distributed.h"
+#include "quantum-mlir/Runtime/OutOfCore.h"
+
+#include <cmath>
+
+using namespace quantum::runtime;
+
+namespace {
+
+bool isScaledIdentity(const Matrix2 &m)
+{
+    return m[1] == Amplitude(0.0) && m[2] == Amplitude(0.0) && m[0] == m[3];
+}
+
+} // namespace
+
+bool quantum::runtime::parseBackend(std::string_view name, Backend &backend)
+{
+    if (name == "statevector" || name == "trajectory") {
+        backend = Backend::StateVector;
+        return true;
+    }
+    if (name == "density-matrix") {
+        backend = Backend::DensityMatrix;
+        return true;
+    }
+    return false;
+}
+
+//===----------------------------------------------------------------------===//
+// Simulator
+//===----------------------------------------------------------------------===//
+
+bool Simulator::measure(QubitIndex target, double sample)
+{
+    const double p1 = probabilityOfOne(target);
+    const bool outcome = sample < p1;
+    collapse(target, outcome, outcome ? p1 : 1.0 - p1);
+    return outcome;
+}
+
+void Simulator::reset(QubitIndex target, double sample)
+{
+    if (measure(target, sample)) applyMatrix(gates::x(), target);
+}
+
+//===----------------------------------------------------------------------===//
+// StateVectorSimulator
+//===----------------------------------------------------------------------===//
+
+void StateVectorSimulator::applyChannel(
+    const KrausChannel &channel,
+    QubitIndex target,
+    double sample)
+{
+    // A mixture of unitaries selects an operator independently of the state
+    // and needs no renormalisation. It is applied like any other gate, which
+    // lets derived simulators defer it.
+    if (channel.isUnitaryMixture()) {
+        const std::size_t k = sampleIndex(channel.mixture, sample);
+        const Matrix2 &op = channel.operators[k];
+        if (!isScaledIdentity(op))
+            applyMatrix(
+                gates::scaled(op, 1.0 / std::sqrt(channel.mixture[k])),
+                target);
+        return;
+    }
+
+    std::vector<double> weights;
+    weights.reserve(channel.operators.size());
+    for (const Matrix2 &op : channel.operators)
+        weights.push_back(kernels::normAfter(
+            state.data(),
+            state.getNumQubits(),
+            op,
+            target));
+
+    const std::size_t k = sampleIndex(weights, sample);
+    state.applyMatrix(channel.operators[k], target);
+    kernels::scale(
+        state.data(),
+        state.getNumQubits(),
+        1.0 / std::sqrt(weights[k]));
+}
+
+//===----------------------------------------------------------------------===//
+// DensityMatrixSimulator
+//===----------------------------------------------------------------------===//
+
+DensityMatrixSimulator::DensityMatrixSimulator() : numQubits(0), rho{1.0} {}
+
+void DensityMatrixSimulator::addQubits(std::size_t count)
+{
+    const std::size_t oldDim = std::size_t(1) << numQubits;
+    const std::size_t newQubits = numQubits + count;
+    std::vector<Amplitude> grown(std::size_t(1) << (2 * newQubits), 0.0);
+    for (std::size_t c = 0; c < oldDim; ++c)
+        for (std::size_t r = 0; r < oldDim; ++r)
+            grown[r | (c << newQubits)] = rho[r | (c << numQubits)];
+    numQubits = newQubits;
+    rho = std::move(grown);
+}
+
+void DensityMatrixSimulator::applyMatrix(const Matrix2 &m, QubitIndex target)
+{
+    kernels::applyMatrix(rho.data(), 2 * numQubits, m, target);
+    kernels::applyMatrix(
+        rho.data(),
+        2 * numQubits,
+        gates::conjugate(m),
+        target + numQubits);
+}
+
+void DensityMatrixSimulator::applyDiagonal(
+    Amplitude d0,
+    Amplitude d1,
+    QubitIndex target)
+{
+    kernels::applyDiagonal(rho.data(), 2 * numQubits, d0, d1, target);
+    kernels::applyDiagonal(
+        rho.data(),
+        2 * numQubits,
+        std::conj(d0),
+        std::conj(d1),
+        target + numQubits);
+}
+
+void DensityMatrixSimulator::applyControlled(
+    const Matrix2 &m,
+    QubitIndex control,
+    QubitIndex target)
+{
+    kernels::applyControlled(rho.data(), 2 * numQubits, m, control, target);
+    kernels::applyControlled(
+        rho.data(),
+        2 * numQubits,
+        gates::conjugate(m),
+        control + numQubits,
+        target + numQubits);
+}
+
+void DensityMatrixSimulator::applyDoublyControlled(
+    const Matrix2 &m,
+    QubitIndex control0,
+    QubitIndex control1,
+    QubitIndex target)
+{
+    kernels::applyDoublyControlled(
+        rho.data(),
+        2 * numQubits,
+        m,
+        control0,
+        control1,
+        target);
+    kernels::applyDoublyControlled(
+        rho.data(),
+        2 * numQubits,
+        gates::conjugate(m),
+        control0 + numQubits,
+        control1 + numQubits,
+        target + numQubits);
+}
+
+void DensityMatrixSimulator::swap(QubitIndex lhs, QubitIndex rhs)
+{
+    kernels::swap(rho.data(), 2 * numQubits, lhs, rhs);
+    kernels::swap(rho.data(), 2 * numQubits, lhs + numQubits, rhs + numQubits);
+}
+
+double DensityMatrixSimulator::probabilityOfOne(QubitIndex target)
+{
+    const std::size_t dim = std::size_t(1) << numQubits;
+    const std::size_t mask = std::size_t(1) << target;
+    double probability = 0.0;
+    for (std::size_t r = 0; r < dim; ++r)
+        if (r & mask) probability += rho[r | (r << numQubits)].real();
+    return probability;
+}
+
+void DensityMatrixSimulator::collapse(
+    QubitIndex target,
+    bool outcome,
+    double probability)
+{
+    const std::size_t dim = std::size_t(1) << numQubits;
+    const std::size_t mask = std::size_t(1) << target;
+    const std::size_t keep = outcome ? mask : 0;
+    const double factor = 1.0 / probability;
+    for (std::size_t c = 0; c < dim; ++c) {
+        for (std::size_t r = 0; r < dim; ++r) {
+            Amplitude &element = rho[r | (c << numQubits)];
+            if ((r & mask) == keep && (c & mask) == keep)
+                element *= factor;
+            else
+                element = 0.0;
+        }
+    }
+}
+
+void DensityMatrixSimulator::applyChannel(
+    const KrausChannel &channel,
+    QubitIndex target,
+    double)
+{
+    // Visit every 2x2 block of rho that couples the two values of the target
+    // qubit exactly once and apply all Kraus operators to it in registers,
+    // so the channel costs a single pass over memory.
+    const std::size_t half = std::size_t(1) << (numQubits - 1);
+    const std::size_t mask = std::size_t(1) << target;
+    const std::size_t low = mask - 1;
+    const auto spread = [&](std::size_t i) {
+        return ((i & ~low) << 1) | (i & low);
+    };
+
+    for (std::size_t ci = 0; ci < half; ++ci) {
+        const std::size_t c0 = spread(ci) << numQubits;
+        const std::size_t c1 = c0 | (mask << numQubits);
+        for (std::size_t ri = 0; ri < half; ++ri) {
+            const std::size_t r0 = spread(ri);
+            const std::size_t r1 = r0 | mask;
+            const Matrix2 block{
+                rho[r0 | c0],
+                rho[r0 | c1],
+                rho[r1 | c0],
+                rho[r1 | c1]};
+
+            Matrix2 sum{0.0, 0.0, 0.0, 0.0};
+            for (const Matrix2 &k : channel.operators) {
+                const Matrix2 kb = gates::multiply(k, block);
+                // (K B) K^dagger
+                sum[0] += kb[0] * std::conj(k[0]) + kb[1] * std::conj(k[1]);
+                sum[1] += kb[0] * std::conj(k[2]) + kb[1] * std::conj(k[3]);
+                sum[2] += kb[2] * std::conj(k[0]) + kb[3] * std::conj(k[1]);
+                sum[3] += kb[2] * std::conj(k[2]) + kb[3] * std::conj(k[3]);
+            }
+
+            rho[r0 | c0] = sum[0];
+            rho[r0 | c1] = sum[1];
+            rho[r1 | c0] = sum[2];
+            rho[r1 | c1] = sum[3];
+        }
+    }
+}
+
+void DensityMatrixSimulator::reset(QubitIndex target, double sample)
+{
+    // Resetting is the channel {|0><0|, |0><1|}; it needs no sampling.
+    KrausChannel channel;
+    channel.operators = {
+        {1.0, 0.0, 0.0, 0.0},
+        {0.0, 1.0, 0.0, 0.0}
+    };
+    applyChannel(channel, target, sample);
+}
+
+//===----------------------------------------------------------------------===//
+// Factory
+//===----------------------------------------------------------------------===//
+
+std::unique_ptr<Simulator> quantum::runtime::createSimulator(
+    Backend backend,
+    const StorageOptions &storage)
+{
+    switch (backend) {
+    case Backend::StateVector:
+        if (Communicator* world = getWorldCommunicator())
+            return std::make_unique<DistributedSimulator>(*world, storage);
+        if (storage.kind == StorageKind::MappedFile || storage.chunkQubits > 0)
+            return std::make_unique<OutOfCoreSimulator>(storage);
+        return std::make_unique<StateVectorSimulator>(storage);
+    case Backend::DensityMatrix:
+        return std::make_unique<DensityMatrixSimulator>();
+    }
+    return nullptr;
+}
@@ -0,0 +1,228 @@
+/// Implements the state-vector kernels of the simulator runtime.
+///
+/// @file
+
+#include "quantum-mlir/Runtime/StateVector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+using namespace quantum::runtime;
+
+namespace {
+
+/// Inserts a zero bit at position @p bit of @p index .
+inline std::size_t insertZeroBit(std::size_t index, QubitIndex bit)
+{
+    const std::size_t low = index & ((std::size_t(1) << bit) - 1);
+    return ((index >> bit) << (bit + 1)) | low;
+}
+
+/// Inserts zero bits at the positions @p lo < @p hi of @p index .
+inline std::size_t
+insertZeroBits(std::size_t index, QubitIndex lo, QubitIndex hi)
+{
+    return insertZeroBit(insertZeroBit(index, lo), hi);
+}
+
+inline std::size_t bit(QubitIndex qubit) { return std::size_t(1) << qubit; }
+
+} // namespace
+
+//===----------------------------------------------------------------------===//
+// kernels
+//===----------------------------------------------------------------------===//
+
+void kernels::applyMatrix(
+    Amplitude* amps,
+    std::size_t numQubits,
+    const Matrix2 &m,
+    QubitIndex target)
+{
+    assert(target < numQubits && "target out of range");
+    const std::size_t pairs = std::size_t(1) << (numQubits - 1);
+    const std::size_t stride = bit(target);
+    for (std::size_t i = 0; i < pairs; ++i) {
+        const std::size_t i0 = insertZeroBit(i, target);
+        const std::size_t i1 = i0 | stride;
+        const Amplitude a0 = amps[i0], a1 = amps[i1];
+        amps[i0] = m[0] * a0 + m[1] * a1;
+        amps[i1] = m[2] * a0 + m[3] * a1;
+    }
+}
+
+void kernels::applyDiagonal(
+    Amplitude* amps,
+    std::size_t numQubits,
+    Amplitude d0,
+    Amplitude d1,
+    QubitIndex target)
+{
+    assert(target < numQubits && "target out of range");
+    const std::size_t pairs = std::size_t(1) << (numQubits - 1);
+    const std::size_t stride = bit(target);
+    const bool scaleLow = d0 != Amplitude(1.0);
+    for (std::size_t i = 0; i < pairs; ++i) {
+        const std::size_t i0 = insertZeroBit(i, target);
+        if (scaleLow) amps[i0] *= d0;
+        amps[i0 | stride] *= d1;
+    }
+}
+
+void kernels::applyControlled(
+    Amplitude* amps,
+    std::size_t numQubits,
+    const Matrix2 &m,
+    QubitIndex control,
+    QubitIndex target)
+{
+    assert(control != target && "control and target must differ");
+    assert(std::max(control, target) < numQubits && "qubit out of range");
+    const std::size_t quads = std::size_t(1) << (numQubits - 2);
+    const auto [lo, hi] = std::minmax(control, target);
+    for (std::size_t i = 0; i < quads; ++i) {
+        const std::size_t i0 = insertZeroBits(i, lo, hi) | bit(control);
+        const std::size_t i1 = i0 | bit(target);
+        const Amplitude a0 = amps[i0], a1 = amps[i1];
+        amps[i0] = m[0] * a0 + m[1] * a1;
+        amps[i1] = m[2] * a0 + m[3] * a1;
+    }
+}
+
+void kernels::applyDoublyControlled(
+    Amplitude* amps,
+    std::size_t numQubits,
+    const Matrix2 &m,
+    QubitIndex control0,
+    QubitIndex control1,
+    QubitIndex target)
+{
+    assert(
+        control0 != control1 && control0 != target && control1 != target
+        && "qubits must be distinct");
+    std::array<QubitIndex, 3> sorted{control0, control1, target};
+    std::sort(sorted.begin(), sorted.end());
+    assert(sorted[2] < numQubits && "qubit out of range");
+    const std::size_t octs = std::size_t(1) << (numQubits - 3);
+    const std::size_t controls = bit(control0) | bit(control1);
+    for (std::size_t i = 0; i < octs; ++i) {
+        std::size_t base = i;
+        for (QubitIndex q : sorted) base = insertZeroBit(base, q);
+        const std::size_t i0 = base | controls;
+        const std::size_t i1 = i0 | bit(target);
+        const Amplitude a0 = amps[i0], a1 = amps[i1];
+        amps[i0] = m[0] * a0 + m[1] * a1;
+        amps[i1] = m[2] * a0 + m[3] * a1;
+    }
+}
+
+void kernels::swap(
+    Amplitude* amps,
+    std::size_t numQubits,
+    QubitIndex lhs,
+    QubitIndex rhs)
+{
+    if (lhs == rhs) return;
+    assert(std::max(lhs, rhs) < numQubits && "qubit out of range");
+    const std::size_t quads = std::size_t(1) << (numQubits - 2);
+    const auto [lo, hi] = std::minmax(lhs, rhs);
+    for (std::size_t i = 0; i < quads; ++i) {
+        const std::size_t base = insertZeroBits(i, lo, hi);
+        std::swap(amps[base | bit(lhs)], amps[base | bit(rhs)]);
+    }
+}
+
+double kernels::probabilityOfOne(
+    const Amplitude* amps,
+    std::size_t numQubits,
+    QubitIndex target)
+{
+    assert(target < numQubits && "target out of range");
+    const std::size_t pairs = std::size_t(1) << (numQubits - 1);
+    double probability = 0.0;
+    for (std::size_t i = 0; i < pairs; ++i)
+        probability += std::norm(amps[insertZeroBit(i, target) | bit(target)]);
+    return probability;
+}
+
+void kernels::collapse(
+    Amplitude* amps,
+    std::size_t numQubits,
+    QubitIndex target,
+    bool outcome,
+    double probability)
+{
+    assert(probability > 0.0 && "cannot collapse onto an impossible outcome");
+    const std::size_t pairs = std::size_t(1) << (numQubits - 1);
+    const double factor = 1.0 / std::sqrt(probability);
+    const std::size_t keep = outcome ? bit(target) : 0;
+    const std::size_t drop = outcome ? 0 : bit(target);
+    for (std::size_t i = 0; i < pairs; ++i) {
+        const std::size_t base = insertZeroBit(i, target);
+        amps[base | keep] *= factor;
+        amps[base | drop] = 0.0;
+    }
+}
+
+double kernels::normAfter(
+    const Amplitude* amps,
+    std::size_t numQubits,
+    const Matrix2 &m,
+    QubitIndex target)
+{
+    const std::size_t pairs = std::size_t(1) << (numQubits - 1);
+    const std::size_t stride = bit(target);
+    double norm = 0.0;
+    for (std::size_t i = 0; i < pairs; ++i) {
+        const std::size_t i0 = insertZeroBit(i, target);
+        const Amplitude a0 = amps[i0], a1 = amps[i0 | stride];
+        norm += std::norm(m[0] * a0 + m[1] * a1)
+                + std::norm(m[2] * a0 + m[3] * a1);
+    }
+    return norm;
+}
+
+void kernels::scale(Amplitude* amps, std::size_t numQubits, double factor)
+{
+    const std::size_t size = std::size_t(1) << numQubits;
+    for (std::size_t i = 0; i < size; ++i) amps[i] *= factor;
+}
+
+void kernels::scaleWhere(
+    Amplitude* amps,
+    std::size_t numQubits,
+    std::size_t mask,
+    Amplitude factor)
+{
+    if (factor == Amplitude(1.0)) return;
+    const std::size_t size = std::size_t(1) << numQubits;
+    for (std::size_t i = 0; i < size; ++i)
+        if ((i & mask) == mask) amps[i] *= factor;
+}
+
+//===----------------------------------------------------------------------===//
+// StateVector
+//===----------------------------------------------------------------------===//
+
+StateVector::StateVector(std::size_t numQubits, const StorageOptions &options)
+        : amplitudes(options)
+{
+    reset(numQubits);
+}
+
+void StateVector::reset(std::size_t count)
+{
+    numQubits = count;
+    amplitudes.assign(std::size_t(1) << count);
+    amplitudes.data()[0] = 1.0;
+}
+
+void StateVector::addQubits(std::size_t count)
+{
+    // New qubits are |0>, so the existing amplitudes keep their indices and
+    // the upper part of the enlarged vector stays zero.
+    numQubits += count;
+    amplitudes.resize(std::size_t(1) << numQubits);
+}
@@ -0,0 +1,126 @@
+/// Implements the amplitude storage of the simulator runtime.
+///
+/// @file
+
+#include "quantum-mlir/Runtime/Storage.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace quantum::runtime;
+
+bool quantum::runtime::parseStorageKind(
+    std::string_view name,
+    StorageKind &kind)
+{
+    if (name == "memory") {
+        kind = StorageKind::Memory;
+        return true;
+    }
+    if (name == "mmap") {
+        kind = StorageKind::MappedFile;
+        return true;
+    }
+    return false;
+}
+
+AmplitudeStorage::AmplitudeStorage(const StorageOptions &options)
+        : kind(options.kind),
+          directory(options.directory)
+{
+    if (kind != StorageKind::MappedFile) return;
+
+    if (directory.empty()) {
+        const char* tmp = std::getenv("TMPDIR");
+        directory = tmp && *tmp ? tmp : "/tmp";
+    }
+    std::string path = directory + "/quantum-state-XXXXXX";
+    fd = mkstemp(path.data());
+    if (fd < 0) {
+        std::fprintf(
+            stderr,
+            "quantum-runtime: cannot create '%s': %s, using memory storage\n",
+            path.c_str(),
+            std::strerror(errno));
+        kind = StorageKind::Memory;
+        return;
+    }
+    // The file only lives as long as the descriptor.
+    unlink(path.c_str());
+}
+
+AmplitudeStorage::~AmplitudeStorage()
+{
+    unmap();
+    if (fd >= 0) close(fd);
+}
+
+void AmplitudeStorage::assign(std::size_t newCount)
+{
+    if (kind == StorageKind::Memory) {
+        heap.assign(newCount, Amplitude(0.0));
+        amplitudes = heap.data();
+        count = newCount;
+        return;
+    }
+
+    // Truncating to zero first discards all pages, so the file is sparse and
+    // reads as zero without touching the disk.
+    unmap();
+    if (ftruncate(fd, 0) != 0 || !map(newCount)) std::abort();
+}
+
+void AmplitudeStorage::resize(std::size_t newCount)
+{
+    if (kind == StorageKind::Memory) {
+        heap.resize(newCount, Amplitude(0.0));
+        amplitudes = heap.data();
+        count = newCount;
+        return;
+    }
+
+    // The file keeps the contents, and extending it appends zeros.
+    unmap();
+    if (!map(newCount)) std::abort();
+}
+
+bool AmplitudeStorage::map(std::size_t newCount)
+{
+    const std::size_t bytes = newCount * sizeof(Amplitude);
+    if (bytes == 0) return true;
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        std::fprintf(
+            stderr,
+            "quantum-runtime: cannot grow state file to %zu bytes: %s\n",
+            bytes,
+            std::strerror(errno));
+        return false;
+    }
+    void* ptr =
+        mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (ptr == MAP_FAILED) {
+        std::fprintf(
+            stderr,
+            "quantum-runtime: cannot map state file: %s\n",
+            std::strerror(errno));
+        return false;
+    }
+    // Gates are applied in passes over contiguous chunks.
+    madvise(ptr, bytes, MADV_SEQUENTIAL);
+    amplitudes = static_cast<Amplitude*>(ptr);
+    count = newCount;
+    return true;
+}
+
+void AmplitudeStorage::unmap()
+{
+    if (kind == StorageKind::MappedFile && amplitudes)
+        munmap(amplitudes, count * sizeof(Amplitude));
+    amplitudes = nullptr;
+    count = 0;
+}
@@ -0,0 +1,153 @@
+/// Implements the parallel trajectory engine of the simulator runtime.
+///
+/// @file
+
+#include "quantum-mlir/Runtime/Trajectories.h"
+
+#include "quantum-mlir/Runtime/Communicator.h"
+#include "quantum-mlir/Runtime/Runtime.h"
+
+#include <algorithm>
+
+using namespace quantum::runtime;
+
+//===----------------------------------------------------------------------===//
+// ThreadPool
+//===----------------------------------------------------------------------===//
+
+ThreadPool::ThreadPool(unsigned threads)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    workers.reserve(threads - 1);
+    for (unsigned rank = 1; rank < threads; ++rank)
+        workers.emplace_back([this, rank] { work(rank); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (std::thread &worker : workers) worker.join();
+}
+
+void ThreadPool::parallelFor(std::size_t newCount, const Task &newTask)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = &newTask;
+        count = newCount;
+        next.store(0, std::memory_order_relaxed);
+        busy = workers.size();
+        ++generation;
+    }
+    wakeUp.notify_all();
+
+    drain(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return busy == 0; });
+    task = nullptr;
+}
+
+void ThreadPool::work(unsigned rank)
+{
+    std::uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+
+        drain(rank);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busy == 0) done.notify_one();
+    }
+}
+
+void ThreadPool::drain(unsigned rank)
+{
+    for (std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+         index < count;
+         index = next.fetch_add(1, std::memory_order_relaxed))
+        (*task)(index, rank);
+}
+
+//===----------------------------------------------------------------------===//
+// Trajectories
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+/// Returns the number of workers for @p count trajectories on @p threads
+/// threads, where 0 selects the hardware concurrency.
+unsigned getNumWorkers(std::size_t count, unsigned threads)
+{
+    // Distributed trajectories are collective operations of all ranks and
+    // must not overlap.
+    if (getWorldCommunicator()) return 1;
+    return static_cast<unsigned>(std::min<std::size_t>(
+        threads ? threads : std::thread::hardware_concurrency(),
+        std::max<std::size_t>(count, 1)));
+}
+
+/// Runs trajectory @p index of @p kernel on the state of the calling thread,
+/// starting from @p config .
+RuntimeState &runTrajectory(
+    void (*kernel)(),
+    std::size_t index,
+    const RuntimeConfig &config)
+{
+    RuntimeState &state = getRuntimeState();
+    state.initialize(config);
+    state.setStream(index);
+    kernel();
+    return state;
+}
+
+} // namespace
+
+Histogram quantum::runtime::runTrajectories(
+    void (*kernel)(),
+    std::size_t count,
+    unsigned threads)
+{
+    // The workers start from the options of the calling thread, e.g. those
+    // the driver passed to __quantum__rt__initialize.
+    const RuntimeConfig config = getRuntimeState().getConfig();
+    ThreadPool pool(getNumWorkers(count, threads));
+
+    std::vector<Histogram> partial(pool.getNumThreads());
+    pool.parallelFor(count, [&](std::size_t index, unsigned rank) {
+        ++partial[rank][runTrajectory(kernel, index, config).getBitstring()];
+    });
+
+    // Every worker wrote only to its own histogram, and parallelFor() has
+    // joined them, so the merge needs no synchronisation.
+    Histogram histogram = std::move(partial.front());
+    for (std::size_t rank = 1; rank < partial.size(); ++rank)
+        for (const auto &[bits, hits] : partial[rank]) histogram[bits] += hits;
+    return histogram;
+}
+
+std::unique_ptr<std::uint8_t[]> quantum::runtime::runShots(
+    void (*kernel)(),
+    std::size_t shots,
+    std::size_t numResults,
+    unsigned threads)
+{
+    const RuntimeConfig config = getRuntimeState().getConfig();
+    auto buffer = std::make_unique<std::uint8_t[]>(shots * numResults);
+    ThreadPool pool(getNumWorkers(shots, threads));
+    pool.parallelFor(shots, [&](std::size_t index, unsigned) {
+        runTrajectory(kernel, index, config)
+            .copyResults(buffer.get() + index * numResults, numResults);
+    });
+    return buffer;
+}
@@ -0,0 +1,286 @@
+//===- TargetQIR.cpp - QIR profile LLVM IR Translation --------------------===//
+//
+// Lower quantum and qir dialect modules to LLVM IR that conforms to the QIR
+// base and adaptive profiles.
+//
+/// @file
+//===----------------------------------------------------------------------===//
+
+#include "quantum-mlir/Target/qir/TargetQIR.h"
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Pass/PassManager.h"
+#include "mlir/Pass/PassRegistry.h"
+#include "mlir/Target/LLVMIR/Dialect/Builtin/BuiltinToLLVMIRTranslation.h"
+#include "mlir/Target/LLVMIR/Dialect/LLVMIR/LLVMToLLVMIRTranslation.h"
+#include "mlir/Target/LLVMIR/Export.h"
+#include "quantum-mlir/Pipeline/Compile.h"
+
+#include <cstdint>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringSet.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Support/raw_ostream.h>
+#include <string>
+
+using namespace mlir;
+using namespace mlir::qir;
+
+namespace {
+
+/// The runtime functions the profiles allow besides the QIS.
+const llvm::StringSet<> kRuntimeFunctions = {
+    "__quantum__rt__initialize",
+    "__quantum__rt__array_record_output",
+    "__quantum__rt__result_record_output",
+    "__quantum__rt__tuple_record_output",
+};
+
+/// The QIS functions of the simulator runtime that no profile knows.
+const llvm::StringSet<> kSimulatorFunctions = {
+    "__quantum__qis__amplitude_damping__body",
+    "__quantum__qis__depolarizing__body",
+    "__quantum__qis__readout_error__body",
+};
+
+constexpr llvm::StringLiteral kReadResult = "__quantum__qis__read_result__body";
+
+StringRef getProfileName(QIRProfile profile)
+{
+    return profile == QIRProfile::Base ? "base_profile" : "adaptive_profile";
+}
+
+/// Runs the textual @p pipeline on @p module .
+LogicalResult runPipeline(ModuleOp module, StringRef pipeline)
+{
+    registerPipelinePasses();
+    PassManager pm(module.getContext());
+    std::string errors;
+    llvm::raw_string_ostream errorStream(errors);
+    if (failed(parsePassPipeline(pipeline, pm, errorStream)))
+        return module.emitError("invalid pass pipeline: ") << errors;
+    return pm.run(module);
+}
+
+/// Returns the count @p name that convert-qir-to-llvm attaches to @p module
+/// from its allocation analysis, or 0 if it is missing.
+std::int64_t getRequiredCount(ModuleOp module, StringRef name)
+{
+    auto count = module->getAttrOfType<IntegerAttr>(name);
+    return count ? count.getInt() : 0;
+}
+
+/// Returns the name of the entry point of @p module .
+FailureOr<std::string> findEntryPoint(ModuleOp module, StringRef requested)
+{
+    if (!requested.empty()) {
+        auto func = module.lookupSymbol<func::FuncOp>(requested);
+        if (!func || func.isExternal())
+            return module.emitError("unknown entry point '")
+                   << requested << "'";
+        return requested.str();
+    }
+
+    func::FuncOp entry;
+    for (auto func : module.getOps<func::FuncOp>()) {
+        if (func.isExternal() || !func.isPublic()) continue;
+        if (entry)
+            return module.emitError(
+                "several public functions, select the entry point with "
+                "--qir-entry-point");
+        entry = func;
+    }
+    if (!entry) return module.emitError("no public function to use as entry");
+    return entry.getSymName().str();
+}
+
+/// Checks that @p llvmModule only calls functions of @p profile . Reads of
+/// results that are never used are removed, since the lowering of the quantum
+/// dialect reads every measurement.
+LogicalResult checkCalls(
+    ModuleOp module,
+    llvm::Module &llvmModule,
+    QIRProfile profile)
+{
+    SmallVector<llvm::CallInst*> unusedReads;
+    for (llvm::Function &function : llvmModule) {
+        for (llvm::Instruction &inst : llvm::instructions(function)) {
+            auto* call = dyn_cast<llvm::CallInst>(&inst);
+            if (!call) continue;
+            llvm::Function* callee = call->getCalledFunction();
+            if (!callee)
+                return module.emitError("indirect calls are not part of the ")
+                       << getProfileName(profile);
+            if (!callee->isDeclaration() || callee->isIntrinsic()) continue;
+
+            const StringRef name = callee->getName();
+            if (name == kReadResult) {
+                if (call->use_empty())
+                    unusedReads.push_back(call);
+                else if (profile == QIRProfile::Base)
+                    return module.emitError(
+                        "reading a result is not part of the base_profile, "
+                        "use the adaptive profile");
+                continue;
+            }
+            const bool allowed = name.starts_with("__quantum__qis__")
+                                     ? !kSimulatorFunctions.contains(name)
+                                     : kRuntimeFunctions.contains(name);
+            if (!allowed)
+                return module.emitError("'")
+                       << name << "' is not part of the "
+                       << getProfileName(profile);
+        }
+    }
+    for (llvm::CallInst* call : unusedReads) call->eraseFromParent();
+    if (llvm::Function* read = llvmModule.getFunction(kReadResult))
+        if (read->use_empty()) read->eraseFromParent();
+    return success();
+}
+
+/// Adds the initialization, the output recording and the attributes of the
+/// entry point @p entry .
+void finalizeEntryPoint(
+    llvm::Function &entry,
+    QIRProfile profile,
+    std::int64_t numQubits,
+    std::int64_t numResults)
+{
+    llvm::Module &llvmModule = *entry.getParent();
+    llvm::LLVMContext &ctx = llvmModule.getContext();
+    auto* ptrType = llvm::PointerType::getUnqual(ctx);
+    auto* voidType = llvm::Type::getVoidTy(ctx);
+    auto* i64Type = llvm::Type::getInt64Ty(ctx);
+    llvm::IRBuilder<> builder(ctx);
+
+    // The runtime must be initialized before the first quantum instruction.
+    const auto calls = [&](StringRef name) {
+        llvm::Function* function = llvmModule.getFunction(name);
+        return function && !function->use_empty();
+    };
+    if (!calls("__quantum__rt__initialize")) {
+        auto initialize = llvmModule.getOrInsertFunction(
+            "__quantum__rt__initialize",
+            voidType,
+            ptrType);
+        builder.SetInsertPoint(
+            &entry.getEntryBlock(),
+            entry.getEntryBlock().getFirstInsertionPt());
+        builder.CreateCall(
+            initialize,
+            {llvm::ConstantPointerNull::get(ptrType)});
+    }
+
+    // Without explicit output recording, every result is recorded in the
+    // order of the allocations before the program returns.
+    if (!calls("__quantum__rt__result_record_output")
+        && !calls("__quantum__rt__tuple_record_output")
+        && !calls("__quantum__rt__array_record_output")) {
+        auto record = llvmModule.getOrInsertFunction(
+            "__quantum__rt__result_record_output",
+            voidType,
+            ptrType,
+            ptrType);
+        for (llvm::BasicBlock &block : entry) {
+            auto* ret = dyn_cast<llvm::ReturnInst>(block.getTerminator());
+            if (!ret) continue;
+            builder.SetInsertPoint(ret);
+            for (std::int64_t id = 0; id < numResults; ++id)
+                builder.CreateCall(
+                    record,
+                    {llvm::ConstantExpr::getIntToPtr(
+                         llvm::ConstantInt::get(i64Type, id),
+                         ptrType),
+                     llvm::ConstantPointerNull::get(ptrType)});
+        }
+    }
+
+    entry.addFnAttr("entry_point");
+    entry.addFnAttr("output_labeling_schema");
+    entry.addFnAttr("qir_profiles", getProfileName(profile));
+    entry.addFnAttr("required_num_qubits", std::to_string(numQubits));
+    entry.addFnAttr("required_num_results", std::to_string(numResults));
+
+    for (StringRef name :
+         {"__quantum__qis__mz__body", "__quantum__qis__reset__body"})
+        if (llvm::Function* function = llvmModule.getFunction(name))
+            function->addFnAttr("irreversible");
+
+    // Qubits and results are addressed statically by their allocation.
+    auto* i1Type = llvm::Type::getInt1Ty(ctx);
+    llvmModule.addModuleFlag(llvm::Module::Error, "qir_major_version", 1);
+    llvmModule.addModuleFlag(llvm::Module::Max, "qir_minor_version", 0);
+    llvmModule.addModuleFlag(
+        llvm::Module::Error,
+        "dynamic_qubit_management",
+        llvm::ConstantInt::getFalse(i1Type));
+    llvmModule.addModuleFlag(
+        llvm::Module::Error,
+        "dynamic_result_allocation",
+        llvm::ConstantInt::getFalse(i1Type));
+}
+
+} // namespace
+
+LogicalResult mlir::qir::translateToQIRProfile(
+    Operation* op,
+    raw_ostream &os,
+    const QIRProfileOptions &options)
+{
+    auto module = dyn_cast<ModuleOp>(op);
+    if (!module) return op->emitError("expected a module");
+
+    const auto entryName = findEntryPoint(module, options.entryPoint);
+    if (failed(entryName)) return failure();
+
+    if (failed(runPipeline(module, kDefaultLoweringPipeline)))
+        return failure();
+    const std::int64_t numQubits =
+        getRequiredCount(module, "qir.required_num_qubits");
+    const std::int64_t numResults =
+        getRequiredCount(module, "qir.required_num_results");
+    registerBuiltinDialectTranslation(*module.getContext());
+    registerLLVMDialectTranslation(*module.getContext());
+    llvm::LLVMContext llvmContext;
+    auto llvmModule = translateModuleToLLVMIR(module, llvmContext);
+    if (!llvmModule)
+        return module.emitError("cannot translate the module to LLVM IR");
+
+    llvm::Function* entry = llvmModule->getFunction(*entryName);
+    if (!entry || entry->isDeclaration() || !entry->arg_empty())
+        return module.emitError("entry point '")
+               << *entryName << "' must not take arguments";
+    if (failed(checkCalls(module, *llvmModule, options.profile)))
+        return failure();
+    const auto isConditional = [](llvm::Instruction* terminator) {
+        auto* branch = dyn_cast<llvm::BranchInst>(terminator);
+        return (branch && branch->isConditional())
+               || isa<llvm::SwitchInst>(terminator);
+    };
+    if (options.profile == QIRProfile::Base
+        && llvm::any_of(*entry, [&](llvm::BasicBlock &block) {
+               return isConditional(block.getTerminator());
+           }))
+        return module.emitError(
+            "conditional branches are not part of the base_profile");
+    finalizeEntryPoint(*entry, options.profile, numQubits, numResults);
+
+    std::string errors;
+    llvm::raw_string_ostream errorStream(errors);
+    if (llvm::verifyModule(*llvmModule, &errorStream))
+        return module.emitError("invalid QIR: ") << errors;
+
+    if (options.emitBitcode)
+        llvm::WriteBitcodeToFile(*llvmModule, os);
+    else
+        llvmModule->print(os, nullptr);
+    return success();
+}
@@ -0,0 +1,65 @@
+//===- TargetQIRRegistration.cpp - Register QIR profile Translations ------===//
+//
+// Registers the translations to QIR base and adaptive profile LLVM IR.
+//
+/// @file
+//===----------------------------------------------------------------------===//
+
+#include "mlir/InitAllDialects.h"
+#include "mlir/InitAllExtensions.h"
+#include "mlir/Support/LogicalResult.h"
+#include "mlir/Tools/mlir-translate/Translation.h"
+#include "quantum-mlir/Dialect/QIR/IR/QIRBase.h"
+#include "quantum-mlir/Dialect/Quantum/IR/QuantumBase.h"
+#include "quantum-mlir/Target/qir/TargetQIR.h"
+
+#include <llvm/Support/CommandLine.h>
+#include <string>
+
+using namespace mlir;
+using namespace mlir::qir;
+
+//===----------------------------------------------------------------------===//
+// QIR profile registration
+//===----------------------------------------------------------------------===//
+
+void mlir::qir::registerQIRProfileTranslations()
+{
+    static llvm::cl::opt<std::string> entryPoint(
+        "qir-entry-point",
+        llvm::cl::desc("The entry point of the QIR program, by default the "
+                       "only public function"),
+        llvm::cl::init(""));
+    static llvm::cl::opt<bool> emitBitcode(
+        "qir-emit-bitcode",
+        llvm::cl::desc("Emit QIR as LLVM bitcode instead of text"),
+        llvm::cl::init(false));
+
+    const auto registerDialects = [](DialectRegistry &registry) {
+        // The translation runs the full lowering pipeline.
+        registerAllDialects(registry);
+        registerAllExtensions(registry);
+        registry.insert<quantum::QuantumDialect>();
+        registry.insert<qir::QIRDialect>();
+    };
+    const auto translate = [](QIRProfile profile) {
+        return [profile](Operation* op, raw_ostream &os) -> LogicalResult {
+            QIRProfileOptions options;
+            options.profile = profile;
+            options.entryPoint = entryPoint;
+            options.emitBitcode = emitBitcode;
+            return translateToQIRProfile(op, os, options);
+        };
+    };
+
+    TranslateFromMLIRRegistration base(
+        "mlir-to-qir-base",
+        "Translate to QIR base profile LLVM IR",
+        translate(QIRProfile::Base),
+        registerDialects);
+    TranslateFromMLIRRegistration adaptive(
+        "mlir-to-qir-adaptive",
+        "Translate to QIR adaptive profile LLVM IR",
+        translate(QIRProfile::Adaptive),
+        registerDialects);
+}
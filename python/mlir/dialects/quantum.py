@@ -0,0 +1,3 @@
+from .._mlir_libs._mlirDialectsQuantum import *
+from .._mlir_libs._mlirDialectsQuantum.quantum import *
+from ._quantum_ops_gen import *
@@ -0,0 +1,40 @@
+#  Lowering pipeline with an on-disk artifact cache.
+#
+#  Example:
+#    data, cached = compile_module(module, emit="obj", cache_dir="/tmp/qc")
+#    shots = execute(module, shots=1000)  # numpy.ndarray of shape (1000, n)
+from ._mlir_libs._mlirQuantumPipeline import *
+from ._mlir_libs._mlirQuantumPipeline import runtime_library, run_shots
+
+
+def execute(
+    module,
+    entry="main",
+    shots=1,
+    threads=0,
+    shared_libs=(),
+    cache_dir=None,
+    opt_level=2,
+):
+    """Compiles `module` and runs its entry point `entry` once per shot.
+
+    Returns the result registers of every shot as a uint8 NumPy array of
+    shape (shots, results) that wraps the buffer of the runtime. The entry
+    point must not take arguments.
+    """
+    from .execution_engine import ExecutionEngine
+    from .ir import IntegerAttr, Module
+
+    data, _ = compile_module(module, cache_dir=cache_dir)
+    lowered = Module.parse(data.decode(), context=module.context)
+    attributes = lowered.operation.attributes
+    num_results = 0
+    if "qir.required_num_results" in attributes:
+        num_results = IntegerAttr(attributes["qir.required_num_results"]).value
+
+    engine = ExecutionEngine(
+        lowered,
+        opt_level=opt_level,
+        shared_libs=[runtime_library(), *shared_libs],
+    )
+    return run_shots(engine.raw_lookup(entry), shots, num_results, threads)
@@ -80,4 +80,33 @@ module {
     // CHECK-DAG: return %[[Q1]]
     func.return %q0 : !qir.qubit
   }
+
+  // CHECK: "quantum.gate"() <{function_type = (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>), sym_name = "first_only"}> ({
+  "qir.gate"() <{function_type = (!qir.qubit, !qir.qubit) -> (), sym_name = "first_only"}> ({
+    // CHECK-NEXT: ^bb0(%[[A0:.+]]: !quantum.qubit<1>, %[[A1:.+]]: !quantum.qubit<1>):
+    ^bb0(%arg1: !qir.qubit, %arg2: !qir.qubit):
+    // CHECK-NEXT: %[[A2:.+]] = "quantum.H"(%[[A0]])
+    "qir.H"(%arg1) : (!qir.qubit) -> ()
+    // CHECK-NEXT: %[[A3:.+]] = "quantum.X"(%[[A2]])
+    "qir.X"(%arg1) : (!qir.qubit) -> ()
+    // CHECK-NEXT: "quantum.return"(%[[A3]], %[[A1]])
+    "qir.return"() : () -> ()
+  }) : () -> ()
+
+  // CHECK-LABEL: func.func @check_chains_per_function(
+  // CHECK-SAME: %[[ARG:.+]]: !quantum.qubit<1>) -> !quantum.qubit<1> {
+  func.func @check_chains_per_function(%arg0: !qir.qubit) -> (!qir.qubit) {
+    // CHECK-DAG: %[[Q0:.+]] = "quantum.alloc"()
+    %q0 = "qir.alloc" () : () -> (!qir.qubit)
+    // CHECK-DAG: %[[Q1:.+]] = "quantum.H"(%[[ARG]])
+    "qir.H" (%arg0) : (!qir.qubit) -> ()
+    // CHECK-DAG: %[[Q2:.+]]:2 = "quantum.call"(%[[Q0]], %[[Q1]]) <{callee = @first_only}>
+    "qir.call"(%q0, %arg0) <{callee = @first_only}> : (!qir.qubit, !qir.qubit) -> ()
+    // CHECK-DAG: %[[Q3:.+]], %[[Q4:.+]] = "quantum.CNOT"(%[[Q2]]#1, %[[Q2]]#0)
+    "qir.CNOT"(%arg0, %q0) : (!qir.qubit, !qir.qubit) -> ()
+    // CHECK-DAG: "quantum.deallocate"(%[[Q4]])
+    "qir.reset" (%q0) : (!qir.qubit) -> ()
+    // CHECK-DAG: return %[[Q3]]
+    func.return %arg0 : !qir.qubit
+  }
 }
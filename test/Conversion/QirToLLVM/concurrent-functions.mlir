@@ -0,0 +1,50 @@
+// RUN: quantum-opt %s --convert-qir-to-llvm | FileCheck %s
+// RUN: quantum-opt %s --convert-qir-to-llvm --mlir-disable-threading \
+// RUN: | FileCheck %s
+
+// Functions are converted concurrently, but qubits and results are numbered
+// across the module in walk order, and every runtime function is declared
+// once before the functions. The module records the sizes of the registers.
+
+// CHECK: module attributes
+// CHECK-SAME: qir.required_num_qubits = 4 : i64
+// CHECK-SAME: qir.required_num_results = 2 : i64
+// CHECK: llvm.func @__quantum__qis__h__body(!llvm.ptr)
+// CHECK-NOT: llvm.func @__quantum__qis__h__body
+
+// CHECK-LABEL: func.func @first
+func.func @first() {
+  // CHECK: llvm.mlir.constant(0 : i64)
+  %q0 = "qir.alloc"() : () -> (!qir.qubit)
+  // CHECK: llvm.mlir.constant(1 : i64)
+  %q1 = "qir.alloc"() : () -> (!qir.qubit)
+  // CHECK: llvm.call @__quantum__qis__h__body
+  "qir.H"(%q0) : (!qir.qubit) -> ()
+  // CHECK: llvm.call @__quantum__qis__cnot__body
+  "qir.CNOT"(%q0, %q1) : (!qir.qubit, !qir.qubit) -> ()
+  return
+}
+
+// CHECK-LABEL: func.func @second
+func.func @second() {
+  // CHECK: llvm.mlir.constant(2 : i64)
+  %q = "qir.alloc"() : () -> (!qir.qubit)
+  // CHECK: llvm.mlir.constant(0 : i64)
+  %r = "qir.ralloc"() : () -> (!qir.result)
+  // CHECK: llvm.call @__quantum__qis__h__body
+  "qir.H"(%q) : (!qir.qubit) -> ()
+  // CHECK: llvm.call @__quantum__qis__mz__body
+  "qir.measure"(%q, %r) : (!qir.qubit, !qir.result) -> ()
+  return
+}
+
+// CHECK-LABEL: func.func @third
+func.func @third() {
+  // CHECK: llvm.mlir.constant(3 : i64)
+  %q = "qir.alloc"() : () -> (!qir.qubit)
+  // CHECK: llvm.mlir.constant(1 : i64)
+  %r = "qir.ralloc"() : () -> (!qir.result)
+  // CHECK: llvm.call @__quantum__qis__mz__body
+  "qir.measure"(%q, %r) : (!qir.qubit, !qir.result) -> ()
+  return
+}
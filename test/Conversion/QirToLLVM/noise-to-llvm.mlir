@@ -0,0 +1,35 @@
+// RUN: quantum-opt %s \
+// RUN:   --convert-qir-to-llvm="runtime-config=backend=density-matrix" \
+// RUN: | FileCheck %s
+
+// CHECK-DAG: llvm.mlir.global internal constant @__quantum__rt__config("backend=density-matrix\00")
+// CHECK-DAG: llvm.func @__quantum__qis__depolarizing__body(f64, !llvm.ptr)
+// CHECK-DAG: llvm.func @__quantum__qis__amplitude_damping__body(f64, !llvm.ptr)
+// CHECK-DAG: llvm.func @__quantum__qis__readout_error__body(f64, !llvm.ptr)
+
+// CHECK-LABEL: func.func @noise
+func.func @noise() {
+  // CHECK: %[[CONFIG:.+]] = llvm.mlir.addressof @__quantum__rt__config : !llvm.ptr
+  // CHECK: llvm.call @__quantum__rt__initialize(%[[CONFIG]]) : (!llvm.ptr) -> ()
+  "qir.init"() : () -> ()
+
+  // CHECK: %[[Q:.+]] = llvm.inttoptr
+  // CHECK: %[[R:.+]] = llvm.inttoptr
+  %q = "qir.alloc"() : () -> (!qir.qubit)
+  %r = "qir.ralloc"() : () -> (!qir.result)
+
+  // CHECK: %[[P:.+]] = llvm.mlir.constant(1.000000e-02 : f64) : f64
+  // CHECK: llvm.call @__quantum__qis__depolarizing__body(%[[P]], %[[Q]]) : (f64, !llvm.ptr) -> ()
+  "qir.depolarizing"(%q) <{probability = 0.01 : f64}> : (!qir.qubit) -> ()
+
+  // CHECK: %[[G:.+]] = llvm.mlir.constant(2.000000e-03 : f64) : f64
+  // CHECK: llvm.call @__quantum__qis__amplitude_damping__body(%[[G]], %[[Q]]) : (f64, !llvm.ptr) -> ()
+  "qir.amplitude_damping"(%q) <{gamma = 0.002 : f64}> : (!qir.qubit) -> ()
+
+  // CHECK: llvm.call @__quantum__qis__mz__body(%[[Q]], %[[R]])
+  // CHECK: %[[E:.+]] = llvm.mlir.constant(2.000000e-02 : f64) : f64
+  // CHECK: llvm.call @__quantum__qis__readout_error__body(%[[E]], %[[R]]) : (f64, !llvm.ptr) -> ()
+  "qir.measure"(%q, %r) : (!qir.qubit, !qir.result) -> ()
+  "qir.readout_error"(%r) <{probability = 0.02 : f64}> : (!qir.result) -> ()
+  return
+}
@@ -0,0 +1,18 @@
+// RUN: quantum-opt -convert-qir-to-llvm -convert-arith-to-llvm %s | FileCheck %s
+
+// CHECK-DAG: llvm.func @set_rng_seed(i64)
+// CHECK-DAG: llvm.func @__quantum__rt__set_rng_stream(i64, i64)
+
+// CHECK-LABEL: func.func @seed_stream(
+// CHECK-SAME: %[[SHOT:.+]]: i64
+func.func @seed_stream(%shot: i64) {
+  // CHECK: %[[SEED:.+]] = llvm.mlir.constant(23 : i64) : i64
+  %seed = arith.constant 23 : i64
+
+  // CHECK: llvm.call @set_rng_seed(%[[SEED]]) : (i64) -> ()
+  "qir.seed"(%seed) : (i64) -> ()
+
+  // CHECK: llvm.call @__quantum__rt__set_rng_stream(%[[SEED]], %[[SHOT]]) : (i64, i64) -> ()
+  "qir.seed"(%seed, %shot) : (i64, i64) -> ()
+  return
+}
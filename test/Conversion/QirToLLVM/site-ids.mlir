@@ -0,0 +1,53 @@
+// RUN: quantum-opt %s --convert-qir-to-llvm="site-ids=true" | FileCheck %s
+// RUN: quantum-opt %s \
+// RUN:   --lift-qir-to-quantum \
+// RUN:   --convert-quantum-to-qir \
+// RUN:   --convert-qir-to-llvm="site-ids=true" \
+// RUN: | FileCheck %s --check-prefix=ROUNDTRIP
+
+// CHECK-DAG: llvm.func @__quantum__rt__set_site(!llvm.ptr)
+// CHECK-DAG: llvm.mlir.global internal constant @__quantum__site_0("circuit.qasm:3:1\00")
+// CHECK-DAG: llvm.mlir.global internal constant @__quantum__site_1("circuit.qasm:4:1\00")
+// CHECK-DAG: llvm.mlir.global internal constant @__quantum__site_2("circuit.qasm:6:1\00")
+
+// The sites survive lifting to the quantum dialect and lowering back.
+// ROUNDTRIP-DAG: llvm.mlir.global internal constant @{{.+}}("circuit.qasm:3:1\00")
+// ROUNDTRIP-DAG: llvm.mlir.global internal constant @{{.+}}("circuit.qasm:4:1\00")
+// ROUNDTRIP: llvm.call @__quantum__rt__set_site
+// ROUNDTRIP-NEXT: llvm.call @__quantum__qis__h__body
+
+// CHECK-LABEL: func.func @sites
+func.func @sites() {
+  %q0 = "qir.alloc"() : () -> (!qir.qubit)
+  %q1 = "qir.alloc"() : () -> (!qir.qubit)
+  %r0 = "qir.ralloc"() : () -> (!qir.result)
+
+  // CHECK: %[[S0:.+]] = llvm.mlir.addressof @__quantum__site_0 : !llvm.ptr
+  // CHECK-NEXT: llvm.call @__quantum__rt__set_site(%[[S0]]) : (!llvm.ptr) -> ()
+  // CHECK-NEXT: llvm.call @__quantum__qis__h__body
+  "qir.H"(%q0) : (!qir.qubit) -> () loc("circuit.qasm":3:1)
+
+  // The first file location of a fused location is used.
+  // CHECK: %[[S1:.+]] = llvm.mlir.addressof @__quantum__site_1 : !llvm.ptr
+  // CHECK-NEXT: llvm.call @__quantum__rt__set_site(%[[S1]])
+  // CHECK-NEXT: llvm.call @__quantum__qis__swap__body
+  "qir.swap"(%q0, %q1) : (!qir.qubit, !qir.qubit) -> () loc(fused[loc("swap"), loc("circuit.qasm":4:1)])
+
+  // Every site is stored once.
+  // CHECK: %[[S0B:.+]] = llvm.mlir.addressof @__quantum__site_0 : !llvm.ptr
+  // CHECK-NEXT: llvm.call @__quantum__rt__set_site(%[[S0B]])
+  // CHECK-NEXT: llvm.call @__quantum__qis__h__body
+  "qir.H"(%q1) : (!qir.qubit) -> () loc("circuit.qasm":3:1)
+
+  // Ops without a file location clear the site.
+  // CHECK: %[[NONE:.+]] = llvm.mlir.zero : !llvm.ptr
+  // CHECK-NEXT: llvm.call @__quantum__rt__set_site(%[[NONE]])
+  // CHECK-NEXT: llvm.call @__quantum__qis__x__body
+  "qir.X"(%q1) : (!qir.qubit) -> () loc(unknown)
+
+  // CHECK: %[[S2:.+]] = llvm.mlir.addressof @__quantum__site_2 : !llvm.ptr
+  // CHECK-NEXT: llvm.call @__quantum__rt__set_site(%[[S2]])
+  // CHECK-NEXT: llvm.call @__quantum__qis__mz__body
+  "qir.measure"(%q0, %r0) : (!qir.qubit, !qir.result) -> () loc("circuit.qasm":6:1)
+  return
+}
@@ -0,0 +1,35 @@
+// RUN: quantum-opt %s --convert-quantum-to-qir -split-input-file -verify-diagnostics
+
+// The iterations swap the qubits, so the lowered loop cannot keep acting on
+// the same qubit references.
+func.func @permuted_qubits(%n : index) -> () {
+    %lb = arith.constant 0 : index
+    %step = arith.constant 1 : index
+    %a = "quantum.alloc" () : () -> (!quantum.qubit<1>)
+    %b = "quantum.alloc" () : () -> (!quantum.qubit<1>)
+    // expected-error@+1 {{failed to legalize operation 'quantum.for' that was explicitly marked illegal}}
+    %a1, %b1 = quantum.for %i = %lb to %n step %step ins(%la = %a, %lb2 = %b) -> (!quantum.qubit<1>, !quantum.qubit<1>) {
+        %0 = "quantum.H" (%la) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+        quantum.yield %lb2, %0 : !quantum.qubit<1>, !quantum.qubit<1>
+    }
+    "quantum.deallocate" (%a1) : (!quantum.qubit<1>) -> ()
+    "quantum.deallocate" (%b1) : (!quantum.qubit<1>) -> ()
+    return
+}
+
+// -----
+
+// Every iteration yields a new qubit instead of the captured one.
+func.func @fresh_qubit(%n : index) -> () {
+    %lb = arith.constant 0 : index
+    %step = arith.constant 1 : index
+    %a = "quantum.alloc" () : () -> (!quantum.qubit<1>)
+    // expected-error@+1 {{failed to legalize operation 'quantum.for' that was explicitly marked illegal}}
+    %a1 = quantum.for %i = %lb to %n step %step ins(%la = %a) -> (!quantum.qubit<1>) {
+        "quantum.deallocate" (%la) : (!quantum.qubit<1>) -> ()
+        %0 = "quantum.alloc" () : () -> (!quantum.qubit<1>)
+        quantum.yield %0 : !quantum.qubit<1>
+    }
+    "quantum.deallocate" (%a1) : (!quantum.qubit<1>) -> ()
+    return
+}
@@ -54,4 +54,28 @@ module {
       %q1_out, %q2_out = "quantum.SWAP"(%q1, %q2) : (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>)
       return
     }
+
+    // The qubit references stay outside of the loop, which only carries the
+    // classical values.
+    // CHECK-LABEL: func.func @convertFor(
+    // CHECK-SAME: %[[N:[^:]+]]: index, %[[T:[^:]+]]: f64)
+    func.func @convertFor(%n : index, %theta : f64) -> (f64) {
+      %lb = arith.constant 0 : index
+      %step = arith.constant 1 : index
+      // CHECK: %[[Q:.+]] = "qir.alloc"() : () -> !qir.qubit
+      %q = "quantum.alloc" () : () -> (!quantum.qubit<1>)
+      // CHECK-NEXT: %[[T2:.+]] = scf.for %{{.+}} = %{{.+}} to %[[N]] step %{{.+}} iter_args(%[[TIN:.+]] = %[[T]]) -> (f64) {
+      %q1, %t = quantum.for %i = %lb to %n step %step ins(%qin = %q, %tin = %theta) -> (!quantum.qubit<1>, f64) {
+        // CHECK-NEXT: "qir.H"(%[[Q]]) : (!qir.qubit) -> ()
+        %qH = "quantum.H" (%qin) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+        // CHECK-NEXT: "qir.Rz"(%[[Q]], %[[TIN]]) : (!qir.qubit, f64) -> ()
+        %qRz = "quantum.Rz" (%qH, %tin) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+        // CHECK-NEXT: scf.yield %[[TIN]] : f64
+        "quantum.yield" (%qRz, %tin) : (!quantum.qubit<1>, f64) -> ()
+      }
+      // CHECK: "qir.reset"(%[[Q]]) : (!qir.qubit) -> ()
+      "quantum.deallocate" (%q1) : (!quantum.qubit<1>) -> ()
+      // CHECK-NEXT: return %[[T2]]
+      return %t : f64
+    }
 }
@@ -0,0 +1,11 @@
+// RUN: quantum-opt %s -emit-bytecode | quantum-opt | FileCheck %s
+
+// CHECK-LABEL: func.func @measure(
+// CHECK-SAME: %{{.*}}: !qir.qubit) -> !qir.result
+func.func @measure(%q : !qir.qubit) -> (!qir.result) {
+  // CHECK: %[[R:.+]] = "qir.ralloc"() : () -> !qir.result
+  %r = "qir.ralloc"() : () -> (!qir.result)
+  // CHECK: "qir.measure"(%{{.*}}, %[[R]]) : (!qir.qubit, !qir.result) -> ()
+  "qir.measure"(%q, %r) : (!qir.qubit, !qir.result) -> ()
+  return %r : !qir.result
+}
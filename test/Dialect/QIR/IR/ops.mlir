@@ -108,5 +108,13 @@ func.func @main() {
   "qir.reset"(%q0)                : (!qir.qubit) -> ()
 // CHECK-DAG: "qir.reset"(%[[Q0]]) : (!qir.qubit) -> ()
 
+  // Noise channels
+  "qir.depolarizing"(%q0) <{probability = 0.01 : f64}> : (!qir.qubit) -> ()
+// CHECK-DAG: "qir.depolarizing"(%[[Q0]]) <{probability = 1.000000e-02 : f64}> : (!qir.qubit) -> ()
+  "qir.amplitude_damping"(%q1) <{gamma = 0.002 : f64}> : (!qir.qubit) -> ()
+// CHECK-DAG: "qir.amplitude_damping"(%[[Q1]]) <{gamma = 2.000000e-03 : f64}> : (!qir.qubit) -> ()
+  "qir.readout_error"(%r0) <{probability = 0.02 : f64}> : (!qir.result) -> ()
+// CHECK-DAG: "qir.readout_error"(%[[R0]]) <{probability = 2.000000e-02 : f64}> : (!qir.result) -> ()
+
   return
 }
@@ -0,0 +1,43 @@
+// RUN: quantum-opt --qir-inject-noise="noise-model=%S/Inputs/noise-model.json" %s | FileCheck %s
+
+module {
+  // CHECK-LABEL: func.func @noisy_bell(
+  func.func @noisy_bell() -> tensor<1xi1> {
+    // CHECK: %[[Q0:.+]] = "qir.alloc"()
+    // CHECK: %[[Q1:.+]] = "qir.alloc"()
+    // CHECK: %[[R:.+]] = "qir.ralloc"()
+    %q0 = "qir.alloc"() : () -> (!qir.qubit)
+    %q1 = "qir.alloc"() : () -> (!qir.qubit)
+    %r = "qir.ralloc"() : () -> (!qir.result)
+
+    // Gates without an entry use the "*" fallback.
+    // CHECK-NEXT: "qir.H"(%[[Q0]])
+    // CHECK-NEXT: "qir.depolarizing"(%[[Q0]]) <{probability = 1.000000e-03 : f64}>
+    "qir.H"(%q0) : (!qir.qubit) -> ()
+
+    // Channels are applied to every qubit operand.
+    // CHECK-NEXT: "qir.CNOT"(%[[Q0]], %[[Q1]])
+    // CHECK-NEXT: "qir.depolarizing"(%[[Q0]]) <{probability = 1.000000e-02 : f64}>
+    // CHECK-NEXT: "qir.amplitude_damping"(%[[Q0]]) <{gamma = 2.000000e-03 : f64}>
+    // CHECK-NEXT: "qir.depolarizing"(%[[Q1]]) <{probability = 1.000000e-02 : f64}>
+    // CHECK-NEXT: "qir.amplitude_damping"(%[[Q1]]) <{gamma = 2.000000e-03 : f64}>
+    "qir.CNOT"(%q0, %q1) : (!qir.qubit, !qir.qubit) -> ()
+
+    // Barriers stay noiseless.
+    // CHECK-NEXT: "qir.barrier"(%[[Q0]], %[[Q1]])
+    // CHECK-NEXT: "qir.measure"
+    "qir.barrier"(%q0, %q1) : (!qir.qubit, !qir.qubit) -> ()
+
+    // Readout errors follow the measurement.
+    // CHECK-SAME: (%[[Q0]], %[[R]])
+    // CHECK-NEXT: "qir.readout_error"(%[[R]]) <{probability = 2.000000e-02 : f64}>
+    "qir.measure"(%q0, %r) : (!qir.qubit, !qir.result) -> ()
+
+    // Resets are not covered by the fallback.
+    // CHECK-NEXT: "qir.reset"(%[[Q0]])
+    // CHECK-NEXT: "qir.read_measurement"(%[[R]])
+    "qir.reset"(%q0) : (!qir.qubit) -> ()
+    %m = "qir.read_measurement"(%r) : (!qir.result) -> (tensor<1xi1>)
+    return %m : tensor<1xi1>
+  }
+}
@@ -0,0 +1,127 @@
+// RUN: quantum-opt --qir-localize-qubits="global-qubits=1" --split-input-file %s | FileCheck %s
+
+// The global qubit %q0 is swapped with %q2, whose next non-diagonal gate is
+// further away than the one of %q1.
+
+// CHECK-LABEL: func.func @localize(
+// CHECK-SAME: %[[ANGLE:.+]]: f64)
+func.func @localize(%angle: f64) {
+  // CHECK: %[[Q0:.+]] = "qir.alloc"
+  // CHECK: %[[Q1:.+]] = "qir.alloc"
+  // CHECK: %[[Q2:.+]] = "qir.alloc"
+  // CHECK: %[[R0:.+]] = "qir.ralloc"
+  %q0 = "qir.alloc"() : () -> (!qir.qubit)
+  %q1 = "qir.alloc"() : () -> (!qir.qubit)
+  %q2 = "qir.alloc"() : () -> (!qir.qubit)
+  %r0 = "qir.ralloc"() : () -> (!qir.result)
+  // CHECK-NEXT: "qir.swap"(%[[Q0]], %[[Q2]])
+  // CHECK-NEXT: "qir.H"(%[[Q2]])
+  // CHECK-NEXT: "qir.X"(%[[Q1]])
+  // CHECK-NEXT: "qir.Rx"(%[[Q2]], %[[ANGLE]])
+  // CHECK-NEXT: "qir.CNOT"(%[[Q1]], %[[Q2]])
+  // CHECK-NEXT: "qir.Rz"(%[[Q2]], %[[ANGLE]])
+  // CHECK-NEXT: "qir.measure"(%[[Q2]], %[[R0]])
+  // CHECK-NEXT: return
+  "qir.H"(%q0) : (!qir.qubit) -> ()
+  "qir.X"(%q1) : (!qir.qubit) -> ()
+  "qir.Rx"(%q0, %angle) : (!qir.qubit, f64) -> ()
+  "qir.CNOT"(%q1, %q0) : (!qir.qubit, !qir.qubit) -> ()
+  "qir.Rz"(%q0, %angle) : (!qir.qubit, f64) -> ()
+  "qir.measure"(%q0, %r0) : (!qir.qubit, !qir.result) -> ()
+  return
+}
+
+// -----
+
+// Diagonal gates, controls and a single exchange do not pay off.
+
+// CHECK-LABEL: func.func @unchanged(
+func.func @unchanged(%angle: f64) {
+  %q0 = "qir.alloc"() : () -> (!qir.qubit)
+  %q1 = "qir.alloc"() : () -> (!qir.qubit)
+  // CHECK-NOT: "qir.swap"
+  "qir.Rz"(%q0, %angle) : (!qir.qubit, f64) -> ()
+  "qir.CNOT"(%q0, %q1) : (!qir.qubit, !qir.qubit) -> ()
+  "qir.H"(%q0) : (!qir.qubit) -> ()
+  "qir.T"(%q0) : (!qir.qubit) -> ()
+  return
+}
+
+// -----
+
+// The swap is undone before an op that observes the physical layout.
+
+// CHECK-LABEL: func.func @restore(
+func.func @restore(%angle: f64) {
+  // CHECK: %[[Q0:.+]] = "qir.alloc"
+  // CHECK: %[[Q1:.+]] = "qir.alloc"
+  %q0 = "qir.alloc"() : () -> (!qir.qubit)
+  %q1 = "qir.alloc"() : () -> (!qir.qubit)
+  // CHECK-NEXT: "qir.swap"(%[[Q0]], %[[Q1]])
+  // CHECK-NEXT: "qir.H"(%[[Q1]])
+  // CHECK-NEXT: "qir.Rx"(%[[Q1]], %{{.+}})
+  // CHECK-NEXT: "qir.Ry"(%[[Q1]], %{{.+}})
+  // CHECK-NEXT: "qir.swap"(%[[Q0]], %[[Q1]])
+  // CHECK-NEXT: "qir.show_state"()
+  "qir.H"(%q0) : (!qir.qubit) -> ()
+  "qir.Rx"(%q0, %angle) : (!qir.qubit, f64) -> ()
+  "qir.Ry"(%q0, %angle) : (!qir.qubit, f64) -> ()
+  "qir.show_state"() : () -> ()
+  return
+}
+
+// -----
+
+// A loop body runs again, so the swap is undone before its terminator.
+
+// CHECK-LABEL: func.func @loop(
+func.func @loop(%n: index, %angle: f64) {
+  // CHECK: %[[Q0:.+]] = "qir.alloc"
+  // CHECK: %[[Q1:.+]] = "qir.alloc"
+  %q0 = "qir.alloc"() : () -> (!qir.qubit)
+  %q1 = "qir.alloc"() : () -> (!qir.qubit)
+  %lb = arith.constant 0 : index
+  %step = arith.constant 1 : index
+  // CHECK: scf.for
+  // CHECK-NEXT: "qir.swap"(%[[Q0]], %[[Q1]])
+  // CHECK-NEXT: "qir.H"(%[[Q1]])
+  // CHECK-NEXT: "qir.Rx"(%[[Q1]], %{{.+}})
+  // CHECK-NEXT: "qir.Ry"(%[[Q1]], %{{.+}})
+  // CHECK-NEXT: "qir.swap"(%[[Q0]], %[[Q1]])
+  // CHECK-NEXT: }
+  scf.for %i = %lb to %n step %step {
+    "qir.H"(%q0) : (!qir.qubit) -> ()
+    "qir.Rx"(%q0, %angle) : (!qir.qubit, f64) -> ()
+    "qir.Ry"(%q0, %angle) : (!qir.qubit, f64) -> ()
+  }
+  return
+}
+
+// -----
+
+// A function that is called again allocates the same slots, so the swap is
+// undone before its return.
+
+// CHECK-LABEL: func.func private @called(
+func.func private @called(%angle: f64) {
+  // CHECK: %[[Q0:.+]] = "qir.alloc"
+  // CHECK: %[[Q1:.+]] = "qir.alloc"
+  %q0 = "qir.alloc"() : () -> (!qir.qubit)
+  %q1 = "qir.alloc"() : () -> (!qir.qubit)
+  // CHECK-NEXT: "qir.swap"(%[[Q0]], %[[Q1]])
+  // CHECK-NEXT: "qir.H"(%[[Q1]])
+  // CHECK-NEXT: "qir.Rx"(%[[Q1]], %{{.+}})
+  // CHECK-NEXT: "qir.Ry"(%[[Q1]], %{{.+}})
+  // CHECK-NEXT: "qir.swap"(%[[Q0]], %[[Q1]])
+  // CHECK-NEXT: return
+  "qir.H"(%q0) : (!qir.qubit) -> ()
+  "qir.Rx"(%q0, %angle) : (!qir.qubit, f64) -> ()
+  "qir.Ry"(%q0, %angle) : (!qir.qubit, f64) -> ()
+  return
+}
+
+func.func @caller(%angle: f64) {
+  func.call @called(%angle) : (f64) -> ()
+  func.call @called(%angle) : (f64) -> ()
+  return
+}
@@ -0,0 +1,92 @@
+// RUN: quantum-opt --qir-merge-parametric-functions %s | FileCheck %s
+
+// CHECK-LABEL: func.func private @point0.parametric(
+// CHECK-SAME: %[[Q:.+]]: !qir.qubit, %[[A:.+]]: f64, %[[B:.+]]: f64)
+// CHECK-NEXT: "qir.Rx"(%[[Q]], %[[A]])
+// CHECK-NEXT: "qir.Rz"(%[[Q]], %[[B]])
+// CHECK-NEXT: return
+
+// CHECK-LABEL: func.func @point0(
+// CHECK-SAME: %[[Q0:.+]]: !qir.qubit)
+// CHECK-NEXT: %[[A0:.+]] = arith.constant 1.000000e-01 : f64
+// CHECK-NEXT: %[[B0:.+]] = arith.constant 2.000000e-01 : f64
+// CHECK-NEXT: call @point0.parametric(%[[Q0]], %[[A0]], %[[B0]]) : (!qir.qubit, f64, f64) -> ()
+// CHECK-NEXT: return
+func.func @point0(%q : !qir.qubit) {
+  %a = arith.constant 0.1 : f64
+  "qir.Rx"(%q, %a) : (!qir.qubit, f64) -> ()
+  %b = arith.constant 0.2 : f64
+  "qir.Rz"(%q, %b) : (!qir.qubit, f64) -> ()
+  return
+}
+
+// CHECK-LABEL: func.func @point1(
+// CHECK-SAME: %[[Q1:.+]]: !qir.qubit)
+// CHECK-NEXT: %[[A1:.+]] = arith.constant 3.000000e-01 : f64
+// CHECK-NEXT: %[[B1:.+]] = arith.constant 4.000000e-01 : f64
+// CHECK-NEXT: call @point0.parametric(%[[Q1]], %[[A1]], %[[B1]]) : (!qir.qubit, f64, f64) -> ()
+// CHECK-NEXT: return
+func.func @point1(%q : !qir.qubit) {
+  %a = arith.constant 0.3 : f64
+  "qir.Rx"(%q, %a) : (!qir.qubit, f64) -> ()
+  %b = arith.constant 0.4 : f64
+  "qir.Rz"(%q, %b) : (!qir.qubit, f64) -> ()
+  return
+}
+
+// Different gates are not merged.
+// CHECK-LABEL: func.func @other(
+// CHECK-NEXT: arith.constant
+// CHECK-NEXT: "qir.Ry"
+func.func @other(%q : !qir.qubit) {
+  %a = arith.constant 0.3 : f64
+  "qir.Ry"(%q, %a) : (!qir.qubit, f64) -> ()
+  %b = arith.constant 0.4 : f64
+  "qir.Rz"(%q, %b) : (!qir.qubit, f64) -> ()
+  return
+}
+
+// Functions that allocate qubits or results keep their own, so that sweep
+// points neither reuse dirty qubits nor overwrite each other's results.
+// CHECK-LABEL: func.func @allocates0()
+// CHECK-NOT: call
+// CHECK: "qir.alloc"()
+// CHECK: "qir.ralloc"()
+func.func @allocates0() {
+  %a = arith.constant 0.1 : f64
+  %q = "qir.alloc"() : () -> (!qir.qubit)
+  %r = "qir.ralloc"() : () -> (!qir.result)
+  "qir.Rx"(%q, %a) : (!qir.qubit, f64) -> ()
+  "qir.measure"(%q, %r) : (!qir.qubit, !qir.result) -> ()
+  return
+}
+
+// CHECK-LABEL: func.func @allocates1()
+// CHECK-NOT: call
+// CHECK: "qir.alloc"()
+// CHECK: "qir.ralloc"()
+func.func @allocates1() {
+  %a = arith.constant 0.2 : f64
+  %q = "qir.alloc"() : () -> (!qir.qubit)
+  %r = "qir.ralloc"() : () -> (!qir.result)
+  "qir.Rx"(%q, %a) : (!qir.qubit, f64) -> ()
+  "qir.measure"(%q, %r) : (!qir.qubit, !qir.result) -> ()
+  return
+}
+
+// Functions that return qubits keep their own.
+// CHECK-LABEL: func.func @returns_qubit0(
+// CHECK-NOT: call
+func.func @returns_qubit0(%q : !qir.qubit) -> !qir.qubit {
+  %a = arith.constant 0.1 : f64
+  "qir.Rx"(%q, %a) : (!qir.qubit, f64) -> ()
+  return %q : !qir.qubit
+}
+
+// CHECK-LABEL: func.func @returns_qubit1(
+// CHECK-NOT: call
+func.func @returns_qubit1(%q : !qir.qubit) -> !qir.qubit {
+  %a = arith.constant 0.2 : f64
+  "qir.Rx"(%q, %a) : (!qir.qubit, f64) -> ()
+  return %q : !qir.qubit
+}
@@ -0,0 +1,22 @@
+// RUN: quantum-opt --qir-trajectory-driver="kernel=bell driver=run" %s | FileCheck %s
+
+// CHECK-LABEL: func.func @bell()
+func.func @bell() {
+  "qir.init"() : () -> ()
+  %q0 = "qir.alloc"() : () -> (!qir.qubit)
+  %q1 = "qir.alloc"() : () -> (!qir.qubit)
+  %r0 = "qir.ralloc"() : () -> (!qir.result)
+  %r1 = "qir.ralloc"() : () -> (!qir.result)
+  "qir.H"(%q0) : (!qir.qubit) -> ()
+  "qir.CNOT"(%q0, %q1) : (!qir.qubit, !qir.qubit) -> ()
+  "qir.measure"(%q0, %r0) : (!qir.qubit, !qir.result) -> ()
+  "qir.measure"(%q1, %r1) : (!qir.qubit, !qir.result) -> ()
+  return
+}
+
+// CHECK: func.func private @__quantum__rt__run_trajectories(() -> ())
+// CHECK-LABEL: func.func @run()
+// CHECK-NEXT: "qir.init"()
+// CHECK-NEXT: %[[KERNEL:.+]] = constant @bell : () -> ()
+// CHECK-NEXT: call @__quantum__rt__run_trajectories(%[[KERNEL]]) : (() -> ()) -> ()
+// CHECK-NEXT: return
@@ -0,0 +1,31 @@
+// RUN: quantum-opt %s -emit-bytecode | quantum-opt | FileCheck %s
+
+// CHECK-LABEL: "quantum.gate"()
+// CHECK-SAME: sym_name = "swap3"
+"quantum.gate"() <{function_type = (!quantum.qubit<3>) -> (!quantum.qubit<3>), sym_name = "swap3"}> ({
+^bb0(%arg0: !quantum.qubit<3>):
+  // CHECK: "quantum.return"(%{{.*}}) : (!quantum.qubit<3>) -> ()
+  "quantum.return"(%arg0) : (!quantum.qubit<3>) -> ()
+}) : () -> ()
+
+// CHECK-LABEL: func.func @registers(
+// CHECK-SAME: %{{.*}}: i1) -> !quantum.qubit<1>
+func.func @registers(%b : i1) -> (!quantum.qubit<1>) {
+  // CHECK: "quantum.alloc"() : () -> !quantum.qubit<5>
+  %reg = "quantum.alloc"() : () -> (!quantum.qubit<5>)
+  "quantum.deallocate"(%reg) : (!quantum.qubit<5>) -> ()
+  // CHECK: "quantum.alloc"() : () -> !quantum.qubit<1>
+  %q = "quantum.alloc"() : () -> (!quantum.qubit<1>)
+  // CHECK: quantum.if %{{.*}} ins(%[[IN:.+]] = %{{.*}}) -> (!quantum.qubit<1>) {
+  // CHECK-NEXT: %[[H:.+]] = "quantum.H"(%[[IN]])
+  // CHECK-NEXT: quantum.yield %[[H]]
+  // CHECK-NEXT: } else {
+  // CHECK-NEXT: quantum.yield %[[IN]]
+  %r = quantum.if %b ins(%qin = %q) -> (!quantum.qubit<1>) {
+    %h = "quantum.H"(%qin) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    "quantum.yield"(%h) : (!quantum.qubit<1>) -> ()
+  } else {
+    "quantum.yield"(%qin) : (!quantum.qubit<1>) -> ()
+  }
+  return %r : !quantum.qubit<1>
+}
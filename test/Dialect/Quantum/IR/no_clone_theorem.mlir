@@ -61,4 +61,20 @@ func.func @qubit_multiple_uses_else_region(%b : i1) -> () {
     "quantum.deallocate" (%r1) : (!quantum.qubit<1>) -> ()
     "quantum.deallocate" (%r2) : (!quantum.qubit<1>) -> ()
     return 
-}
\ No newline at end of file
+}
+
+// -----
+
+func.func @qubit_multiple_uses_loop_body(%n : index) -> () {
+    %lb = arith.constant 0 : index
+    %step = arith.constant 1 : index
+    %q = "quantum.alloc" () : () -> (!quantum.qubit<1>)
+    // expected-error@+1 {{'quantum.for' op captured qubit #0 used more than once within the same block}}
+    %r = quantum.for %i = %lb to %n step %step ins(%qin = %q) -> (!quantum.qubit<1>) {
+        %qH = "quantum.H" (%qin) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+        %qX = "quantum.X" (%qin) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+        "quantum.yield" (%qX) : (!quantum.qubit<1>) -> ()
+    }
+    "quantum.deallocate" (%r) : (!quantum.qubit<1>) -> ()
+    return
+}
@@ -55,6 +55,19 @@ func.func @quantum_if(%b : i1, %reg : !quantum.qubit<1>) -> (!quantum.qubit<1>)
 
 // -----
 
+func.func @quantum_for(%n : index, %theta : f64, %reg : !quantum.qubit<1>) -> (!quantum.qubit<1>) {
+    %lb = arith.constant 0 : index
+    %step = arith.constant 1 : index
+    %q, %t = quantum.for %i = %lb to %n step %step ins(%qin = %reg, %tin = %theta) -> (!quantum.qubit<1>, f64) {
+        %qH = "quantum.H" (%qin) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+        %qRz = "quantum.Rz" (%qH, %tin) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+        "quantum.yield" (%qRz, %tin) : (!quantum.qubit<1>, f64) -> ()
+    }
+    return %q : !quantum.qubit<1>
+}
+
+// -----
+
 "quantum.gate"() <{function_type = (!quantum.qubit<1>) -> (!quantum.qubit<1>), sym_name = "test"}>({
     ^bb0(%arg0 : !quantum.qubit<1>):
     "quantum.return"(%arg0) : (!quantum.qubit<1>) -> ()
@@ -0,0 +1,113 @@
+// RUN: quantum-opt --quantum-defer-measurement %s | FileCheck %s
+// RUN: quantum-opt --quantum-defer-measurement="max-gates=0" %s | FileCheck %s --check-prefix=LIMIT
+
+module {
+  // The H both branches start with and the CNOT both branches end with are
+  // applied around the quantum.if.
+  // CHECK-LABEL: func.func @common_gates(
+  // CHECK-SAME: %[[C:[^:]+]]: i1, %[[A:[^:]+]]: !quantum.qubit<1>, %[[B:[^:]+]]: !quantum.qubit<1>)
+  func.func @common_gates(%c : i1, %a : !quantum.qubit<1>, %b : !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>) {
+    // CHECK: %[[H:.+]] = "quantum.H"(%[[A]])
+    // CHECK-NEXT: %[[IF:.+]]:2 = quantum.if %[[C]] ins(%[[TA:.+]] = %[[H]], %[[TB:.+]] = %[[B]])
+    // CHECK-NEXT: %[[X:.+]] = "quantum.X"(%[[TA]])
+    // CHECK-NEXT: quantum.yield %[[X]], %[[TB]]
+    // CHECK-NEXT: } else {
+    // CHECK-NEXT: %[[Z:.+]] = "quantum.Z"(%[[EA:[^)]+]])
+    // CHECK-NEXT: quantum.yield %[[Z]], %[[EB:[^ ]+]] :
+    // CHECK-NEXT: }
+    // CHECK-NEXT: %[[CNOT:.+]]:2 = "quantum.CNOT"(%[[IF]]#0, %[[IF]]#1)
+    // CHECK-NEXT: return %[[CNOT]]#0, %[[CNOT]]#1
+    %a1, %b1 = quantum.if %c ins(%ta = %a, %tb = %b) -> (!quantum.qubit<1>, !quantum.qubit<1>) {
+      %0 = "quantum.H"(%ta) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+      %1 = "quantum.X"(%0) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+      %2, %3 = "quantum.CNOT"(%1, %tb) : (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>)
+      quantum.yield %2, %3 : !quantum.qubit<1>, !quantum.qubit<1>
+    } else {
+      %0 = "quantum.H"(%ta) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+      %1 = "quantum.Z"(%0) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+      %2, %3 = "quantum.CNOT"(%1, %tb) : (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>)
+      quantum.yield %2, %3 : !quantum.qubit<1>, !quantum.qubit<1>
+    }
+    return %a1, %b1 : !quantum.qubit<1>, !quantum.qubit<1>
+  }
+
+  // Branches that apply the same rotation leave nothing to branch on.
+  // CHECK-LABEL: func.func @same_branches(
+  // CHECK-SAME: %[[C:[^:]+]]: i1, %[[A:[^:]+]]: !quantum.qubit<1>)
+  func.func @same_branches(%c : i1, %a : !quantum.qubit<1>) -> !quantum.qubit<1> {
+    // CHECK-NOT: quantum.if
+    // CHECK: %[[ANGLE:.+]] = arith.constant 5.000000e-01 : f64
+    // CHECK-NEXT: %[[RZ:.+]] = "quantum.Rz"(%[[A]], %[[ANGLE]])
+    // CHECK-NEXT: return %[[RZ]]
+    %a1 = quantum.if %c ins(%ta = %a) -> (!quantum.qubit<1>) {
+      %t = arith.constant 0.5 : f64
+      %0 = "quantum.Rz"(%ta, %t) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+      quantum.yield %0 : !quantum.qubit<1>
+    } else {
+      %t = arith.constant 0.5 : f64
+      %0 = "quantum.Rz"(%ta, %t) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+      quantum.yield %0 : !quantum.qubit<1>
+    }
+    return %a1 : !quantum.qubit<1>
+  }
+
+  // Flipping a qubit if another one was measured as 1 is a CNOT before the
+  // measurement.
+  // CHECK-LABEL: func.func @measure_then_x(
+  // CHECK-SAME: %[[A:[^:]+]]: !quantum.qubit<1>, %[[B:[^:]+]]: !quantum.qubit<1>)
+  // LIMIT-LABEL: func.func @measure_then_x(
+  func.func @measure_then_x(%a : !quantum.qubit<1>, %b : !quantum.qubit<1>) -> (i1, !quantum.qubit<1>, !quantum.qubit<1>) {
+    // CHECK-NOT: quantum.if
+    // CHECK: %[[CNOT:.+]]:2 = "quantum.CNOT"(%[[A]], %[[B]])
+    // CHECK-NEXT: %[[MEAS:.+]]:2 = "quantum.measure_single"(%[[CNOT]]#0)
+    // CHECK-NEXT: return %[[MEAS]]#0, %[[MEAS]]#1, %[[CNOT]]#1
+
+    // LIMIT: "quantum.measure_single"
+    // LIMIT-NEXT: quantum.if
+    %m, %a1 = "quantum.measure_single"(%a) : (!quantum.qubit<1>) -> (i1, !quantum.qubit<1>)
+    %b1 = quantum.if %m ins(%tb = %b) -> (!quantum.qubit<1>) {
+      %0 = "quantum.X"(%tb) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+      quantum.yield %0 : !quantum.qubit<1>
+    } else {
+      quantum.yield %tb : !quantum.qubit<1>
+    }
+    return %m, %a1, %b1 : i1, !quantum.qubit<1>, !quantum.qubit<1>
+  }
+
+  // A controlled Y conjugates the CNOT with S on its target.
+  // CHECK-LABEL: func.func @measure_then_y(
+  // CHECK-SAME: %[[A:[^:]+]]: !quantum.qubit<1>, %[[B:[^:]+]]: !quantum.qubit<1>)
+  func.func @measure_then_y(%a : !quantum.qubit<1>, %b : !quantum.qubit<1>) -> (i1, !quantum.qubit<1>, !quantum.qubit<1>) {
+    // CHECK: %[[SDG:.+]] = "quantum.Sdg"(%[[B]])
+    // CHECK-NEXT: %[[CNOT:.+]]:2 = "quantum.CNOT"(%[[A]], %[[SDG]])
+    // CHECK-NEXT: %[[S:.+]] = "quantum.S"(%[[CNOT]]#1)
+    // CHECK-NEXT: %[[MEAS:.+]]:2 = "quantum.measure_single"(%[[CNOT]]#0)
+    // CHECK-NEXT: return %[[MEAS]]#0, %[[MEAS]]#1, %[[S]]
+    %m, %a1 = "quantum.measure_single"(%a) : (!quantum.qubit<1>) -> (i1, !quantum.qubit<1>)
+    %b1 = quantum.if %m ins(%tb = %b) -> (!quantum.qubit<1>) {
+      %0 = "quantum.Y"(%tb) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+      quantum.yield %0 : !quantum.qubit<1>
+    } else {
+      quantum.yield %tb : !quantum.qubit<1>
+    }
+    return %m, %a1, %b1 : i1, !quantum.qubit<1>, !quantum.qubit<1>
+  }
+
+  // The measured qubit is used before the quantum.if, so the measurement
+  // cannot move.
+  // CHECK-LABEL: func.func @used_before(
+  func.func @used_before(%a : !quantum.qubit<1>, %b : !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>) {
+    // CHECK: "quantum.measure_single"
+    // CHECK-NEXT: "quantum.H"
+    // CHECK-NEXT: quantum.if
+    %m, %a1 = "quantum.measure_single"(%a) : (!quantum.qubit<1>) -> (i1, !quantum.qubit<1>)
+    %a2 = "quantum.H"(%a1) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %b1 = quantum.if %m ins(%tb = %b) -> (!quantum.qubit<1>) {
+      %0 = "quantum.X"(%tb) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+      quantum.yield %0 : !quantum.qubit<1>
+    } else {
+      quantum.yield %tb : !quantum.qubit<1>
+    }
+    return %a2, %b1 : !quantum.qubit<1>, !quantum.qubit<1>
+  }
+}
@@ -119,4 +119,26 @@ module {
     return %q5, %q6 : !quantum.qubit<1>, !quantum.qubit<1>
   }
 
+  // S and Sdg are inverses, but not Hermitian.
+  // CHECK-LABEL: func.func @s_sdg_no_cancel(
+  func.func @s_sdg_no_cancel(%q1 : !quantum.qubit<1>) -> !quantum.qubit<1> {
+    // CHECK: "quantum.S"
+    %q2 = "quantum.S" (%q1) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    // CHECK-NEXT: "quantum.Sdg"
+    %q3 = "quantum.Sdg" (%q2) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    return %q3 : !quantum.qubit<1>
+  }
+
+  // Only adjacent gates cancel, even if the gate between them commutes.
+  // CHECK-LABEL: func.func @commuting_no_cancel(
+  func.func @commuting_no_cancel(%q1 : !quantum.qubit<1>) -> !quantum.qubit<1> {
+    // CHECK: "quantum.Z"
+    %q2 = "quantum.Z" (%q1) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    // CHECK-NEXT: "quantum.S"
+    %q3 = "quantum.S" (%q2) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    // CHECK-NEXT: "quantum.Z"
+    %q4 = "quantum.Z" (%q3) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    return %q4 : !quantum.qubit<1>
+  }
+
 }
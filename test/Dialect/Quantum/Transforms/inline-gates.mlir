@@ -0,0 +1,59 @@
+// RUN: quantum-opt %s --quantum-inline-gates="max-cost=2" | FileCheck %s
+
+module {
+  // CHECK-NOT: sym_name = "small"
+  "quantum.gate"() <{function_type = (!quantum.qubit<1>) -> (!quantum.qubit<1>), sym_name = "small"}> ({
+  ^bb0(%arg0: !quantum.qubit<1>):
+    %0 = "quantum.H"(%arg0) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %1 = "quantum.T"(%0) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    "quantum.return"(%1) : (!quantum.qubit<1>) -> ()
+  }) : () -> ()
+
+  // CHECK: sym_name = "large"
+  "quantum.gate"() <{function_type = (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>), sym_name = "large"}> ({
+  ^bb0(%arg0: !quantum.qubit<1>, %arg1: !quantum.qubit<1>):
+    %0 = "quantum.H"(%arg0) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %1:2 = "quantum.CNOT"(%0, %arg1) : (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>)
+    %2 = "quantum.call"(%1#1) <{callee = @small}> : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    "quantum.return"(%1#0, %2) : (!quantum.qubit<1>, !quantum.qubit<1>) -> ()
+  }) : () -> ()
+
+  // CHECK-NOT: sym_name = "once"
+  "quantum.gate"() <{function_type = (!quantum.qubit<1>) -> (!quantum.qubit<1>), sym_name = "once"}> ({
+  ^bb0(%arg0: !quantum.qubit<1>):
+    %0 = "quantum.X"(%arg0) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %1 = "quantum.Y"(%0) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %2 = "quantum.Z"(%1) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    "quantum.return"(%2) : (!quantum.qubit<1>) -> ()
+  }) : () -> ()
+
+  // CHECK: sym_name = "recursive"
+  "quantum.gate"() <{function_type = (!quantum.qubit<1>) -> (!quantum.qubit<1>), sym_name = "recursive"}> ({
+  ^bb0(%arg0: !quantum.qubit<1>):
+    %0 = "quantum.call"(%arg0) <{callee = @recursive}> : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    "quantum.return"(%0) : (!quantum.qubit<1>) -> ()
+  }) : () -> ()
+
+  // CHECK-LABEL: func.func @inline(
+  func.func @inline() -> (!quantum.qubit<1>, !quantum.qubit<1>) {
+    // CHECK: %[[Q0:.+]] = "quantum.alloc"()
+    %q0 = "quantum.alloc"() : () -> (!quantum.qubit<1>)
+    // CHECK: %[[Q1:.+]] = "quantum.alloc"()
+    %q1 = "quantum.alloc"() : () -> (!quantum.qubit<1>)
+    // CHECK-NEXT: %[[Q2:.+]] = "quantum.H"(%[[Q0]])
+    // CHECK-NEXT: %[[Q3:.+]] = "quantum.T"(%[[Q2]])
+    %q2 = "quantum.call"(%q0) <{callee = @small}> : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    // CHECK-NEXT: %[[Q4:.+]]:2 = "quantum.call"(%[[Q3]], %[[Q1]]) <{callee = @large}>
+    %q3:2 = "quantum.call"(%q2, %q1) <{callee = @large}> : (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>)
+    // CHECK-NEXT: %[[Q5:.+]]:2 = "quantum.call"(%[[Q4]]#0, %[[Q4]]#1) <{callee = @large}>
+    %q4:2 = "quantum.call"(%q3#0, %q3#1) <{callee = @large}> : (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>)
+    // CHECK-NEXT: %[[Q6:.+]] = "quantum.X"(%[[Q5]]#0)
+    // CHECK-NEXT: %[[Q7:.+]] = "quantum.Y"(%[[Q6]])
+    // CHECK-NEXT: %[[Q8:.+]] = "quantum.Z"(%[[Q7]])
+    %q5 = "quantum.call"(%q4#0) <{callee = @once}> : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    // CHECK-NEXT: %[[Q9:.+]] = "quantum.call"(%[[Q8]]) <{callee = @recursive}>
+    %q6 = "quantum.call"(%q5) <{callee = @recursive}> : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    // CHECK-NEXT: return %[[Q9]], %[[Q5]]#1
+    return %q6, %q4#1 : !quantum.qubit<1>, !quantum.qubit<1>
+  }
+}
@@ -0,0 +1,40 @@
+// RUN: quantum-opt %s --quantum-outline-gates="window-size=3" | FileCheck %s
+
+module {
+  // CHECK: "quantum.gate"() <{function_type = (!quantum.qubit<1>, !quantum.qubit<1>, f64) -> (!quantum.qubit<1>, !quantum.qubit<1>), sym_name = "outlined_0"}> ({
+  // CHECK-NEXT: ^bb0(%[[A0:.+]]: !quantum.qubit<1>, %[[A1:.+]]: !quantum.qubit<1>, %[[THETA:.+]]: f64):
+  // CHECK-NEXT: %[[G0:.+]] = "quantum.H"(%[[A0]])
+  // CHECK-NEXT: %[[G1:.+]]:2 = "quantum.CNOT"(%[[G0]], %[[A1]])
+  // CHECK-NEXT: %[[G2:.+]] = "quantum.Rz"(%[[G1]]#1, %[[THETA]])
+  // CHECK-NEXT: "quantum.return"(%[[G1]]#0, %[[G2]])
+
+  // CHECK-LABEL: func.func @outline(
+  // CHECK-SAME: %[[THETA0:.+]]: f64, %[[THETA1:.+]]: f64)
+  func.func @outline(%theta0: f64, %theta1: f64) -> (!quantum.qubit<1>, !quantum.qubit<1>) {
+    // CHECK: %[[Q0:.+]] = "quantum.alloc"()
+    %q0 = "quantum.alloc"() : () -> (!quantum.qubit<1>)
+    // CHECK: %[[Q1:.+]] = "quantum.alloc"()
+    %q1 = "quantum.alloc"() : () -> (!quantum.qubit<1>)
+    // CHECK-NEXT: %[[C0:.+]]:2 = "quantum.call"(%[[Q0]], %[[Q1]], %[[THETA0]]) <{callee = @outlined_0}>
+    %0 = "quantum.H"(%q0) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %1:2 = "quantum.CNOT"(%0, %q1) : (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>)
+    %2 = "quantum.Rz"(%1#1, %theta0) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+    // CHECK-NEXT: %[[X:.+]] = "quantum.X"(%[[C0]]#1)
+    %3 = "quantum.X"(%2) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    // CHECK-NEXT: %[[C1:.+]]:2 = "quantum.call"(%[[X]], %[[C0]]#0, %[[THETA1]]) <{callee = @outlined_0}>
+    %4 = "quantum.H"(%3) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %5:2 = "quantum.CNOT"(%4, %1#0) : (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>)
+    %6 = "quantum.Rz"(%5#1, %theta1) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+    // CHECK-NEXT: return %[[C1]]#0, %[[C1]]#1
+    return %5#0, %6 : !quantum.qubit<1>, !quantum.qubit<1>
+  }
+
+  // CHECK-LABEL: func.func @unique(
+  func.func @unique(%q0: !quantum.qubit<1>) -> !quantum.qubit<1> {
+    // CHECK-NOT: "quantum.call"
+    %0 = "quantum.H"(%q0) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %1 = "quantum.S"(%0) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %2 = "quantum.H"(%1) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    return %2 : !quantum.qubit<1>
+  }
+}
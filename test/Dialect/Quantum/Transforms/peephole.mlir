@@ -0,0 +1,153 @@
+// RUN: quantum-opt --quantum-peephole %s | FileCheck %s --check-prefixes=CHECK,WIDE
+// RUN: quantum-opt --quantum-peephole="window=1" %s | FileCheck %s --check-prefixes=CHECK,NARROW
+
+module {
+  // CHECK-LABEL: func.func @nested_pairs_cancel(
+  // CHECK-SAME: %[[Q:.+]]: !quantum.qubit<1>)
+  func.func @nested_pairs_cancel(%q : !quantum.qubit<1>) -> !quantum.qubit<1> {
+    // CHECK-NOT: "quantum.X"
+    // CHECK-NOT: "quantum.Y"
+    %q1 = "quantum.X"(%q) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %q2 = "quantum.Y"(%q1) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %q3 = "quantum.Y"(%q2) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %q4 = "quantum.X"(%q3) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    // CHECK: return %[[Q]]
+    return %q4 : !quantum.qubit<1>
+  }
+
+  // CHECK-LABEL: func.func @cnot_ladder_cancel(
+  // CHECK-SAME: %[[A:.+]]: !quantum.qubit<1>, %[[B:.+]]: !quantum.qubit<1>, %[[C:.+]]: !quantum.qubit<1>)
+  func.func @cnot_ladder_cancel(%a : !quantum.qubit<1>, %b : !quantum.qubit<1>, %c : !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>, !quantum.qubit<1>) {
+    // CHECK-NOT: "quantum.CNOT"
+    %a1, %b1 = "quantum.CNOT"(%a, %b) : (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>)
+    %b2, %c1 = "quantum.CNOT"(%b1, %c) : (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>)
+    %b3, %c2 = "quantum.CNOT"(%b2, %c1) : (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>)
+    %a2, %b4 = "quantum.CNOT"(%a1, %b3) : (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>)
+    // CHECK: return %[[A]], %[[B]], %[[C]]
+    return %a2, %b4, %c2 : !quantum.qubit<1>, !quantum.qubit<1>, !quantum.qubit<1>
+  }
+
+  // Swapping control and target is not the inverse.
+  // CHECK-LABEL: func.func @reversed_cnot_no_cancel(
+  func.func @reversed_cnot_no_cancel(%a : !quantum.qubit<1>, %b : !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>) {
+    // CHECK: "quantum.CNOT"
+    %a1, %b1 = "quantum.CNOT"(%a, %b) : (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>)
+    // CHECK: "quantum.CNOT"
+    %b2, %a2 = "quantum.CNOT"(%b1, %a1) : (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>)
+    return %a2, %b2 : !quantum.qubit<1>, !quantum.qubit<1>
+  }
+
+  // CHECK-LABEL: func.func @inverse_pair_through_diagonal(
+  // CHECK-SAME: %[[Q:.+]]: !quantum.qubit<1>)
+  func.func @inverse_pair_through_diagonal(%q : !quantum.qubit<1>) -> !quantum.qubit<1> {
+    // CHECK-NOT: "quantum.S"
+    // CHECK: %[[T:.+]] = "quantum.T"(%[[Q]])
+    // CHECK-NOT: "quantum.Sdg"
+    %q1 = "quantum.S"(%q) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %q2 = "quantum.T"(%q1) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %q3 = "quantum.Sdg"(%q2) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    // CHECK: return %[[T]]
+    return %q3 : !quantum.qubit<1>
+  }
+
+  // CHECK-LABEL: func.func @hadamard_blocks_cancel(
+  func.func @hadamard_blocks_cancel(%q : !quantum.qubit<1>) -> !quantum.qubit<1> {
+    // CHECK: "quantum.H"
+    // CHECK: "quantum.Z"
+    // CHECK: "quantum.H"
+    %q1 = "quantum.H"(%q) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %q2 = "quantum.Z"(%q1) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %q3 = "quantum.H"(%q2) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    return %q3 : !quantum.qubit<1>
+  }
+
+  // CHECK-LABEL: func.func @merge_through_control(
+  // CHECK-SAME: %[[A:.+]]: !quantum.qubit<1>, %[[B:.+]]: !quantum.qubit<1>, %[[T1:.+]]: f64, %[[T2:.+]]: f64)
+  func.func @merge_through_control(%a : !quantum.qubit<1>, %b : !quantum.qubit<1>, %t1 : f64, %t2 : f64) -> (!quantum.qubit<1>, !quantum.qubit<1>) {
+    // CHECK: %[[CNOT:.+]]:2 = "quantum.CNOT"(%[[A]], %[[B]])
+    // CHECK: %[[SUM:.+]] = arith.addf %[[T1]], %[[T2]] : f64
+    // CHECK: %[[RZ:.+]] = "quantum.Rz"(%[[CNOT]]#0, %[[SUM]])
+    %a1 = "quantum.Rz"(%a, %t1) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+    %a2, %b1 = "quantum.CNOT"(%a1, %b) : (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>)
+    %a3 = "quantum.Rz"(%a2, %t2) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+    // CHECK: return %[[RZ]], %[[CNOT]]#1
+    return %a3, %b1 : !quantum.qubit<1>, !quantum.qubit<1>
+  }
+
+  // An Rz does not commute with the target of a CNOT.
+  // CHECK-LABEL: func.func @no_merge_through_target(
+  func.func @no_merge_through_target(%a : !quantum.qubit<1>, %b : !quantum.qubit<1>, %t : f64) -> (!quantum.qubit<1>, !quantum.qubit<1>) {
+    // CHECK: "quantum.Rz"
+    // CHECK: "quantum.CNOT"
+    // CHECK: "quantum.Rz"
+    %b1 = "quantum.Rz"(%b, %t) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+    %a1, %b2 = "quantum.CNOT"(%a, %b1) : (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>)
+    %b3 = "quantum.Rz"(%b2, %t) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+    return %a1, %b3 : !quantum.qubit<1>, !quantum.qubit<1>
+  }
+
+  // CHECK-LABEL: func.func @merge_constants(
+  // CHECK-SAME: %[[Q:.+]]: !quantum.qubit<1>)
+  func.func @merge_constants(%q : !quantum.qubit<1>) -> !quantum.qubit<1> {
+    // CHECK-NOT: arith.constant 2.500000e-01
+    // CHECK-NOT: arith.constant 5.000000e-01
+    // CHECK: %[[C:.+]] = arith.constant 7.500000e-01 : f64
+    // CHECK: %[[RZ:.+]] = "quantum.Rz"(%[[Q]], %[[C]])
+    // CHECK-NOT: "quantum.Rx"
+    %quarter = arith.constant 0.25 : f64
+    %half = arith.constant 0.5 : f64
+    %minus = arith.constant -0.5 : f64
+    %q1 = "quantum.Rz"(%q, %quarter) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+    %q2 = "quantum.Rz"(%q1, %half) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+    %q3 = "quantum.Rx"(%q2, %half) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+    %q4 = "quantum.Rx"(%q3, %minus) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+    // CHECK: return %[[RZ]]
+    return %q4 : !quantum.qubit<1>
+  }
+
+  // The rotations are two diagonal gates apart.
+  // CHECK-LABEL: func.func @window(
+  func.func @window(%q : !quantum.qubit<1>, %t1 : f64, %t2 : f64) -> !quantum.qubit<1> {
+    // WIDE-NOT: "quantum.Rz"
+    // NARROW: "quantum.Rz"
+    // CHECK: "quantum.T"
+    // CHECK: "quantum.S"
+    // WIDE: arith.addf
+    // CHECK: "quantum.Rz"
+    %q1 = "quantum.Rz"(%q, %t1) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+    %q2 = "quantum.T"(%q1) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %q3 = "quantum.S"(%q2) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %q4 = "quantum.Rz"(%q3, %t2) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+    return %q4 : !quantum.qubit<1>
+  }
+
+  // CHECK-LABEL: func.func @drop_diagonal_before_measure(
+  // CHECK-SAME: %[[Q:.+]]: !quantum.qubit<1>, %[[T:.+]]: f64)
+  func.func @drop_diagonal_before_measure(%q : !quantum.qubit<1>, %t : f64) -> (i1, !quantum.qubit<1>) {
+    // CHECK: %[[H:.+]] = "quantum.H"(%[[Q]])
+    // CHECK-NOT: "quantum.T"
+    // CHECK-NOT: "quantum.Rz"
+    // CHECK-NOT: "quantum.S"
+    // CHECK: "quantum.measure_single"(%[[H]])
+    %q1 = "quantum.H"(%q) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %q2 = "quantum.T"(%q1) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %q3 = "quantum.Rz"(%q2, %t) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+    %q4 = "quantum.S"(%q3) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %m, %q5 = "quantum.measure_single"(%q4) : (!quantum.qubit<1>) -> (i1, !quantum.qubit<1>)
+    return %m, %q5 : i1, !quantum.qubit<1>
+  }
+
+  // The sum of the merged angles is dropped with the rotation, and so are
+  // the angles it was the last user of.
+  // CHECK-LABEL: func.func @drop_merged_angles(
+  func.func @drop_merged_angles(%q : !quantum.qubit<1>, %t : f64) -> (i1, !quantum.qubit<1>) {
+    // CHECK-NOT: arith.
+    // CHECK: "quantum.measure_single"
+    %a = arith.mulf %t, %t : f64
+    %b = arith.addf %t, %t : f64
+    %q1 = "quantum.Rz"(%q, %a) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+    %q2 = "quantum.Rz"(%q1, %b) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+    %m, %q3 = "quantum.measure_single"(%q2) : (!quantum.qubit<1>) -> (i1, !quantum.qubit<1>)
+    return %m, %q3 : i1, !quantum.qubit<1>
+  }
+}
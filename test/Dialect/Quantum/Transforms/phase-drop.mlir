@@ -51,4 +51,16 @@ module {
     // CHECK: return %[[QOUT]] : !quantum.qubit<2>
     return %qout : !quantum.qubit<2>
   }
+
+  // Only Z is dropped, other diagonal gates are kept.
+  // CHECK-LABEL: func.func @no_drop_rz_before_measure(
+  func.func @no_drop_rz_before_measure(%q1 : !quantum.qubit<1>, %t : f64) -> !quantum.qubit<1> {
+    // CHECK: "quantum.Rz"
+    %q2 = "quantum.Rz"(%q1, %t) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+    // CHECK-NEXT: "quantum.S"
+    %q3 = "quantum.S"(%q2) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    // CHECK-NEXT: "quantum.measure"
+    %m, %qout = "quantum.measure"(%q3) : (!quantum.qubit<1>) -> (tensor<1xi1>, !quantum.qubit<1>)
+    return %qout : !quantum.qubit<1>
+  }
 }
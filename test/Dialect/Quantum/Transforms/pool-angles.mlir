@@ -0,0 +1,66 @@
+// RUN: quantum-opt %s --quantum-pool-angles | FileCheck %s
+
+// CHECK-LABEL: func.func @qir_kernel(
+// CHECK-SAME: %[[C:.+]]: i1
+func.func @qir_kernel(%cond: i1) {
+  // CHECK-NEXT: %[[A:.+]] = arith.constant 1.100000e+00 : f64
+  // CHECK-NEXT: %[[B:.+]] = arith.constant 3.455752e+00 : f64
+  // CHECK-NEXT: %[[SUM:.+]] = arith.constant 4.555752e+00 : f64
+  // CHECK-NEXT: %[[ZERO:.+]] = arith.constant 0.000000e+00 : f64
+  // CHECK-NEXT: %[[NEGZERO:.+]] = arith.constant -0.000000e+00 : f64
+  // CHECK-NEXT: %[[Q:.+]] = "qir.alloc"
+  %q = "qir.alloc" () : () -> (!qir.qubit)
+  %0 = arith.constant 1.100000 : f64
+  // CHECK-NEXT: "qir.Rx"(%[[Q]], %[[A]])
+  "qir.Rx" (%q, %0) : (!qir.qubit, f64) -> ()
+  %1 = arith.constant 1.100000 : f64
+  // CHECK-NEXT: "qir.Ry"(%[[Q]], %[[A]])
+  "qir.Ry" (%q, %1) : (!qir.qubit, f64) -> ()
+  %2 = arith.constant 3.455752 : f64
+  %3 = arith.addf %1, %2 : f64
+  %4 = arith.constant 1.100000 : f64
+  %5 = arith.addf %4, %2 : f64
+  // CHECK-NEXT: "qir.Rz"(%[[Q]], %[[SUM]])
+  "qir.Rz" (%q, %3) : (!qir.qubit, f64) -> ()
+  // CHECK-NEXT: "qir.Rz"(%[[Q]], %[[SUM]])
+  "qir.Rz" (%q, %5) : (!qir.qubit, f64) -> ()
+  // CHECK-NEXT: scf.if %[[C]]
+  scf.if %cond {
+    %6 = arith.constant 1.100000 : f64
+    // CHECK-NEXT: "qir.Rx"(%[[Q]], %[[A]])
+    "qir.Rx" (%q, %6) : (!qir.qubit, f64) -> ()
+    %7 = arith.constant 0.000000 : f64
+    %8 = arith.constant -0.000000 : f64
+    // CHECK-NEXT: "qir.U2"(%[[Q]], %[[ZERO]], %[[NEGZERO]])
+    "qir.U2" (%q, %7, %8) : (!qir.qubit, f64, f64) -> ()
+  }
+  return
+}
+
+// The body of a quantum.if is isolated from above, so it has its own pool.
+
+// CHECK-LABEL: func.func @quantum_kernel(
+func.func @quantum_kernel(%cond: i1) -> !quantum.qubit<1> {
+  // CHECK-NEXT: %[[A:.+]] = arith.constant 5.000000e-01 : f64
+  // CHECK-NEXT: quantum.alloc
+  %q = "quantum.alloc" () : () -> (!quantum.qubit<1>)
+  %0 = arith.constant 0.5 : f64
+  %q1 = "quantum.Rz" (%q, %0) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+  // CHECK: quantum.if
+  %out = quantum.if %cond ins(%arg0 = %q1) -> (!quantum.qubit<1>) {
+    // CHECK-NEXT: %[[B:.+]] = arith.constant 5.000000e-01 : f64
+    // CHECK-NEXT: "quantum.Rz"(%{{.+}}, %[[B]])
+    // CHECK-NEXT: "quantum.Rx"(%{{.+}}, %[[B]])
+    %1 = arith.constant 0.5 : f64
+    %2 = "quantum.Rz" (%arg0, %1) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+    %3 = arith.constant 0.5 : f64
+    %4 = "quantum.Rx" (%2, %3) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+    quantum.yield %4 : !quantum.qubit<1>
+  } else {
+    quantum.yield %arg0 : !quantum.qubit<1>
+  }
+  %5 = arith.constant 0.5 : f64
+  %q2 = "quantum.Ry" (%out, %5) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+  // CHECK: "quantum.Ry"(%{{.+}}, %[[A]])
+  return %q2 : !quantum.qubit<1>
+}
@@ -0,0 +1,82 @@
+// RUN: quantum-opt --quantum-rotate-loops %s | FileCheck %s
+
+module {
+  // The basis changes and CNOTs of a Trotter step undo each other between
+  // iterations, so only the Rz stays in the loop.
+  // CHECK-LABEL: func.func @trotter(
+  // CHECK-SAME: %[[N:[^:]+]]: index, %[[T:[^:]+]]: f64, %[[A:[^:]+]]: !quantum.qubit<1>, %[[B:[^:]+]]: !quantum.qubit<1>)
+  func.func @trotter(%n : index, %t : f64, %a : !quantum.qubit<1>, %b : !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>) {
+    %lb = arith.constant 0 : index
+    %step = arith.constant 1 : index
+    // CHECK: %[[H:.+]] = "quantum.H"(%[[A]])
+    // CHECK-NEXT: %[[CNOT:.+]]:2 = "quantum.CNOT"(%[[H]], %[[B]])
+    // CHECK-NEXT: %[[LOOP:.+]]:3 = quantum.for %{{.+}} = %{{.+}} to %[[N]] step %{{.+}} ins(%[[LA:[^ ]+]] = %[[CNOT]]#0, %[[LB:[^ ]+]] = %[[CNOT]]#1, %[[LT:[^ ]+]] = %[[T]])
+    // CHECK-NEXT: %[[RZ:.+]] = "quantum.Rz"(%[[LB]], %[[LT]])
+    // CHECK-NEXT: quantum.yield %[[LA]], %[[RZ]], %[[LT]]
+    // CHECK-NEXT: }
+    // CHECK-NEXT: %[[CNOT2:.+]]:2 = "quantum.CNOT"(%[[LOOP]]#0, %[[LOOP]]#1)
+    // CHECK-NEXT: %[[H2:.+]] = "quantum.H"(%[[CNOT2]]#0)
+    // CHECK-NEXT: return %[[H2]], %[[CNOT2]]#1
+    %a2, %b2, %t2 = quantum.for %i = %lb to %n step %step ins(%la = %a, %lb2 = %b, %lt = %t) -> (!quantum.qubit<1>, !quantum.qubit<1>, f64) {
+      %0 = "quantum.H"(%la) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+      %1, %2 = "quantum.CNOT"(%0, %lb2) : (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>)
+      %3 = "quantum.Rz"(%2, %lt) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+      %4, %5 = "quantum.CNOT"(%1, %3) : (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>)
+      %6 = "quantum.H"(%4) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+      quantum.yield %6, %5, %lt : !quantum.qubit<1>, !quantum.qubit<1>, f64
+    }
+    return %a2, %b2 : !quantum.qubit<1>, !quantum.qubit<1>
+  }
+
+  // Rotations by opposite constant angles cancel as well.
+  // CHECK-LABEL: func.func @opposite_angles(
+  // CHECK-SAME: %[[N:[^:]+]]: index, %[[A:[^:]+]]: !quantum.qubit<1>)
+  func.func @opposite_angles(%n : index, %a : !quantum.qubit<1>) -> !quantum.qubit<1> {
+    %lb = arith.constant 0 : index
+    %step = arith.constant 1 : index
+    // CHECK: %[[ANGLE:.+]] = arith.constant 5.000000e-01 : f64
+    // CHECK-NEXT: %[[RX:.+]] = "quantum.Rx"(%[[A]], %[[ANGLE]])
+    // CHECK-NEXT: %[[LOOP:.+]] = quantum.for %{{.+}} ins(%[[LA:[^ ]+]] = %[[RX]])
+    // CHECK-NEXT: %[[Z:.+]] = "quantum.Z"(%[[LA]])
+    // CHECK-NEXT: quantum.yield %[[Z]]
+    // CHECK-NEXT: }
+    // CHECK-NEXT: %[[NEG:.+]] = arith.constant -5.000000e-01 : f64
+    // CHECK-NEXT: %[[RX2:.+]] = "quantum.Rx"(%[[LOOP]], %[[NEG]])
+    // CHECK-NEXT: return %[[RX2]]
+    %a2 = quantum.for %i = %lb to %n step %step ins(%la = %a) -> (!quantum.qubit<1>) {
+      %pos = arith.constant 0.5 : f64
+      %neg = arith.constant -0.5 : f64
+      %0 = "quantum.Rx"(%la, %pos) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+      %1 = "quantum.Z"(%0) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+      %2 = "quantum.Rx"(%1, %neg) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+      quantum.yield %2 : !quantum.qubit<1>
+    }
+    return %a2 : !quantum.qubit<1>
+  }
+
+  // A single gate is repeated by the loop, and an angle that depends on the
+  // induction variable changes between iterations.
+  // CHECK-LABEL: func.func @no_pair(
+  func.func @no_pair(%n : index, %a : !quantum.qubit<1>, %b : !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>) {
+    %lb = arith.constant 0 : index
+    %step = arith.constant 1 : index
+    // CHECK: quantum.for
+    // CHECK-NEXT: "quantum.X"
+    // CHECK-NEXT: arith.index_cast
+    // CHECK-NEXT: arith.uitofp
+    // CHECK-NEXT: "quantum.Rz"
+    // CHECK-NEXT: "quantum.Z"
+    // CHECK-NEXT: "quantum.Rz"
+    // CHECK-NEXT: quantum.yield
+    %a2, %b2 = quantum.for %i = %lb to %n step %step ins(%la = %a, %lb2 = %b) -> (!quantum.qubit<1>, !quantum.qubit<1>) {
+      %0 = "quantum.X"(%la) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+      %j = arith.index_cast %i : index to i64
+      %angle = arith.uitofp %j : i64 to f64
+      %1 = "quantum.Rz"(%lb2, %angle) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+      %2 = "quantum.Z"(%1) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+      %3 = "quantum.Rz"(%2, %angle) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+      quantum.yield %0, %3 : !quantum.qubit<1>, !quantum.qubit<1>
+    }
+    return %a2, %b2 : !quantum.qubit<1>, !quantum.qubit<1>
+  }
+}
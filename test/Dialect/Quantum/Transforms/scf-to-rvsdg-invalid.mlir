@@ -0,0 +1,15 @@
+// RUN: quantum-opt %s --scf-to-rvsdg -split-input-file -verify-diagnostics
+
+// The body consumes a qubit from above in every iteration instead of
+// carrying it, so the loop cannot become a quantum.for.
+func.func @qubit_from_above(%n : index, %q : !quantum.qubit<1>, %r : !quantum.qubit<1>) -> (!quantum.qubit<1>) {
+    %lb = arith.constant 0 : index
+    %step = arith.constant 1 : index
+    // expected-error@+1 {{failed to legalize operation 'scf.for' that was explicitly marked illegal}}
+    %r1 = scf.for %i = %lb to %n step %step iter_args(%rin = %r) -> !quantum.qubit<1> {
+        %qH = "quantum.H" (%q) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+        %0, %1 = "quantum.CNOT" (%qH, %rin) : (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>)
+        scf.yield %1 : !quantum.qubit<1>
+    }
+    return %r1 : !quantum.qubit<1>
+}
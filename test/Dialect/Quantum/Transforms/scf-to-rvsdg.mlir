@@ -17,4 +17,26 @@ func.func @if_to_rvsdg_gamma(%b : i1, %q : !quantum.qubit<1>) -> (!quantum.qubit
     }
     // CHECK-DAG: return %[[QR]]
     return %q1 : !quantum.qubit<1>
-}
\ No newline at end of file
+}
+
+// -----
+
+// CHECK-LABEL: func.func @for_to_rvsdg_theta
+// CHECK-SAME: (%[[N:[^:]+]]: index, %[[T:[^:]+]]: f64, %[[Q:[^:]+]]: !quantum.qubit<1>)
+func.func @for_to_rvsdg_theta(%n : index, %theta : f64, %q : !quantum.qubit<1>) -> (!quantum.qubit<1>) {
+    // CHECK-DAG: %[[LB:.+]] = arith.constant 0 : index
+    // CHECK-DAG: %[[STEP:.+]] = arith.constant 1 : index
+    %lb = arith.constant 0 : index
+    %step = arith.constant 1 : index
+    // CHECK: %[[QR:.+]]:2 = quantum.for %[[I:.+]] = %[[LB]] to %[[N]] step %[[STEP]] ins(%[[QIN:.+]] = %[[Q]], %[[TIN:.+]] = %[[T]]) -> (!quantum.qubit<1>, f64)
+    %q1 = scf.for %i = %lb to %n step %step iter_args(%qin = %q) -> !quantum.qubit<1> {
+        // CHECK-NEXT: %[[QH:.+]] = "quantum.H"(%[[QIN]])
+        %qH = "quantum.H" (%qin) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+        // CHECK-NEXT: %[[QRZ:.+]] = "quantum.Rz"(%[[QH]], %[[TIN]])
+        %qRz = "quantum.Rz" (%qH, %theta) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+        // CHECK-NEXT: quantum.yield %[[QRZ]], %[[TIN]] : !quantum.qubit<1>, f64
+        scf.yield %qRz : !quantum.qubit<1>
+    }
+    // CHECK: return %[[QR]]#0
+    return %q1 : !quantum.qubit<1>
+}
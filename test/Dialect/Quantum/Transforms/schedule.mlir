@@ -0,0 +1,78 @@
+// RUN: quantum-opt --quantum-schedule %s | FileCheck %s --check-prefixes=CHECK,DEPTH,ASAP
+// RUN: quantum-opt --quantum-schedule="layering=alap" %s | FileCheck %s --check-prefixes=CHECK,DEPTH,ALAP
+// RUN: quantum-opt --quantum-schedule="objective=fusion" %s | FileCheck %s --check-prefixes=CHECK,FUSION
+
+module {
+  // CHECK-LABEL: func.func @layers(
+  // CHECK-SAME: %[[A:[^:]+]]: !quantum.qubit<1>, %[[B:[^:]+]]: !quantum.qubit<1>, %[[C:[^:]+]]: !quantum.qubit<1>, %[[T:[^:]+]]: f64)
+  func.func @layers(%a : !quantum.qubit<1>, %b : !quantum.qubit<1>, %c : !quantum.qubit<1>, %t : f64) -> (!quantum.qubit<1>, !quantum.qubit<1>, !quantum.qubit<1>) {
+    // ASAP: %[[HA:.+]] = "quantum.H"(%[[A]])
+    // ASAP-NEXT: %[[HB:.+]] = "quantum.H"(%[[B]])
+    // ASAP-NEXT: %[[X:.+]] = "quantum.X"(%[[C]])
+    // ASAP-NEXT: %[[RZA:.+]] = "quantum.Rz"(%[[HA]], %[[T]])
+    // ASAP-NEXT: %[[RZB:.+]] = "quantum.Rz"(%[[HB]], %[[T]])
+    // ASAP-NEXT: %[[CNOT:.+]]:2 = "quantum.CNOT"(%[[RZA]], %[[RZB]])
+
+    // ALAP: %[[HA:.+]] = "quantum.H"(%[[A]])
+    // ALAP-NEXT: %[[HB:.+]] = "quantum.H"(%[[B]])
+    // ALAP-NEXT: %[[RZA:.+]] = "quantum.Rz"(%[[HA]], %[[T]])
+    // ALAP-NEXT: %[[RZB:.+]] = "quantum.Rz"(%[[HB]], %[[T]])
+    // ALAP-NEXT: %[[CNOT:.+]]:2 = "quantum.CNOT"(%[[RZA]], %[[RZB]])
+    // ALAP-NEXT: %[[X:.+]] = "quantum.X"(%[[C]])
+
+    // FUSION: %[[HA:.+]] = "quantum.H"(%[[A]])
+    // FUSION-NEXT: %[[RZA:.+]] = "quantum.Rz"(%[[HA]], %[[T]])
+    // FUSION-NEXT: %[[HB:.+]] = "quantum.H"(%[[B]])
+    // FUSION-NEXT: %[[RZB:.+]] = "quantum.Rz"(%[[HB]], %[[T]])
+    // FUSION-NEXT: %[[X:.+]] = "quantum.X"(%[[C]])
+    // FUSION-NEXT: %[[CNOT:.+]]:2 = "quantum.CNOT"(%[[RZA]], %[[RZB]])
+    %a1 = "quantum.H"(%a) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %b1 = "quantum.H"(%b) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %a2 = "quantum.Rz"(%a1, %t) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+    %b2 = "quantum.Rz"(%b1, %t) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+    %a3, %b3 = "quantum.CNOT"(%a2, %b2) : (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>)
+    %c1 = "quantum.X"(%c) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    // CHECK: return %[[CNOT]]#0, %[[CNOT]]#1, %[[X]]
+    return %a3, %b3, %c1 : !quantum.qubit<1>, !quantum.qubit<1>, !quantum.qubit<1>
+  }
+
+  // The Rz commutes with the control of the CNOT, which waits for the gates
+  // on its target, so moving it ahead saves a layer.
+  // CHECK-LABEL: func.func @commute_ahead_of_control(
+  // CHECK-SAME: %[[A:[^:]+]]: !quantum.qubit<1>, %[[B:[^:]+]]: !quantum.qubit<1>, %[[T:[^:]+]]: f64)
+  func.func @commute_ahead_of_control(%a : !quantum.qubit<1>, %b : !quantum.qubit<1>, %t : f64) -> (!quantum.qubit<1>, !quantum.qubit<1>) {
+    // ASAP: %[[H:.+]] = "quantum.H"(%[[B]])
+    // ASAP-NEXT: %[[RZ:.+]] = "quantum.Rz"(%[[A]], %[[T]])
+    // ASAP-NEXT: %[[Y:.+]] = "quantum.Y"(%[[H]])
+
+    // ALAP: %[[H:.+]] = "quantum.H"(%[[B]])
+    // ALAP-NEXT: %[[Y:.+]] = "quantum.Y"(%[[H]])
+    // ALAP-NEXT: %[[RZ:.+]] = "quantum.Rz"(%[[A]], %[[T]])
+
+    // DEPTH-NEXT: %[[CNOT:.+]]:2 = "quantum.CNOT"(%[[RZ]], %[[Y]])
+    // DEPTH-NEXT: return %[[CNOT]]#0, %[[CNOT]]#1
+
+    // FUSION: %[[H:.+]] = "quantum.H"(%[[B]])
+    // FUSION-NEXT: %[[Y:.+]] = "quantum.Y"(%[[H]])
+    // FUSION-NEXT: %[[CNOT:.+]]:2 = "quantum.CNOT"(%[[A]], %[[Y]])
+    // FUSION-NEXT: %[[RZ:.+]] = "quantum.Rz"(%[[CNOT]]#0, %[[T]])
+    // FUSION-NEXT: return %[[RZ]], %[[CNOT]]#1
+    %b1 = "quantum.H"(%b) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %b2 = "quantum.Y"(%b1) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %a1, %b3 = "quantum.CNOT"(%a, %b2) : (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>)
+    %a2 = "quantum.Rz"(%a1, %t) : (!quantum.qubit<1>, f64) -> (!quantum.qubit<1>)
+    return %a2, %b3 : !quantum.qubit<1>, !quantum.qubit<1>
+  }
+
+  // Gates are not moved across a measurement.
+  // CHECK-LABEL: func.func @measurement_is_a_fence(
+  func.func @measurement_is_a_fence(%a : !quantum.qubit<1>, %b : !quantum.qubit<1>) -> (i1, !quantum.qubit<1>, !quantum.qubit<1>) {
+    // CHECK: "quantum.H"
+    // CHECK-NEXT: "quantum.measure_single"
+    // CHECK-NEXT: "quantum.X"
+    %a1 = "quantum.H"(%a) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    %m, %a2 = "quantum.measure_single"(%a1) : (!quantum.qubit<1>) -> (i1, !quantum.qubit<1>)
+    %b1 = "quantum.X"(%b) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+    return %m, %a2, %b1 : i1, !quantum.qubit<1>, !quantum.qubit<1>
+  }
+}
@@ -0,0 +1,45 @@
+// RUN: quantum-opt %s \
+// RUN:   --pass-pipeline="builtin.module( \
+// RUN:       qir-localize-qubits{global-qubits=2}, \
+// RUN:       qir-trajectory-driver{kernel=ghz driver=entry}, \
+// RUN:       convert-qir-to-llvm, \
+// RUN:       convert-func-to-llvm, \
+// RUN:       convert-arith-to-llvm, \
+// RUN:       reconcile-unrealized-casts)" -o %t.mlir
+// RUN: env QUANTUM_RUNTIME_CONFIG="trajectories=200" \
+// RUN: quantum-launch -n 4 mlir-runner %t.mlir -e entry \
+// RUN:     -entry-point-result=void \
+// RUN:     --shared-libs=%quantum_runtime,%mlir_c_runner_utils | \
+// RUN: FileCheck %s --match-full-lines
+
+// Four ranks shard the state over the two global qubits. Only rank 0
+// prints, and a GHZ state only ever yields correlated outcomes.
+// CHECK: 0000: {{[0-9]+}}
+// CHECK-NEXT: 1111: {{[0-9]+}}
+// CHECK-NOT: {{.+}}
+module {
+  func.func @ghz() {
+    "qir.init"() : () -> ()
+    %seed = arith.constant 7 : i64
+    "qir.seed"(%seed) : (i64) -> ()
+    %q0 = "qir.alloc"() : () -> (!qir.qubit)
+    %q1 = "qir.alloc"() : () -> (!qir.qubit)
+    %q2 = "qir.alloc"() : () -> (!qir.qubit)
+    %q3 = "qir.alloc"() : () -> (!qir.qubit)
+    %r0 = "qir.ralloc"() : () -> (!qir.result)
+    %r1 = "qir.ralloc"() : () -> (!qir.result)
+    %r2 = "qir.ralloc"() : () -> (!qir.result)
+    %r3 = "qir.ralloc"() : () -> (!qir.result)
+    "qir.H"(%q0) : (!qir.qubit) -> ()
+    "qir.CNOT"(%q0, %q1) : (!qir.qubit, !qir.qubit) -> ()
+    "qir.CNOT"(%q1, %q2) : (!qir.qubit, !qir.qubit) -> ()
+    "qir.CNOT"(%q2, %q3) : (!qir.qubit, !qir.qubit) -> ()
+    "qir.H"(%q0) : (!qir.qubit) -> ()
+    "qir.H"(%q0) : (!qir.qubit) -> ()
+    "qir.measure"(%q0, %r0) : (!qir.qubit, !qir.result) -> ()
+    "qir.measure"(%q1, %r1) : (!qir.qubit, !qir.result) -> ()
+    "qir.measure"(%q2, %r2) : (!qir.qubit, !qir.result) -> ()
+    "qir.measure"(%q3, %r3) : (!qir.qubit, !qir.result) -> ()
+    return
+  }
+}
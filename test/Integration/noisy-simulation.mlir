@@ -0,0 +1,95 @@
+// RUN: quantum-opt %s \
+// RUN:   --pass-pipeline="builtin.module( \
+// RUN:       convert-qir-to-llvm{runtime-config=backend=statevector}, \
+// RUN:       convert-func-to-llvm, \
+// RUN:       convert-vector-to-llvm, \
+// RUN:       one-shot-bufferize{allow-unknown-ops}, \
+// RUN:       finalize-memref-to-llvm, \
+// RUN:       convert-index-to-llvm, \
+// RUN:       convert-arith-to-llvm, \
+// RUN:       reconcile-unrealized-casts)" | \
+// RUN: mlir-runner -e entry -entry-point-result=void \
+// RUN:     --shared-libs=%quantum_runtime,%mlir_c_runner_utils | \
+// RUN: FileCheck %s --match-full-lines
+// RUN: quantum-opt %s \
+// RUN:   --pass-pipeline="builtin.module( \
+// RUN:       convert-qir-to-llvm, \
+// RUN:       convert-func-to-llvm, \
+// RUN:       convert-vector-to-llvm, \
+// RUN:       one-shot-bufferize{allow-unknown-ops}, \
+// RUN:       finalize-memref-to-llvm, \
+// RUN:       convert-index-to-llvm, \
+// RUN:       convert-arith-to-llvm, \
+// RUN:       reconcile-unrealized-casts)" | \
+// RUN: env QUANTUM_RUNTIME_CONFIG="storage=mmap;storage-dir=%T;chunk-qubits=1" \
+// RUN: mlir-runner -e entry -entry-point-result=void \
+// RUN:     --shared-libs=%quantum_runtime,%mlir_c_runner_utils | \
+// RUN: FileCheck %s --match-full-lines
+// RUN: quantum-opt %s \
+// RUN:   --pass-pipeline="builtin.module( \
+// RUN:       convert-qir-to-llvm{runtime-config=backend=density-matrix}, \
+// RUN:       convert-func-to-llvm, \
+// RUN:       convert-vector-to-llvm, \
+// RUN:       one-shot-bufferize{allow-unknown-ops}, \
+// RUN:       finalize-memref-to-llvm, \
+// RUN:       convert-index-to-llvm, \
+// RUN:       convert-arith-to-llvm, \
+// RUN:       reconcile-unrealized-casts)" | \
+// RUN: mlir-runner -e entry -entry-point-result=void \
+// RUN:     --shared-libs=%quantum_runtime,%mlir_c_runner_utils | \
+// RUN: FileCheck %s --match-full-lines
+
+// Channels with probability 1 are deterministic on both backends.
+module {
+  func.func @test_full_damping_returns_0() {
+    "qir.init"() : () -> ()
+    %q = "qir.alloc"() : () -> (!qir.qubit)
+    %r = "qir.ralloc"() : () -> (!qir.result)
+    "qir.X"(%q) : (!qir.qubit) -> ()
+    "qir.amplitude_damping"(%q) <{gamma = 1.0 : f64}> : (!qir.qubit) -> ()
+    "qir.measure"(%q, %r) : (!qir.qubit, !qir.result) -> ()
+    %mt = "qir.read_measurement"(%r) : (!qir.result) -> (tensor<1xi1>)
+    %i = "index.constant" () {value = 0 : index} : () -> (index)
+    %m = "tensor.extract" (%mt, %i) : (tensor<1xi1>, index) -> (i1)
+    vector.print %m : i1
+    return
+  }
+
+  func.func @test_full_readout_error_returns_0() {
+    "qir.init"() : () -> ()
+    %q = "qir.alloc"() : () -> (!qir.qubit)
+    %r = "qir.ralloc"() : () -> (!qir.result)
+    "qir.X"(%q) : (!qir.qubit) -> ()
+    "qir.measure"(%q, %r) : (!qir.qubit, !qir.result) -> ()
+    "qir.readout_error"(%r) <{probability = 1.0 : f64}> : (!qir.result) -> ()
+    %mt = "qir.read_measurement"(%r) : (!qir.result) -> (tensor<1xi1>)
+    %i = "index.constant" () {value = 0 : index} : () -> (index)
+    %m = "tensor.extract" (%mt, %i) : (tensor<1xi1>, index) -> (i1)
+    vector.print %m : i1
+    return
+  }
+
+  func.func @test_noiseless_returns_1() {
+    "qir.init"() : () -> ()
+    %q = "qir.alloc"() : () -> (!qir.qubit)
+    %r = "qir.ralloc"() : () -> (!qir.result)
+    "qir.X"(%q) : (!qir.qubit) -> ()
+    "qir.amplitude_damping"(%q) <{gamma = 0.0 : f64}> : (!qir.qubit) -> ()
+    "qir.measure"(%q, %r) : (!qir.qubit, !qir.result) -> ()
+    %mt = "qir.read_measurement"(%r) : (!qir.result) -> (tensor<1xi1>)
+    %i = "index.constant" () {value = 0 : index} : () -> (index)
+    %m = "tensor.extract" (%mt, %i) : (tensor<1xi1>, index) -> (i1)
+    vector.print %m : i1
+    return
+  }
+
+  func.func @entry() {
+    // CHECK: 0
+    func.call @test_full_damping_returns_0() : () -> ()
+    // CHECK: 0
+    func.call @test_full_readout_error_returns_0() : () -> ()
+    // CHECK: 1
+    func.call @test_noiseless_returns_1() : () -> ()
+    return
+  }
+}
@@ -0,0 +1,34 @@
+// RUN: quantum-opt %s \
+// RUN:   --pass-pipeline='builtin.module( \
+// RUN:       qir-trajectory-driver{kernel=bell driver=entry}, \
+// RUN:       convert-qir-to-llvm{runtime-config="trajectories=1000;threads=4"}, \
+// RUN:       convert-func-to-llvm, \
+// RUN:       convert-arith-to-llvm, \
+// RUN:       reconcile-unrealized-casts)' | \
+// RUN: mlir-runner -e entry -entry-point-result=void \
+// RUN:     --shared-libs=%quantum_runtime,%mlir_c_runner_utils | \
+// RUN: awk '{ print; total += $2 } END { print "total: " total }' | \
+// RUN: FileCheck %s --match-full-lines
+
+// A Bell pair only ever yields correlated outcomes, and the trajectories set
+// through the runtime-config option of the lowering are all executed.
+// CHECK: 00: {{[0-9]+}}
+// CHECK-NEXT: 11: {{[0-9]+}}
+// CHECK-NEXT: total: 1000
+// CHECK-NOT: {{.+}}
+module {
+  func.func @bell() {
+    "qir.init"() : () -> ()
+    %seed = arith.constant 23 : i64
+    "qir.seed"(%seed) : (i64) -> ()
+    %q0 = "qir.alloc"() : () -> (!qir.qubit)
+    %q1 = "qir.alloc"() : () -> (!qir.qubit)
+    %r0 = "qir.ralloc"() : () -> (!qir.result)
+    %r1 = "qir.ralloc"() : () -> (!qir.result)
+    "qir.H"(%q0) : (!qir.qubit) -> ()
+    "qir.CNOT"(%q0, %q1) : (!qir.qubit, !qir.qubit) -> ()
+    "qir.measure"(%q0, %r0) : (!qir.qubit, !qir.result) -> ()
+    "qir.measure"(%q1, %r1) : (!qir.qubit, !qir.result) -> ()
+    return
+  }
+}
@@ -88,6 +88,25 @@ func.func @test_qasm_output_correctness() -> ()  {
     return
   }
 
+  // Function applying an X gate in a loop of three iterations, which stays a
+  // loop in the lowered program
+  func.func @test_quantum_for_3_X_returns_1() -> () {
+    %lb = arith.constant 0 : index
+    %ub = arith.constant 3 : index
+    %step = arith.constant 1 : index
+    %q = "quantum.alloc"() : () -> (!quantum.qubit<1>)
+    %q1 = quantum.for %iv = %lb to %ub step %step ins(%qin = %q) -> (!quantum.qubit<1>) {
+      %qX = "quantum.X" (%qin) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+      quantum.yield %qX : !quantum.qubit<1>
+    }
+    %mt, %q_m = "quantum.measure" (%q1) : (!quantum.qubit<1>) -> (tensor<1xi1>, !quantum.qubit<1>)
+    "quantum.deallocate"(%q_m) : (!quantum.qubit<1>) -> ()
+    %i = "index.constant" () {value = 0 : index} : () -> (index)
+    %m = "tensor.extract" (%mt, %i) : (tensor<1xi1>, index) -> (i1)
+    vector.print %m : i1
+    return
+  }
+
   func.func @entry() {
     // CHECK: 1
     func.call @test_0_X_returns_1() : () -> ()
@@ -97,6 +116,9 @@ func.func @test_qasm_output_correctness() -> ()  {
 
     // CHECK: 1
     func.call @test_qasm_output_correctness() : () -> ()
+
+    // CHECK: 1
+    func.call @test_quantum_for_3_X_returns_1() : () -> ()
     return
   }
 }
@@ -0,0 +1,32 @@
+// RUN: quantum-translate --mlir-to-qir-adaptive %s | FileCheck %s
+// RUN: not quantum-translate --mlir-to-qir-base %s 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=BASE
+
+// BASE: reading a result is not part of the base_profile
+
+// CHECK-LABEL: define void @teleport() #[[ENTRY:[0-9]+]]
+// CHECK: call void @__quantum__qis__mz__body(ptr null, ptr null)
+// CHECK: call i1 @__quantum__qis__read_result__body(ptr null)
+// CHECK: br i1
+// CHECK: call void @__quantum__qis__x__body(ptr inttoptr (i64 1 to ptr))
+
+// CHECK: attributes #[[ENTRY]] = {
+// CHECK-SAME: "qir_profiles"="adaptive_profile"
+// CHECK-SAME: "required_num_qubits"="2"
+// CHECK-SAME: "required_num_results"="1"
+
+func.func @teleport() {
+  %q0 = "qir.alloc"() : () -> (!qir.qubit)
+  %q1 = "qir.alloc"() : () -> (!qir.qubit)
+  %r0 = "qir.ralloc"() : () -> (!qir.result)
+  "qir.H"(%q0) : (!qir.qubit) -> ()
+  "qir.measure"(%q0, %r0) : (!qir.qubit, !qir.result) -> ()
+  %m = "qir.read_measurement"(%r0) : (!qir.result) -> (tensor<1xi1>)
+  %i = index.constant 0
+  %b = tensor.extract %m[%i] : tensor<1xi1>
+  scf.if %b {
+    "qir.X"(%q1) : (!qir.qubit) -> ()
+  }
+  return
+}
+
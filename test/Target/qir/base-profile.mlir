@@ -0,0 +1,40 @@
+// RUN: quantum-translate --mlir-to-qir-base %s | FileCheck %s
+// RUN: quantum-translate --mlir-to-qir-base --qir-emit-bitcode %s -o %t.bc
+// RUN: llvm-dis %t.bc -o - | FileCheck %s
+
+// CHECK-LABEL: define void @main() #[[ENTRY:[0-9]+]]
+// CHECK-NEXT: call void @__quantum__rt__initialize(ptr null)
+// CHECK: call void @__quantum__qis__h__body(ptr null)
+// CHECK: call void @__quantum__qis__cnot__body(ptr null, ptr inttoptr (i64 1 to ptr))
+// CHECK: call void @__quantum__qis__mz__body(ptr null, ptr null)
+// CHECK: call void @__quantum__qis__mz__body(ptr inttoptr (i64 1 to ptr), ptr inttoptr (i64 1 to ptr))
+// CHECK: call void @__quantum__rt__result_record_output(ptr null, ptr null)
+// CHECK-NEXT: call void @__quantum__rt__result_record_output(ptr inttoptr (i64 1 to ptr), ptr null)
+// CHECK-NEXT: ret void
+
+// CHECK: declare void @__quantum__qis__mz__body(ptr, ptr) #[[IRREVERSIBLE:[0-9]+]]
+
+// CHECK: attributes #[[ENTRY]] = {
+// CHECK-SAME: "entry_point"
+// CHECK-SAME: "output_labeling_schema"
+// CHECK-SAME: "qir_profiles"="base_profile"
+// CHECK-SAME: "required_num_qubits"="2"
+// CHECK-SAME: "required_num_results"="2"
+// CHECK: attributes #[[IRREVERSIBLE]] = { "irreversible" }
+
+// CHECK-DAG: !{i32 1, !"qir_major_version", i32 1}
+// CHECK-DAG: !{i32 7, !"qir_minor_version", i32 0}
+// CHECK-DAG: !{i32 1, !"dynamic_qubit_management", i1 false}
+// CHECK-DAG: !{i32 1, !"dynamic_result_allocation", i1 false}
+
+func.func @main() {
+  %q0 = "qir.alloc"() : () -> (!qir.qubit)
+  %q1 = "qir.alloc"() : () -> (!qir.qubit)
+  %r0 = "qir.ralloc"() : () -> (!qir.result)
+  %r1 = "qir.ralloc"() : () -> (!qir.result)
+  "qir.H"(%q0) : (!qir.qubit) -> ()
+  "qir.CNOT"(%q0, %q1) : (!qir.qubit, !qir.qubit) -> ()
+  "qir.measure"(%q0, %r0) : (!qir.qubit, !qir.result) -> ()
+  "qir.measure"(%q1, %r1) : (!qir.qubit, !qir.result) -> ()
+  return
+}
@@ -15,7 +15,7 @@ config.name = "quantum-mlir"
 config.test_format = lit.formats.ShTest(not llvm_config.use_lit_shell)
 
 # suffixes: A list of file extensions to treat as test files.
-config.suffixes = [".mlir"]
+config.suffixes = [".mlir", ".py"]
 
 # test_source_root: The root path where tests are located.
 config.test_source_root = os.path.dirname(__file__)
@@ -36,14 +36,21 @@ def find_runtime(dir, name):
 
 # Searches for a runtime library with the given name and returns a tool
 # substitution of the same name and the found path.
-def add_runtime(name):
-    return ToolSubst(f"%{name}", find_runtime(config.llvm_lib_dir, name))
+def add_runtime(name, dir=config.llvm_lib_dir, subst=None):
+    return ToolSubst(f"%{subst or name}", find_runtime(dir, name))
 
 
 # excludes: A list of directories to exclude from the testsuite. The 'Inputs'
 # subdirectories contain auxiliary inputs for various tests in their parent
 # directories.
-config.excludes = ["Inputs", "CMakeLists.txt", "README.md", "LICENSE.txt"]
+config.excludes = [
+    "Inputs",
+    "CMakeLists.txt",
+    "README.md",
+    "LICENSE.txt",
+    "lit.cfg.py",
+    "lit.site.cfg.py",
+]
 
 config.substitutions.append(("%PATH%", config.environment["PATH"]))
 config.substitutions.append(("%shlibext", config.llvm_shlib_ext))
@@ -60,12 +67,24 @@ config.quantum_tools_dir = os.path.join(config.quantum_obj_root, "bin")
 llvm_config.with_environment("PATH", config.llvm_tools_dir, append_path=True)
 llvm_config.with_environment("PATH", config.quantum_tools_dir, append_path=True)
 
+# Make the Python bindings of the build tree importable.
+if config.enable_bindings_python:
+    config.available_features.add("python-bindings")
+    llvm_config.with_environment(
+        "PYTHONPATH",
+        os.path.join(config.quantum_obj_root, "python_packages", "quantum-mlir"),
+        append_path=True,
+    )
+
 tool_dirs = [config.quantum_tools_dir, config.llvm_tools_dir]
 tools = [
+    "quantum-compile",
+    "quantum-launch",
     "quantum-opt",
     "mlir-runner",
     add_runtime("mlir_runner_utils"),
     add_runtime("mlir_c_runner_utils"),
+    add_runtime("QuantumRuntime", config.quantum_lib_dir, "quantum_runtime"),
 ]
 
 # Find QASM frontend
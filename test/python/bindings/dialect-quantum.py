@@ -0,0 +1,86 @@
+# RUN: %PYTHON %s | FileCheck %s
+
+from mlir.dialects import func, quantum
+from mlir.ir import Context, InsertionPoint, Location, Module
+
+
+def run(f):
+    print("\nTEST:", f.__name__)
+    with Context() as context, Location.unknown():
+        quantum.register_dialect(context)
+        f()
+    return f
+
+
+# Builds a kernel whose two Hadamard gates cancel each other.
+def build_kernel():
+    module = Module.create()
+    qubit = quantum.QubitType.get(1)
+    with InsertionPoint(module.body):
+
+        @func.FuncOp.from_py_func()
+        def kernel():
+            q0 = quantum.AllocOp(qubit).result
+            q1 = quantum.HOp(qubit, q0).result
+            q2 = quantum.HOp(qubit, q1).result
+            q3 = quantum.XOp(qubit, q2).result
+            quantum.DeallocateOp(q3)
+
+    return module
+
+
+# CHECK-LABEL: TEST: testQubitType
+@run
+def testQubitType():
+    qubit = quantum.QubitType.get(3)
+    # CHECK: !quantum.qubit<3>
+    print(qubit)
+    # CHECK: size: 3
+    print("size:", qubit.size)
+    # CHECK: default size: 1
+    print("default size:", quantum.QubitType.get().size)
+    try:
+        quantum.QubitType.get(0)
+    except ValueError as e:
+        # CHECK: ValueError: {{.*}}expected integer value greater equals 1
+        print("ValueError:", e)
+
+
+# CHECK-LABEL: TEST: testOpBuilders
+@run
+def testOpBuilders():
+    module = build_kernel()
+    assert module.operation.verify()
+    # CHECK: func.func @kernel() {
+    # CHECK-NEXT: %[[Q0:.+]] = "quantum.alloc"() : () -> !quantum.qubit<1>
+    # CHECK-NEXT: %[[Q1:.+]] = "quantum.H"(%[[Q0]]) : (!quantum.qubit<1>) -> !quantum.qubit<1>
+    # CHECK-NEXT: %[[Q2:.+]] = "quantum.H"(%[[Q1]]) : (!quantum.qubit<1>) -> !quantum.qubit<1>
+    # CHECK-NEXT: %[[Q3:.+]] = "quantum.X"(%[[Q2]]) : (!quantum.qubit<1>) -> !quantum.qubit<1>
+    # CHECK-NEXT: "quantum.deallocate"(%[[Q3]]) : (!quantum.qubit<1>) -> ()
+    # CHECK-NEXT: return
+    print(module)
+
+
+# CHECK-LABEL: TEST: testHermitianCancel
+@run
+def testHermitianCancel():
+    module = build_kernel()
+    quantum.hermitian_cancel(module)
+    # CHECK: %[[Q0:.+]] = "quantum.alloc"() : () -> !quantum.qubit<1>
+    # CHECK-NEXT: %[[Q1:.+]] = "quantum.X"(%[[Q0]]) : (!quantum.qubit<1>) -> !quantum.qubit<1>
+    # CHECK-NEXT: "quantum.deallocate"(%[[Q1]]) : (!quantum.qubit<1>) -> ()
+    print(module)
+
+
+# CHECK-LABEL: TEST: testConvertQuantumToQIR
+@run
+def testConvertQuantumToQIR():
+    module = build_kernel()
+    quantum.hermitian_cancel(module)
+    quantum.convert_quantum_to_qir(module)
+    # CHECK: %[[Q:.+]] = "qir.alloc"() : () -> !qir.qubit
+    # CHECK-NEXT: "qir.X"(%[[Q]]) : (!qir.qubit) -> ()
+    # CHECK-NEXT: "qir.reset"(%[[Q]]) : (!qir.qubit) -> ()
+    # CHECK-NEXT: return
+    # CHECK-NOT: quantum.
+    print(module)
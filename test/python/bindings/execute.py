@@ -0,0 +1,42 @@
+# RUN: %PYTHON %s | FileCheck %s
+
+from mlir.dialects import quantum
+from mlir.ir import Context, Module
+from mlir.quantum_pipeline import execute
+
+# Prepares a Bell pair and measures both of its qubits.
+BELL = """
+func.func @main() {
+  %q0 = "quantum.alloc"() : () -> !quantum.qubit<1>
+  %q1 = "quantum.alloc"() : () -> !quantum.qubit<1>
+  %q2 = "quantum.H"(%q0) : (!quantum.qubit<1>) -> !quantum.qubit<1>
+  %q3, %q4 = "quantum.CNOT"(%q2, %q1) : (!quantum.qubit<1>, !quantum.qubit<1>) -> (!quantum.qubit<1>, !quantum.qubit<1>)
+  %m0, %q5 = "quantum.measure_single"(%q3) : (!quantum.qubit<1>) -> (i1, !quantum.qubit<1>)
+  %m1, %q6 = "quantum.measure_single"(%q4) : (!quantum.qubit<1>) -> (i1, !quantum.qubit<1>)
+  "quantum.deallocate"(%q5) : (!quantum.qubit<1>) -> ()
+  "quantum.deallocate"(%q6) : (!quantum.qubit<1>) -> ()
+  return
+}
+"""
+
+
+# CHECK-LABEL: TEST: testExecuteBell
+def testExecuteBell():
+    print("TEST: testExecuteBell")
+    with Context() as context:
+        quantum.register_dialect(context)
+        module = Module.parse(BELL)
+        shots = execute(module, shots=200, threads=2)
+
+    # CHECK: shape: (200, 2)
+    print("shape:", shots.shape)
+    # CHECK: dtype: uint8
+    print("dtype:", shots.dtype)
+    # A Bell pair only ever yields correlated outcomes, and both of them occur.
+    # CHECK: correlated: True
+    print("correlated:", bool((shots[:, 0] == shots[:, 1]).all()))
+    # CHECK: outcomes: [0, 1]
+    print("outcomes:", sorted(set(shots[:, 0].tolist())))
+
+
+testExecuteBell()
@@ -0,0 +1,21 @@
+// RUN: %PYTHON qasm-import --pool-angles -i %s | FileCheck %s
+
+// CHECK: "func.func"() <{function_type = () -> (), sym_name = "qasm_main", sym_visibility = "private"}> ({
+// CHECK-NEXT: %[[B:.+]] = "arith.constant"() <{value = 5.000000e-01 : f64}> : () -> f64
+// CHECK-NEXT: %[[A:.+]] = "arith.constant"() <{value = 1.100000e+00 : f64}> : () -> f64
+// CHECK-NOT: "arith.constant"
+// CHECK-DAG: "qir.Rx"(%{{.+}}, %[[A]]) : (!qir.qubit, f64) -> ()
+// CHECK-DAG: "qir.Ry"(%{{.+}}, %[[A]]) : (!qir.qubit, f64) -> ()
+// CHECK-DAG: "qir.Rz"(%{{.+}}, %[[B]]) : (!qir.qubit, f64) -> ()
+// CHECK-DAG: "qir.Rx"(%{{.+}}, %[[B]]) : (!qir.qubit, f64) -> ()
+// CHECK: return
+
+OPENQASM 2.0;
+include "qelib1.inc";
+
+qreg q[2];
+
+rx(1.1) q[0];
+ry(1.1) q[1];
+rz(0.5) q[0];
+rx(0.5) q[1];
@@ -0,0 +1,23 @@
+// RUN: rm -rf %t.cache
+// RUN: quantum-compile %s --cache-dir=%t.cache --print-cache-status \
+// RUN:     -o %t.miss.mlir 2>&1 | FileCheck %s --check-prefix=MISS
+// RUN: quantum-compile %s --cache-dir=%t.cache --print-cache-status \
+// RUN:     -o %t.hit.mlir 2>&1 | FileCheck %s --check-prefix=HIT
+// RUN: diff %t.miss.mlir %t.hit.mlir
+// RUN: FileCheck %s --input-file=%t.hit.mlir
+
+// Objects are cached separately from the LLVM dialect module.
+// RUN: quantum-compile %s --cache-dir=%t.cache --print-cache-status \
+// RUN:     --emit=obj -o %t.o 2>&1 | FileCheck %s --check-prefix=MISS
+
+// MISS: cache miss
+// HIT: cache hit
+
+// CHECK-LABEL: llvm.func @entry(
+// CHECK: llvm.call @__quantum__qis__x__body
+func.func @entry() {
+  %q = "quantum.alloc"() : () -> (!quantum.qubit<1>)
+  %q1 = "quantum.X"(%q) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+  "quantum.deallocate"(%q1) : (!quantum.qubit<1>) -> ()
+  return
+}
@@ -0,0 +1,42 @@
+// RUN: quantum-opt %s -emit-bytecode -o %t.mlirbc
+// RUN: quantum-opt %t.mlirbc --materialize-functions=kernel \
+// RUN:   | FileCheck %s --implicit-check-not=unused
+// RUN: not quantum-opt %s --materialize-functions=kernel 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=TEXT
+// RUN: not quantum-opt %t.mlirbc --materialize-functions=missing 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=MISSING
+
+// CHECK-DAG: sym_name = "flip"
+// CHECK-DAG: func.func private @helper(
+// CHECK-DAG: func.func @kernel(
+// CHECK-DAG: "quantum.call"(%{{.*}}) <{callee = @flip}>
+// CHECK-DAG: call @helper(
+
+// TEXT: --materialize-functions requires a bytecode input
+// MISSING: unknown function 'missing'
+
+"quantum.gate"() <{function_type = (!quantum.qubit<1>) -> (!quantum.qubit<1>), sym_name = "flip"}> ({
+^bb0(%arg0: !quantum.qubit<1>):
+  %0 = "quantum.X"(%arg0) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+  "quantum.return"(%0) : (!quantum.qubit<1>) -> ()
+}) : () -> ()
+
+func.func private @helper(%q : !quantum.qubit<1>) -> (!quantum.qubit<1>) {
+  %0 = "quantum.H"(%q) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+  return %0 : !quantum.qubit<1>
+}
+
+func.func @kernel() {
+  %q = "quantum.alloc"() : () -> (!quantum.qubit<1>)
+  %0 = "quantum.call"(%q) <{callee = @flip}> : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+  %1 = func.call @helper(%0) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+  "quantum.deallocate"(%1) : (!quantum.qubit<1>) -> ()
+  return
+}
+
+func.func @unused() {
+  %q = "quantum.alloc"() : () -> (!quantum.qubit<1>)
+  %0 = func.call @helper(%q) : (!quantum.qubit<1>) -> (!quantum.qubit<1>)
+  "quantum.deallocate"(%0) : (!quantum.qubit<1>) -> ()
+  return
+}
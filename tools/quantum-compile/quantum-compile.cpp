@@ -0,0 +1,125 @@
+/// Main entry point for the quantum-mlir compiler driver.
+///
+/// Lowers a module through the full pipeline to the LLVM dialect or to an
+/// object file. With `--cache-dir`, the artifacts are kept in an on-disk cache
+/// keyed by the fingerprint of the module and the pipeline, so that compiling
+/// the same module again skips all conversions.
+///
+/// @file
+
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/DialectRegistry.h"
+#include "mlir/IR/MLIRContext.h"
+#include "mlir/InitAllDialects.h"
+#include "mlir/InitAllExtensions.h"
+#include "mlir/Parser/Parser.h"
+#include "mlir/Support/FileUtilities.h"
+#include "quantum-mlir/Dialect/QIR/IR/QIR.h"
+#include "quantum-mlir/Dialect/Quantum/IR/Quantum.h"
+#include "quantum-mlir/Pipeline/Compile.h"
+
+#include <cstdint>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/InitLLVM.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/ToolOutputFile.h>
+#include <llvm/Support/raw_ostream.h>
+#include <optional>
+#include <string>
+
+using namespace mlir;
+
+namespace {
+
+llvm::cl::opt<std::string> inputFilename(
+    llvm::cl::Positional,
+    llvm::cl::desc("<input file>"),
+    llvm::cl::init("-"));
+
+llvm::cl::opt<std::string> outputFilename(
+    "o",
+    llvm::cl::desc("Output filename"),
+    llvm::cl::value_desc("filename"),
+    llvm::cl::init("-"));
+
+llvm::cl::opt<std::string> passPipeline(
+    "pass-pipeline",
+    llvm::cl::desc("The lowering pipeline to the LLVM dialect"),
+    llvm::cl::init(quantum::kDefaultLoweringPipeline));
+
+llvm::cl::opt<quantum::ArtifactKind> emit(
+    "emit",
+    llvm::cl::desc("The kind of artifact to emit"),
+    llvm::cl::values(
+        clEnumValN(
+            quantum::ArtifactKind::LLVMDialect,
+            "llvm",
+            "The module in the LLVM dialect"),
+        clEnumValN(
+            quantum::ArtifactKind::Object,
+            "obj",
+            "An object file for the host")),
+    llvm::cl::init(quantum::ArtifactKind::LLVMDialect));
+
+llvm::cl::opt<std::string> cacheDir(
+    "cache-dir",
+    llvm::cl::desc("The directory of the artifact cache, disabled if empty"),
+    llvm::cl::init(""));
+
+llvm::cl::opt<std::uint64_t> cacheSize(
+    "cache-size",
+    llvm::cl::desc("The maximum size of the artifact cache in MiB"),
+    llvm::cl::init(1024));
+
+llvm::cl::opt<bool> printCacheStatus(
+    "print-cache-status",
+    llvm::cl::desc("Print whether the artifact was taken from the cache"),
+    llvm::cl::init(false));
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    llvm::InitLLVM init(argc, argv);
+    llvm::cl::ParseCommandLineOptions(argc, argv, "quantum-mlir compiler\n");
+
+    DialectRegistry registry;
+    registerAllDialects(registry);
+    registerAllExtensions(registry);
+    registry.insert<quantum::QuantumDialect>();
+    registry.insert<qir::QIRDialect>();
+    MLIRContext context(registry);
+
+    std::string error;
+    auto input = openInputFile(inputFilename, &error);
+    if (!input) {
+        llvm::errs() << error << "\n";
+        return 1;
+    }
+    llvm::SourceMgr sourceMgr;
+    sourceMgr.AddNewSourceBuffer(std::move(input), llvm::SMLoc());
+    SourceMgrDiagnosticHandler diagnostics(sourceMgr, &context);
+    OwningOpRef<ModuleOp> module =
+        parseSourceFile<ModuleOp>(sourceMgr, &context);
+    if (!module) return 1;
+
+    std::optional<quantum::ArtifactCache> cache;
+    if (!cacheDir.empty()) cache.emplace(cacheDir, cacheSize << 20);
+    auto artifact = quantum::compileModule(
+        *module,
+        passPipeline,
+        emit,
+        cache ? &*cache : nullptr);
+    if (failed(artifact)) return 1;
+    if (printCacheStatus)
+        llvm::errs() << (artifact->cached ? "cache hit" : "cache miss") << "\n";
+
+    auto output = openOutputFile(outputFilename, &error);
+    if (!output) {
+        llvm::errs() << error << "\n";
+        return 1;
+    }
+    output->os() << artifact->data;
+    output->keep();
+    return 0;
+}
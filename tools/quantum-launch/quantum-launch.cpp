@@ -0,0 +1,122 @@
+/// Main entry point for the quantum-mlir local process launcher.
+///
+/// Starts a program once per rank of a distributed simulation on this
+/// machine, similar to `mpirun`. The ranks communicate through a POSIX shared
+/// memory segment that lives as long as the launcher. Only rank 0 writes to
+/// stdout.
+///
+/// @file
+
+#include "quantum-mlir/Runtime/Communicator.h"
+
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace quantum::runtime;
+
+namespace {
+
+int usage(const char* self)
+{
+    std::fprintf(
+        stderr,
+        "usage: %s -n <ranks> [--] <program> [args...]\n"
+        "  <ranks> must be a power of two of at most %u.\n",
+        self,
+        kMaxRanks);
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    unsigned ranks = 0;
+    int first = 1;
+    while (first < argc && argv[first][0] == '-') {
+        const std::string arg = argv[first++];
+        if (arg == "--") break;
+        if (arg != "-n" || first == argc) return usage(argv[0]);
+        ranks = std::strtoul(argv[first++], nullptr, 10);
+    }
+    if (first == argc || ranks == 0 || ranks > kMaxRanks
+        || (ranks & (ranks - 1)))
+        return usage(argv[0]);
+
+    const std::string segment =
+        "/quantum-launch-" + std::to_string(static_cast<long>(getpid()));
+    const int fd = shm_open(segment.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0
+        || ftruncate(
+               fd,
+               static_cast<off_t>(
+                   SharedMemoryCommunicator::getSegmentSize(ranks)))
+               != 0) {
+        std::fprintf(
+            stderr,
+            "%s: cannot create segment '%s': %s\n",
+            argv[0],
+            segment.c_str(),
+            std::strerror(errno));
+        if (fd >= 0) shm_unlink(segment.c_str());
+        return 1;
+    }
+    close(fd);
+
+    // Flush before forking so that buffered output is not duplicated.
+    std::fflush(nullptr);
+    std::vector<pid_t> children;
+    for (unsigned rank = 0; rank < ranks; ++rank) {
+        const pid_t pid = fork();
+        if (pid < 0) {
+            std::perror("fork");
+            for (pid_t child : children) kill(child, SIGTERM);
+            break;
+        }
+        if (pid > 0) {
+            children.push_back(pid);
+            continue;
+        }
+
+        setenv(kSegmentEnvVar, segment.c_str(), 1);
+        setenv(kRankEnvVar, std::to_string(rank).c_str(), 1);
+        setenv(kRanksEnvVar, std::to_string(ranks).c_str(), 1);
+        if (rank != 0) {
+            const int null = open("/dev/null", O_WRONLY);
+            if (null >= 0) dup2(null, STDOUT_FILENO);
+        }
+        execvp(argv[first], argv + first);
+        std::fprintf(
+            stderr,
+            "%s: cannot execute '%s': %s\n",
+            argv[0],
+            argv[first],
+            std::strerror(errno));
+        _exit(127);
+    }
+
+    // A failed rank would leave the others waiting in a barrier forever, so
+    // the first failure terminates the whole group.
+    int result = children.size() == ranks ? 0 : 1;
+    for (std::size_t remaining = children.size(); remaining > 0; --remaining) {
+        int status = 0;
+        if (wait(&status) < 0) break;
+        const bool failed = !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+        if (failed && result == 0) {
+            result = WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+            for (pid_t child : children) kill(child, SIGTERM);
+        }
+    }
+
+    shm_unlink(segment.c_str());
+    return result;
+}
@@ -5,20 +5,128 @@
 /// @author      Clément Fournier (clement.fournier@tu-dresden.de)
 /// @author      Lars Schütze (lars.schuetze@tu-dresden.de)
 
+#include "mlir/Bytecode/BytecodeReader.h"
+#include "mlir/Bytecode/BytecodeWriter.h"
+#include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/Dialect.h"
 #include "mlir/IR/MLIRContext.h"
+#include "mlir/IR/SymbolTable.h"
 #include "mlir/InitAllDialects.h"
 #include "mlir/InitAllPasses.h"
+#include "mlir/Interfaces/FunctionInterfaces.h"
+#include "mlir/Support/FileUtilities.h"
 #include "mlir/Tools/mlir-opt/MlirOptMain.h"
 #include "quantum-mlir/Conversion/Passes.h"
 #include "quantum-mlir/Dialect/QIR/IR/QIR.h"
 #include "quantum-mlir/Dialect/QIR/Transforms/Passes.h"
 #include "quantum-mlir/Dialect/Quantum/IR/Quantum.h"
 
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/InitLLVM.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/ToolOutputFile.h>
+#include <llvm/Support/raw_ostream.h>
+#include <string>
+
 using namespace mlir;
 
+namespace {
+
+llvm::cl::list<std::string> materializeFunctions(
+    "materialize-functions",
+    llvm::cl::desc(
+        "Load a bytecode input lazily and keep only these functions and the "
+        "symbols they reference"),
+    llvm::cl::CommaSeparated);
+
+/// Loads the bytecode in @p input lazily and returns it as bytecode with only
+/// the functions in materializeFunctions and the symbols they reference.
+///
+/// Function bodies are only read if they are materialized, so large modules
+/// can be cut down to a few kernels without parsing the rest.
+std::unique_ptr<llvm::MemoryBuffer> extractFunctions(
+    const llvm::MemoryBuffer &input,
+    DialectRegistry &registry,
+    const MlirOptMainConfig &config)
+{
+    if (!isBytecode(input.getMemBufferRef())) {
+        llvm::errs() << "--materialize-functions requires a bytecode input\n";
+        return nullptr;
+    }
+
+    MLIRContext context(registry);
+    context.allowUnregisteredDialects(
+        config.shouldAllowUnregisteredDialects());
+    ParserConfig parserConfig(&context);
+    BytecodeReader reader(
+        input.getMemBufferRef(),
+        parserConfig,
+        /*lazyLoad=*/true);
+
+    // Only functions and gates are loaded lazily. The isolated regions nested
+    // in them, e.g. of quantum.if, are loaded together with their function.
+    Block block;
+    if (failed(reader.readTopLevel(&block, [](Operation* op) {
+            return isa<FunctionOpInterface>(op);
+        })))
+        return nullptr;
+    auto module = dyn_cast<ModuleOp>(&block.front());
+    if (!module || block.getOperations().size() != 1) {
+        llvm::errs() << "expected a single top-level module\n";
+        return nullptr;
+    }
+
+    // Eagerly loaded ops are kept, so their references must be kept as well.
+    SymbolTable symbolTable(module);
+    SmallVector<Operation*> worklist;
+    for (Operation &op : module.getOps())
+        if (!reader.isMaterializable(&op)) worklist.push_back(&op);
+    for (const std::string &name : materializeFunctions) {
+        Operation* op = symbolTable.lookup(name);
+        if (!op) {
+            llvm::errs() << "unknown function '" << name << "'\n";
+            return nullptr;
+        }
+        worklist.push_back(op);
+    }
+
+    llvm::DenseSet<Operation*> visited;
+    while (!worklist.empty()) {
+        Operation* op = worklist.pop_back_val();
+        if (!visited.insert(op).second) continue;
+        if (reader.isMaterializable(op)
+            && failed(reader.materialize(op, [](Operation*) {
+                   return false;
+               })))
+            return nullptr;
+        const auto uses = SymbolTable::getSymbolUses(op);
+        if (!uses) continue;
+        for (const SymbolTable::SymbolUse &use : *uses)
+            if (Operation* symbol = symbolTable.lookup(
+                    use.getSymbolRef().getRootReference()))
+                worklist.push_back(symbol);
+    }
+
+    // Drop everything that was not materialized without reading it.
+    if (failed(reader.finalize([](Operation*) { return false; })))
+        return nullptr;
+
+    std::string bytecode;
+    llvm::raw_string_ostream os(bytecode);
+    if (failed(writeBytecodeToFile(module, os))) return nullptr;
+    return llvm::MemoryBuffer::getMemBufferCopy(
+        bytecode,
+        input.getBufferIdentifier());
+}
+
+} // namespace
+
 int main(int argc, char* argv[])
 {
+    llvm::InitLLVM init(argc, argv);
+
     DialectRegistry registry;
     registerAllDialects(registry);
 
@@ -30,6 +138,39 @@ int main(int argc, char* argv[])
     quantum::registerConversionPasses();
     qir::registerQIRPasses();
 
-    return asMainReturnCode(
-        MlirOptMain(argc, argv, "quantum-mlir optimizer driver\n", registry));
+    auto [inputFilename, outputFilename] = registerAndParseCLIOptions(
+        argc,
+        argv,
+        "quantum-mlir optimizer driver\n",
+        registry);
+    if (materializeFunctions.empty())
+        return asMainReturnCode(MlirOptMain(
+            argc,
+            argv,
+            inputFilename,
+            outputFilename,
+            registry));
+
+    const MlirOptMainConfig config = MlirOptMainConfig::createFromCLOptions();
+    std::string error;
+    auto input = openInputFile(inputFilename, &error);
+    if (!input) {
+        llvm::errs() << error << "\n";
+        return 1;
+    }
+    auto extracted = extractFunctions(*input, registry, config);
+    if (!extracted) return 1;
+    auto output = openOutputFile(outputFilename, &error);
+    if (!output) {
+        llvm::errs() << error << "\n";
+        return 1;
+    }
+    if (failed(MlirOptMain(
+            output->os(),
+            std::move(extracted),
+            registry,
+            config)))
+        return 1;
+    output->keep();
+    return 0;
 }
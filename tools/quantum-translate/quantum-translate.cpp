@@ -8,6 +8,7 @@
 #include "mlir/Support/LogicalResult.h"
 #include "mlir/Tools/mlir-translate/MlirTranslateMain.h"
 #include "quantum-mlir/Target/qasm/TargetQASM.h"
+#include "quantum-mlir/Target/qir/TargetQIR.h"
 
 using namespace mlir;
 
@@ -15,6 +16,7 @@ int main(int argc, char** argv)
 {
     registerAllTranslations();
     qir::registerQIRToOpenQASMTranslation();
+    qir::registerQIRProfileTranslations();
     return failed(
         mlirTranslateMain(argc, argv, "MLIR Translation Testing Tool"));
 }
@@ -0,0 +1,130 @@
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/MLIRContext.h"
+#include "mlir/Parser/Parser.h"
+#include "quantum-mlir/Pipeline/ArtifactCache.h"
+
+#include <chrono>
+#include <doctest/doctest.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+#include <string>
+
+using namespace mlir;
+using namespace mlir::quantum;
+
+// clang-format off
+
+namespace {
+
+/// A temporary cache directory that is removed with its contents.
+struct TemporaryDirectory {
+    llvm::SmallString<128> path;
+
+    TemporaryDirectory() {
+        (void)llvm::sys::fs::createUniqueDirectory("artifact-cache", path);
+    }
+    ~TemporaryDirectory() { (void)llvm::sys::fs::remove_directories(path); }
+};
+
+/// Sets the modification time of the artifact under @p key to @p age seconds
+/// ago, which orders the artifacts for the eviction.
+void setAge(const ArtifactCache &cache, StringRef key, int age) {
+    int fd;
+    REQUIRE_FALSE(llvm::sys::fs::openFileForWrite(
+        cache.getPath(key), fd, llvm::sys::fs::CD_OpenExisting));
+    (void)llvm::sys::fs::setLastAccessAndModificationTime(
+        fd, std::chrono::system_clock::now() - std::chrono::seconds(age));
+    llvm::sys::fs::closeFile(fd);
+}
+
+} // namespace
+
+TEST_CASE("ArtifactCache keys depend on the module, pipeline and kind") {
+    MLIRContext context;
+    auto lhs = parseSourceString<ModuleOp>("module {}", &context);
+    auto rhs = parseSourceString<ModuleOp>(
+        "module attributes {test.attr} {}", &context);
+    const std::string key =
+        ArtifactCache::getKey(*lhs, "builtin.module()", ArtifactKind::Object);
+
+    CHECK(key.size() == 64);
+    CHECK(key == ArtifactCache::getKey(
+        *lhs, "builtin.module()", ArtifactKind::Object));
+    CHECK(key != ArtifactCache::getKey(
+        *rhs, "builtin.module()", ArtifactKind::Object));
+    CHECK(key != ArtifactCache::getKey(
+        *lhs, "builtin.module(cse)", ArtifactKind::Object));
+    CHECK(key != ArtifactCache::getKey(
+        *lhs, "builtin.module()", ArtifactKind::LLVMDialect));
+}
+
+TEST_CASE("ArtifactCache keys depend on the files the pipeline reads") {
+    TemporaryDirectory dir;
+    llvm::SmallString<128> path(dir.path);
+    llvm::sys::path::append(path, "noise.json");
+    const auto write = [&](StringRef contents) {
+        std::error_code ec;
+        llvm::raw_fd_ostream os(path, ec);
+        REQUIRE_FALSE(ec);
+        os << contents;
+    };
+    MLIRContext context;
+    auto module = parseSourceString<ModuleOp>("module {}", &context);
+    const std::string pipeline =
+        ("builtin.module(qir-inject-noise{noise-model=" + path + "})").str();
+
+    write("{\"depolarizing\": 0.01}");
+    const std::string key =
+        ArtifactCache::getKey(*module, pipeline, ArtifactKind::Object);
+    CHECK(key == ArtifactCache::getKey(
+        *module, pipeline, ArtifactKind::Object));
+
+    write("{\"depolarizing\": 0.02}");
+    CHECK(key != ArtifactCache::getKey(
+        *module, pipeline, ArtifactKind::Object));
+}
+
+TEST_CASE("ArtifactCache stores and looks up artifacts") {
+    TemporaryDirectory dir;
+    ArtifactCache cache(dir.path, 1024);
+
+    CHECK(cache.lookup("a") == nullptr);
+    CHECK(succeeded(cache.store("a", "first")));
+    auto buffer = cache.lookup("a");
+    REQUIRE(buffer != nullptr);
+    CHECK(buffer->getBuffer() == "first");
+
+    CHECK(succeeded(cache.store("a", "second")));
+    CHECK(cache.lookup("a")->getBuffer() == "second");
+}
+
+TEST_CASE("ArtifactCache evicts the least recently used artifacts") {
+    TemporaryDirectory dir;
+    ArtifactCache cache(dir.path, 25);
+
+    REQUIRE(succeeded(cache.store("a", std::string(10, 'a'))));
+    REQUIRE(succeeded(cache.store("b", std::string(10, 'b'))));
+    setAge(cache, "a", 20);
+    setAge(cache, "b", 10);
+
+    SUBCASE("the oldest artifact goes first") {
+        REQUIRE(succeeded(cache.store("c", std::string(10, 'c'))));
+        CHECK(cache.lookup("a") == nullptr);
+        CHECK(cache.lookup("b") != nullptr);
+        CHECK(cache.lookup("c") != nullptr);
+    }
+
+    SUBCASE("a lookup makes an artifact recent") {
+        REQUIRE(cache.lookup("a") != nullptr);
+        REQUIRE(succeeded(cache.store("c", std::string(10, 'c'))));
+        CHECK(cache.lookup("a") != nullptr);
+        CHECK(cache.lookup("b") == nullptr);
+    }
+
+    SUBCASE("artifacts beyond the cap are not stored") {
+        CHECK(failed(cache.store("c", std::string(30, 'c'))));
+        CHECK(cache.lookup("c") == nullptr);
+    }
+}
@@ -0,0 +1,88 @@
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/MLIRContext.h"
+#include "mlir/IR/Verifier.h"
+#include "quantum-mlir/Dialect/Quantum/IR/CircuitBuilder.h"
+#include "quantum-mlir/Dialect/Quantum/IR/Quantum.h"
+
+#include <doctest/doctest.h>
+#include <llvm/ADT/STLExtras.h>
+
+using namespace mlir;
+using namespace mlir::quantum;
+
+namespace {
+
+/// Returns an empty function in @p module to build circuits into.
+func::FuncOp createKernel(OpBuilder &builder, ModuleOp module)
+{
+    builder.setInsertionPointToEnd(module.getBody());
+    auto func = builder.create<func::FuncOp>(
+        builder.getUnknownLoc(),
+        "kernel",
+        builder.getFunctionType({}, {}));
+    builder.setInsertionPointToEnd(func.addEntryBlock());
+    return func;
+}
+
+} // namespace
+
+// clang-format off
+
+TEST_CASE("CircuitBuilder tracks qubits and shares angles") {
+    MLIRContext context;
+    context.loadDialect<QuantumDialect, func::FuncDialect>();
+    OpBuilder builder(&context);
+    OwningOpRef<ModuleOp> module = ModuleOp::create(builder.getUnknownLoc());
+    func::FuncOp func = createKernel(builder, *module);
+
+    CircuitBuilder circuit(builder, builder.getUnknownLoc());
+    REQUIRE(circuit.allocQubits(3) == 0);
+    circuit.h(0).cnot(0, 1).cnot(1, 2).rz(2, 0.5).rx(0, 0.5).u3(1, 0.5, 1.0, -0.0);
+    circuit.barrier();
+    const Value bit = circuit.measure(2);
+    circuit.deallocate(0);
+    builder.create<func::ReturnOp>(builder.getUnknownLoc());
+
+    REQUIRE(succeeded(verify(*module)));
+    CHECK(bit.getType().isInteger(1));
+    CHECK(isa<MeasureSingleOp>(circuit.getQubit(2).getDefiningOp()));
+    CHECK(isa<BarrierOp>(circuit.getQubit(1).getDefiningOp()));
+    CHECK(!circuit.getQubit(0));
+
+    // 0.5, 1.0 and -0.0 are built once each, ahead of the first allocation.
+    auto constants = llvm::to_vector(func.getOps<arith::ConstantOp>());
+    CHECK(constants.size() == 3);
+    Block &body = func.getBody().front();
+    for (auto constant : constants)
+        CHECK(constant->isBeforeInBlock(&*std::next(body.begin(), 3)));
+    CHECK(isa<AllocOp>(*std::next(body.begin(), 3)));
+}
+
+TEST_CASE("CircuitBuilder builds large circuits") {
+    MLIRContext context;
+    context.loadDialect<QuantumDialect, func::FuncDialect>();
+    OpBuilder builder(&context);
+    OwningOpRef<ModuleOp> module = ModuleOp::create(builder.getUnknownLoc());
+    func::FuncOp func = createKernel(builder, *module);
+
+    constexpr unsigned numQubits = 64;
+    constexpr unsigned numLayers = 2000;
+    CircuitBuilder circuit(builder, builder.getUnknownLoc());
+    circuit.reserve(numQubits, numLayers);
+    circuit.allocQubits(numQubits);
+    for (unsigned layer = 0; layer < numLayers; ++layer) {
+        for (unsigned q = 0; q < numQubits; ++q)
+            circuit.rz(q, 0.001 * layer);
+        for (unsigned q = layer % 2; q + 1 < numQubits; q += 2)
+            circuit.cnot(q, q + 1);
+    }
+    builder.create<func::ReturnOp>(builder.getUnknownLoc());
+
+    REQUIRE(succeeded(verify(*module)));
+    CHECK(llvm::range_size(func.getOps<arith::ConstantOp>()) == numLayers);
+    CHECK(llvm::range_size(func.getOps<RzOp>()) == numQubits * numLayers);
+    for (Value qubit : circuit.getQubits()) CHECK(qubit.use_empty());
+}
@@ -0,0 +1,480 @@
+/// Tests for the simulator runtime.
+///
+/// @file
+
+#include "quantum-mlir/Runtime/Distributed.h"
+#include "quantum-mlir/Runtime/Noise.h"
+#include "quantum-mlir/Runtime/OutOfCore.h"
+#include "quantum-mlir/Runtime/Profile.h"
+#include "quantum-mlir/Runtime/QIR.h"
+#include "quantum-mlir/Runtime/Random.h"
+#include "quantum-mlir/Runtime/Runtime.h"
+#include "quantum-mlir/Runtime/Simulator.h"
+#include "quantum-mlir/Runtime/Trajectories.h"
+
+#include <atomic>
+#include <barrier>
+#include <doctest/doctest.h>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace quantum::runtime;
+
+namespace {
+
+QirQubit* qubitAt(std::uintptr_t id)
+{
+    return reinterpret_cast<QirQubit*>(id);
+}
+
+QirResult* resultAt(std::uintptr_t id)
+{
+    return reinterpret_cast<QirResult*>(id);
+}
+
+/// Prepares and measures a Bell pair under amplitude damping.
+void noisyBell()
+{
+    __quantum__rt__initialize(nullptr);
+    set_rng_seed(23);
+    __quantum__qis__h__body(qubitAt(0));
+    __quantum__qis__cnot__body(qubitAt(0), qubitAt(1));
+    __quantum__qis__amplitude_damping__body(0.2, qubitAt(1));
+    __quantum__qis__mz__body(qubitAt(0), resultAt(0));
+    __quantum__qis__mz__body(qubitAt(1), resultAt(1));
+}
+
+/// Applies a reproducible random circuit on @p numQubits qubits to @p sim .
+void applyRandomCircuit(Simulator &sim, std::size_t numQubits, int numGates)
+{
+    RandomStream random(7, 0);
+    const auto pick = [&] {
+        return static_cast<QubitIndex>(random.sample() * numQubits);
+    };
+    for (int i = 0; i < numGates; ++i) {
+        const QubitIndex a = pick();
+        QubitIndex b = pick();
+        while (b == a) b = pick();
+        QubitIndex c = pick();
+        while (c == a || c == b) c = pick();
+        const double theta = random.sample() * 6.28;
+        switch (static_cast<int>(random.sample() * 7)) {
+        case 0: sim.applyMatrix(gates::h(), a); break;
+        case 1: sim.applyMatrix(gates::ry(theta), a); break;
+        case 2: sim.applyDiagonal(1.0, std::polar(1.0, theta), a); break;
+        case 3: sim.applyControlled(gates::x(), a, b); break;
+        case 4: sim.applyControlled(gates::z(), a, b); break;
+        case 5: sim.applyDoublyControlled(gates::rx(theta), a, b, c); break;
+        default: sim.swap(a, b); break;
+        }
+    }
+}
+
+/// Ranks of one process that communicate through shared buffers.
+struct LoopbackGroup {
+    explicit LoopbackGroup(unsigned size)
+            : sync(size),
+              mailboxes(size),
+              partials(size)
+    {}
+
+    std::barrier<> sync;
+    std::vector<std::vector<Amplitude>> mailboxes;
+    std::vector<double> partials;
+};
+
+class LoopbackCommunicator : public Communicator {
+public:
+    LoopbackCommunicator(LoopbackGroup &group, unsigned rank)
+            : group(group),
+              rank(rank)
+    {}
+
+    unsigned getRank() const override { return rank; }
+    unsigned getSize() const override { return group.partials.size(); }
+
+    void barrier() override { group.sync.arrive_and_wait(); }
+    void exchange(
+        unsigned partner,
+        const Amplitude* send,
+        Amplitude* recv,
+        std::size_t count) override
+    {
+        group.mailboxes[rank].assign(send, send + count);
+        barrier();
+        std::copy_n(group.mailboxes[partner].begin(), count, recv);
+        barrier();
+    }
+    double allReduceSum(double value) override
+    {
+        group.partials[rank] = value;
+        barrier();
+        double sum = 0.0;
+        for (double partial : group.partials) sum += partial;
+        barrier();
+        return sum;
+    }
+
+private:
+    LoopbackGroup &group;
+    unsigned rank;
+};
+
+/// Runs @p body on @p size ranks in parallel.
+template<typename Body>
+void runRanks(unsigned size, Body body)
+{
+    LoopbackGroup group(size);
+    std::vector<std::thread> threads;
+    for (unsigned rank = 0; rank < size; ++rank)
+        threads.emplace_back([&, rank] {
+            LoopbackCommunicator comm(group, rank);
+            body(comm);
+        });
+    for (std::thread &thread : threads) thread.join();
+}
+
+} // namespace
+
+// clang-format off
+
+TEST_CASE("DensityMatrixSimulator applies noise channels exactly") {
+    DensityMatrixSimulator sim;
+    sim.addQubits(1);
+    sim.applyMatrix(gates::x(), 0);
+
+    SUBCASE("amplitude damping") {
+        sim.applyChannel(amplitudeDamping(0.3), 0, 0.0);
+        CHECK(sim.probabilityOfOne(0) == doctest::Approx(0.7));
+    }
+
+    SUBCASE("full depolarizing") {
+        sim.applyChannel(depolarizing(0.75), 0, 0.0);
+        CHECK(sim.probabilityOfOne(0) == doctest::Approx(0.5));
+    }
+
+    SUBCASE("reset") {
+        sim.reset(0, 0.0);
+        CHECK(sim.probabilityOfOne(0) == doctest::Approx(0.0));
+    }
+}
+
+TEST_CASE("sampleIndex only selects positive weights") {
+    CHECK(sampleIndex({0.5, 0.0, 0.5}, 0.25) == 0);
+    CHECK(sampleIndex({0.5, 0.0, 0.5}, 0.5) == 2);
+    CHECK(sampleIndex({0.5, 0.5, 0.0}, 1.0) == 1);
+}
+
+TEST_CASE("StateVectorSimulator never selects an operator of zero weight") {
+    StateVectorSimulator sim;
+    sim.addQubits(1);
+
+    // The decay operator annihilates |0>, and a sample beyond the sum of the
+    // weights must not select it.
+    sim.applyChannel(amplitudeDamping(0.3), 0, 1.0);
+    CHECK(sim.probabilityOfOne(0) == doctest::Approx(0.0));
+    sim.applyMatrix(gates::x(), 0);
+    CHECK(sim.probabilityOfOne(0) == doctest::Approx(1.0));
+}
+
+TEST_CASE("DensityMatrixSimulator dephases coherences") {
+    DensityMatrixSimulator sim;
+    sim.addQubits(1);
+    sim.applyMatrix(gates::h(), 0);
+    CHECK(sim.getElement(0, 1).real() == doctest::Approx(0.5));
+
+    sim.applyChannel(amplitudeDamping(0.36), 0, 0.0);
+    CHECK(sim.getElement(0, 1).real() == doctest::Approx(0.4));
+    CHECK(sim.probabilityOfOne(0) == doctest::Approx(0.32));
+}
+
+TEST_CASE("Backends agree on a Bell state") {
+    for (Backend backend : {Backend::StateVector, Backend::DensityMatrix}) {
+        auto sim = createSimulator(backend);
+        sim->addQubits(2);
+        sim->applyMatrix(gates::h(), 0);
+        sim->applyControlled(gates::x(), 0, 1);
+        CHECK(sim->probabilityOfOne(0) == doctest::Approx(0.5));
+
+        const bool outcome = sim->measure(0, 0.75);
+        CHECK(sim->probabilityOfOne(1) == doctest::Approx(outcome ? 1.0 : 0.0));
+    }
+}
+
+TEST_CASE("RuntimeConfig parses option strings") {
+    RuntimeConfig config;
+    config.parse("backend=density-matrix;trajectories=64;threads=4");
+    CHECK(config.backend == Backend::DensityMatrix);
+    CHECK(config.trajectories == 64);
+    CHECK(config.threads == 4);
+
+    config.parse("trajectories=0;backend=unknown");
+    CHECK(config.backend == Backend::DensityMatrix);
+    CHECK(config.trajectories == 64);
+
+    config.parse("profile-format=chrome;profile-format=xml");
+    CHECK(config.profileFormat == ProfileFormat::ChromeTrace);
+}
+
+TEST_CASE("Philox4x32 matches the Random123 known answers") {
+    using Counter = Philox4x32::Counter;
+    using Key = Philox4x32::Key;
+
+    const Counter zero = Philox4x32::generate(Counter{}, Key{});
+    const Counter zeroExpected = {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8};
+    CHECK(zero == zeroExpected);
+
+    const Counter ones = Philox4x32::generate(
+        {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+        {0xffffffff, 0xffffffff});
+    const Counter onesExpected = {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd};
+    CHECK(ones == onesExpected);
+
+    const Counter pi = Philox4x32::generate(
+        {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+        {0xa4093822, 0x299f31d0});
+    const Counter piExpected = {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1};
+    CHECK(pi == piExpected);
+}
+
+TEST_CASE("RandomStream does not depend on the consumption order") {
+    RandomStream a(23, 0);
+    RandomStream b(23, 1);
+    std::vector<double> interleaved;
+    for (int i = 0; i < 5; ++i) {
+        interleaved.push_back(a.sample());
+        interleaved.push_back(b.sample());
+    }
+
+    RandomStream c(23, 1);
+    for (int i = 0; i < 5; ++i) CHECK(c.sample() == interleaved[2 * i + 1]);
+    c.reset(23, 0);
+    for (int i = 0; i < 5; ++i) CHECK(c.sample() == interleaved[2 * i]);
+}
+
+TEST_CASE("RuntimeState streams are reproducible") {
+    RuntimeState &state = getRuntimeState();
+    state.seed(23);
+    state.setStream(5);
+    const double first = state.sample();
+    state.setStream(6);
+    const double other = state.sample();
+    state.setStream(5);
+    CHECK(state.sample() == first);
+    CHECK(other != first);
+}
+
+TEST_CASE("ThreadPool runs every task exactly once") {
+    ThreadPool pool(4);
+    CHECK(pool.getNumThreads() == 4);
+
+    for (std::size_t count : {0, 1, 3, 1000}) {
+        std::vector<std::atomic<int>> hits(count);
+        pool.parallelFor(count, [&](std::size_t index, unsigned rank) {
+            CHECK(rank < 4);
+            ++hits[index];
+        });
+        for (const auto &hit : hits) CHECK(hit == 1);
+    }
+}
+
+TEST_CASE("runTrajectories does not depend on the number of threads") {
+    const Histogram serial = runTrajectories(noisyBell, 500, 1);
+    const Histogram parallel = runTrajectories(noisyBell, 500, 4);
+    CHECK(serial == parallel);
+
+    std::uint64_t total = 0;
+    for (const auto &[bits, hits] : parallel) total += hits;
+    CHECK(total == 500);
+    // Damping the second qubit only ever turns |11> into |10>.
+    CHECK(parallel.count("01") == 0);
+    CHECK(parallel.count("10") == 1);
+}
+
+TEST_CASE("runShots returns the results of every shot in place") {
+    constexpr std::size_t shots = 500;
+    const auto rows = runShots(noisyBell, shots, 3, 4);
+    const Histogram histogram = runTrajectories(noisyBell, shots, 1);
+
+    Histogram fromRows;
+    for (std::size_t shot = 0; shot < shots; ++shot) {
+        const std::uint8_t* row = rows.get() + shot * 3;
+        CHECK(row[0] <= 1);
+        CHECK(row[1] <= 1);
+        // Registers that were never written read as zero.
+        CHECK(row[2] == 0);
+        ++fromRows[std::string{char('0' + row[0]), char('0' + row[1])}];
+    }
+    CHECK(fromRows == histogram);
+}
+
+TEST_CASE("OutOfCoreSimulator matches the in-memory simulator") {
+    constexpr std::size_t numQubits = 7;
+    StateVectorSimulator reference;
+    reference.addQubits(numQubits);
+    applyRandomCircuit(reference, numQubits, 300);
+
+    StorageOptions mapped;
+    mapped.kind = StorageKind::MappedFile;
+    mapped.chunkQubits = 3;
+    StorageOptions chunked;
+    chunked.chunkQubits = 2;
+
+    for (const StorageOptions &options : {mapped, chunked}) {
+        OutOfCoreSimulator sim(options);
+        sim.addQubits(numQubits);
+        applyRandomCircuit(sim, numQubits, 300);
+
+        // Runs of local gates share a single pass over the state.
+        sim.flush();
+        CHECK(sim.getNumPasses() < 300);
+
+        for (QubitIndex q = 0; q < numQubits; ++q)
+            CHECK(sim.probabilityOfOne(q) == doctest::Approx(reference.probabilityOfOne(q)));
+
+        const StateVector &state = sim.getState();
+        for (std::size_t i = 0; i < state.size(); ++i) {
+            CHECK(state[i].real() == doctest::Approx(reference.getState()[i].real()));
+            CHECK(state[i].imag() == doctest::Approx(reference.getState()[i].imag()));
+        }
+    }
+}
+
+TEST_CASE("OutOfCoreSimulator measures in logical order") {
+    StorageOptions options;
+    options.kind = StorageKind::MappedFile;
+    options.chunkQubits = 1;
+    OutOfCoreSimulator sim(options);
+    sim.addQubits(3);
+    sim.applyMatrix(gates::x(), 2);
+    sim.swap(0, 2);
+    sim.applyControlled(gates::x(), 0, 1);
+    CHECK(sim.measure(0, 0.5));
+    CHECK(sim.measure(1, 0.5));
+    CHECK_FALSE(sim.measure(2, 0.5));
+}
+
+TEST_CASE("DistributedSimulator matches the single-process simulator") {
+    constexpr std::size_t numQubits = 6;
+    StateVectorSimulator reference;
+    reference.addQubits(numQubits);
+    applyRandomCircuit(reference, numQubits, 300);
+
+    std::vector<double> probabilities(numQubits);
+    std::size_t exchanges = 0;
+    runRanks(4, [&](Communicator &comm) {
+        DistributedSimulator sim(comm);
+        sim.addQubits(numQubits);
+        applyRandomCircuit(sim, numQubits, 300);
+        for (QubitIndex q = 0; q < numQubits; ++q) {
+            const double p = sim.probabilityOfOne(q);
+            if (comm.getRank() == 0) probabilities[q] = p;
+        }
+        if (comm.getRank() == 0) exchanges = sim.getNumExchanges();
+    });
+
+    CHECK(exchanges > 0);
+    for (QubitIndex q = 0; q < numQubits; ++q)
+        CHECK(probabilities[q] == doctest::Approx(reference.probabilityOfOne(q)));
+}
+
+TEST_CASE("DistributedSimulator agrees on measurements and channels") {
+    constexpr std::size_t numQubits = 4;
+    const KrausChannel channel = amplitudeDamping(0.3);
+    StateVectorSimulator reference;
+    reference.addQubits(numQubits);
+    applyRandomCircuit(reference, numQubits, 50);
+    std::vector<bool> expected;
+    for (QubitIndex q = 0; q < numQubits; ++q) {
+        reference.applyChannel(channel, q, 0.25 * q);
+        expected.push_back(reference.measure(q, 0.5));
+    }
+
+    std::vector<std::vector<bool>> outcomes(2);
+    runRanks(2, [&](Communicator &comm) {
+        DistributedSimulator sim(comm);
+        sim.addQubits(numQubits);
+        applyRandomCircuit(sim, numQubits, 50);
+        for (QubitIndex q = 0; q < numQubits; ++q) {
+            sim.applyChannel(channel, q, 0.25 * q);
+            outcomes[comm.getRank()].push_back(sim.measure(q, 0.5));
+        }
+    });
+
+    CHECK(outcomes[0] == expected);
+    CHECK(outcomes[1] == expected);
+}
+
+TEST_CASE("Profiler counts operations and writes profiles") {
+    Profiler &profiler = Profiler::get();
+    profiler.reset();
+    __quantum__rt__initialize(nullptr);
+    getRuntimeState().getQubit(2);
+
+    for (int i = 0; i < 3; ++i) {
+        const ProfileScope<true> scope(OpKind::CNOT);
+        CHECK(getCurrentOp() == OpKind::CNOT);
+    }
+    CHECK(getCurrentOp() == OpKind::Other);
+    profiler.recordFusion(OpKind::H);
+
+    const ProfileCounters totals = profiler.getTotals();
+    const OpCounters &cnot = totals[static_cast<std::size_t>(OpKind::CNOT)];
+    CHECK(cnot.calls == 3);
+    // A controlled gate touches half of the 8 amplitudes.
+    CHECK(cnot.bytes == 3 * 4 * 2 * sizeof(Amplitude));
+    CHECK(totals[static_cast<std::size_t>(OpKind::H)].calls == 0);
+    CHECK(totals[static_cast<std::size_t>(OpKind::H)].fusions == 1);
+
+    const auto read = [](const std::filesystem::path &path) {
+        std::ifstream in(path);
+        return std::string(
+            std::istreambuf_iterator<char>(in),
+            std::istreambuf_iterator<char>());
+    };
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "quantum-runtime-profile";
+
+    CHECK(profiler.write(path, ProfileFormat::Summary));
+    const std::string summary = read(path);
+    CHECK(summary.find("\"cnot\": {\"calls\": 3") != std::string::npos);
+    CHECK(summary.find("\"ccx\"") == std::string::npos);
+
+    CHECK(profiler.write(path, ProfileFormat::ChromeTrace));
+    const std::string trace = read(path);
+    CHECK(trace.find("\"traceEvents\"") != std::string::npos);
+    CHECK(trace.find("\"name\": \"cnot\", \"cat\": \"qis\", \"ph\": \"X\"")
+          != std::string::npos);
+    std::filesystem::remove(path);
+
+    profiler.reset();
+    CHECK(profiler.getTotals()[static_cast<std::size_t>(OpKind::CNOT)].calls
+          == 0);
+}
+
+TEST_CASE("Profiler attributes operations to source sites") {
+    Profiler &profiler = Profiler::get();
+    profiler.reset();
+
+    // Sites are merged by name, whatever the address of the string.
+    const std::string copy = "kernel.mlir:4:3";
+    setCurrentSite("kernel.mlir:4:3");
+    { const ProfileScope<true> scope(OpKind::H); }
+    setCurrentSite(copy.c_str());
+    { const ProfileScope<true> scope(OpKind::X); }
+    setCurrentSite("kernel.mlir:5:3");
+    { const ProfileScope<true> scope(OpKind::H); }
+    setCurrentSite(nullptr);
+    { const ProfileScope<true> scope(OpKind::H); }
+
+    const auto sites = profiler.getSiteTotals();
+    CHECK(sites.size() == 2);
+    for (const auto &[site, counters] : sites)
+        CHECK(counters.calls == (site == "kernel.mlir:4:3" ? 2 : 1));
+    CHECK(profiler.getTotals()[static_cast<std::size_t>(OpKind::H)].calls == 3);
+    profiler.reset();
+}